@@ -490,12 +490,13 @@ lean_object* allegro_al_get_allegro_audio_version(void) {
     return io_ok_uint32(al_get_allegro_audio_version());
 }
 
-lean_object* allegro_al_get_channel_count(uint32_t conf) {
-    return io_ok_uint32((uint32_t)al_get_channel_count((ALLEGRO_CHANNEL_CONF)conf));
+/* Pure: bound without IO on the Lean side. */
+uint32_t allegro_al_get_channel_count(uint32_t conf) {
+    return (uint32_t)al_get_channel_count((ALLEGRO_CHANNEL_CONF)conf);
 }
 
-lean_object* allegro_al_get_audio_depth_size(uint32_t depth) {
-    return io_ok_uint32((uint32_t)al_get_audio_depth_size((ALLEGRO_AUDIO_DEPTH)depth));
+uint32_t allegro_al_get_audio_depth_size(uint32_t depth) {
+    return (uint32_t)al_get_audio_depth_size((ALLEGRO_AUDIO_DEPTH)depth);
 }
 
 lean_object* allegro_al_get_allegro_acodec_version(void) {
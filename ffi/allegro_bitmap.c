@@ -1,5 +1,6 @@
 #include "allegro_ffi.h"
 #include <allegro5/allegro.h>
+#include <string.h>
 
 /* ── Bitmap creation & properties ── */
 
@@ -86,26 +87,26 @@ lean_object* allegro_al_reset_clipping_rectangle(void) {
     return io_ok_unit();
 }
 
-/* ── Pixel format queries ── */
+/* ── Pixel format queries (pure: bound without IO on the Lean side) ── */
 
-lean_object* allegro_al_get_pixel_size(uint32_t format) {
-    return io_ok_uint32((uint32_t)al_get_pixel_size((int)format));
+uint32_t allegro_al_get_pixel_size(uint32_t format) {
+    return (uint32_t)al_get_pixel_size((int)format);
 }
 
-lean_object* allegro_al_get_pixel_format_bits(uint32_t format) {
-    return io_ok_uint32((uint32_t)al_get_pixel_format_bits((int)format));
+uint32_t allegro_al_get_pixel_format_bits(uint32_t format) {
+    return (uint32_t)al_get_pixel_format_bits((int)format);
 }
 
-lean_object* allegro_al_get_pixel_block_size(uint32_t format) {
-    return io_ok_uint32((uint32_t)al_get_pixel_block_size((int)format));
+uint32_t allegro_al_get_pixel_block_size(uint32_t format) {
+    return (uint32_t)al_get_pixel_block_size((int)format);
 }
 
-lean_object* allegro_al_get_pixel_block_width(uint32_t format) {
-    return io_ok_uint32((uint32_t)al_get_pixel_block_width((int)format));
+uint32_t allegro_al_get_pixel_block_width(uint32_t format) {
+    return (uint32_t)al_get_pixel_block_width((int)format);
 }
 
-lean_object* allegro_al_get_pixel_block_height(uint32_t format) {
-    return io_ok_uint32((uint32_t)al_get_pixel_block_height((int)format));
+uint32_t allegro_al_get_pixel_block_height(uint32_t format) {
+    return (uint32_t)al_get_pixel_block_height((int)format);
 }
 
 /* ── Bitmap flags & format ── */
@@ -196,6 +197,137 @@ lean_object* allegro_al_lock_bitmap_region(uint64_t bitmap,
     return io_ok_uint64(ptr_to_u64(lr));
 }
 
+/* ── Bulk region transfer ──
+   Lock a rectangle, copy it row by row to/from a tightly packed buffer
+   (w * pixel_size bytes per row, top row first), and unlock — one call.
+   Rows are addressed through the locked pitch, which is negative for
+   bottom-up (OpenGL) bitmaps. Rejects rectangles outside the bitmap,
+   compressed formats and already-locked bitmaps.
+
+   When both the requested format and the bitmap's own format have a kernel
+   in allegro_pixels.c, the region is locked in the bitmap's format and
+   converted there instead of by Allegro's generic converter. */
+
+static ALLEGRO_LOCKED_REGION *lock_region_checked(ALLEGRO_BITMAP *bmp,
+        int32_t x, int32_t y, uint32_t w, uint32_t h, uint32_t format, int mode) {
+    if (!bmp || w == 0 || h == 0 || x < 0 || y < 0) return NULL;
+    if ((int64_t)x + w > al_get_bitmap_width(bmp) ||
+        (int64_t)y + h > al_get_bitmap_height(bmp)) return NULL;
+    if (al_is_bitmap_locked(bmp)) return NULL;
+    ALLEGRO_LOCKED_REGION *lr =
+        al_lock_bitmap_region(bmp, x, y, (int)w, (int)h, (int)format, mode);
+    if (lr && lr->pixel_size <= 0) {
+        al_unlock_bitmap(bmp);
+        return NULL;
+    }
+    return lr;
+}
+
+static ALLEGRO_LOCKED_REGION *lock_region_for(ALLEGRO_BITMAP *bmp,
+        int32_t x, int32_t y, uint32_t w, uint32_t h, uint32_t format, int mode) {
+    uint32_t lock_format = format;
+    if (bmp && allegro_px_size(format) && allegro_px_size((uint32_t)al_get_bitmap_format(bmp)))
+        lock_format = ALLEGRO_PIXEL_FORMAT_ANY;
+    return lock_region_checked(bmp, x, y, w, h, lock_format, mode);
+}
+
+/* Format of the caller's buffer: the requested one, or the locked one for
+   `any*` requests. */
+static inline uint32_t buffer_format(uint32_t format, const ALLEGRO_LOCKED_REGION *lr) {
+    return allegro_px_size(format) ? format : (uint32_t)lr->format;
+}
+
+lean_object* allegro_read_bitmap_region(uint64_t bitmap, int32_t x, int32_t y,
+                                        uint32_t w, uint32_t h, uint32_t format) {
+    ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(bitmap);
+    ALLEGRO_LOCKED_REGION *lr = lock_region_for(bmp, x, y, w, h, format, ALLEGRO_LOCK_READONLY);
+    if (!lr) return lean_io_result_mk_ok(lean_alloc_sarray(1, 0, 0));
+    uint32_t out_format = buffer_format(format, lr);
+    int converting = out_format != (uint32_t)lr->format;
+    size_t ps = converting ? (size_t)allegro_px_size(out_format) : (size_t)lr->pixel_size;
+    size_t row = (size_t)w * ps;
+    size_t total = row * h;
+    lean_object* ba = lean_alloc_sarray(1, total, total);
+    uint8_t *dst = lean_sarray_cptr(ba);
+    const uint8_t *src = (const uint8_t *)lr->data;
+    if (converting) {
+        allegro_px_convert_rect(src, lr->pitch, (uint32_t)lr->format,
+                                dst, (ptrdiff_t)row, out_format, w, h);
+    } else if ((size_t)lr->pitch == row) {
+        memcpy(dst, src, total);
+    } else {
+        for (uint32_t r = 0; r < h; r++)
+            memcpy(dst + r * row, src + (ptrdiff_t)r * lr->pitch, row);
+    }
+    al_unlock_bitmap(bmp);
+    return lean_io_result_mk_ok(ba);
+}
+
+lean_object* allegro_write_bitmap_region(uint64_t bitmap, int32_t x, int32_t y,
+                                         uint32_t w, uint32_t h, uint32_t format,
+                                         b_lean_obj_arg bytes) {
+    ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(bitmap);
+    int ps = al_get_pixel_size((int)format);
+    /* Concrete formats are checked up front; `any*` formats are checked
+       after locking, once the real pixel size is known. */
+    if (ps > 0 && lean_sarray_size(bytes) < (size_t)w * h * (size_t)ps)
+        return io_ok_uint32(0);
+    ALLEGRO_LOCKED_REGION *lr = lock_region_for(bmp, x, y, w, h, format, ALLEGRO_LOCK_WRITEONLY);
+    if (!lr) return io_ok_uint32(0);
+    uint32_t in_format = buffer_format(format, lr);
+    int converting = in_format != (uint32_t)lr->format;
+    size_t row = (size_t)w * (converting ? (size_t)allegro_px_size(in_format) : (size_t)lr->pixel_size);
+    if (lean_sarray_size(bytes) < row * h) {
+        al_unlock_bitmap(bmp);
+        return io_ok_uint32(0);
+    }
+    const uint8_t *src = lean_sarray_cptr(bytes);
+    uint8_t *dst = (uint8_t *)lr->data;
+    if (converting) {
+        allegro_px_convert_rect(src, (ptrdiff_t)row, in_format,
+                                dst, lr->pitch, (uint32_t)lr->format, w, h);
+    } else if ((size_t)lr->pitch == row) {
+        memcpy(dst, src, row * h);
+    } else {
+        for (uint32_t r = 0; r < h; r++)
+            memcpy(dst + (ptrdiff_t)r * lr->pitch, src + r * row, row);
+    }
+    al_unlock_bitmap(bmp);
+    return io_ok_uint32(1);
+}
+
+/* Fill a rectangle with one packed colour (r | g<<8 | b<<16 | a<<24),
+   written directly into the locked pixels — no blending. */
+lean_object* allegro_fill_bitmap_region(uint64_t bitmap, int32_t x, int32_t y,
+                                        uint32_t w, uint32_t h, uint32_t rgba) {
+    ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(bitmap);
+    ALLEGRO_LOCKED_REGION *lr = lock_region_for(bmp, x, y, w, h,
+            ALLEGRO_PIXEL_FORMAT_ABGR_8888, ALLEGRO_LOCK_WRITEONLY);
+    if (!lr) return io_ok_uint32(0);
+    allegro_px_fill_rect((uint8_t *)lr->data, lr->pitch, (uint32_t)lr->format, w, h, rgba);
+    al_unlock_bitmap(bmp);
+    return io_ok_uint32(1);
+}
+
+/* Copy the w × h rectangle at (sx, sy) of a tightly packed `src_w`-wide
+   buffer into the bitmap at (dx, dy), converting formats on the way. */
+lean_object* allegro_blit_pixels_to_bitmap(uint64_t bitmap, int32_t dx, int32_t dy,
+                                           b_lean_obj_arg src, uint32_t src_fmt, uint32_t src_w,
+                                           uint32_t sx, uint32_t sy, uint32_t w, uint32_t h) {
+    ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(bitmap);
+    int ss = allegro_px_size(src_fmt);
+    if (!ss || src_w == 0 || (uint64_t)sx + w > src_w) return io_ok_uint32(0);
+    ptrdiff_t spitch = (ptrdiff_t)src_w * ss;
+    if ((uint64_t)sy + h > lean_sarray_size(src) / (uint64_t)spitch) return io_ok_uint32(0);
+    ALLEGRO_LOCKED_REGION *lr = lock_region_for(bmp, dx, dy, w, h, src_fmt, ALLEGRO_LOCK_WRITEONLY);
+    if (!lr) return io_ok_uint32(0);
+    allegro_px_convert_rect(lean_sarray_cptr(src) + (ptrdiff_t)sy * spitch + (ptrdiff_t)sx * ss,
+                            spitch, src_fmt, (uint8_t *)lr->data, lr->pitch,
+                            (uint32_t)lr->format, w, h);
+    al_unlock_bitmap(bmp);
+    return io_ok_uint32(1);
+}
+
 lean_object* allegro_al_unlock_bitmap(uint64_t bitmap) {
     if (bitmap != 0) {
         al_unlock_bitmap((ALLEGRO_BITMAP *)u64_to_ptr(bitmap));
@@ -203,6 +335,14 @@ lean_object* allegro_al_unlock_bitmap(uint64_t bitmap) {
     return io_ok_unit();
 }
 
+/* Mirror used by the `extern c inline` LockedRegion accessors in Bitmap.lean. */
+typedef struct { void *data; int format; int pitch; int pixel_size; } InlineLockedRegionMirror;
+
+_Static_assert(offsetof(ALLEGRO_LOCKED_REGION, data) == offsetof(InlineLockedRegionMirror, data), "locked_region.data moved");
+_Static_assert(offsetof(ALLEGRO_LOCKED_REGION, format) == offsetof(InlineLockedRegionMirror, format), "locked_region.format moved");
+_Static_assert(offsetof(ALLEGRO_LOCKED_REGION, pitch) == offsetof(InlineLockedRegionMirror, pitch), "locked_region.pitch moved");
+_Static_assert(offsetof(ALLEGRO_LOCKED_REGION, pixel_size) == offsetof(InlineLockedRegionMirror, pixel_size), "locked_region.pixel_size moved");
+
 lean_object* allegro_al_locked_region_get_format(uint64_t lr) {
     if (lr == 0) return io_ok_uint32(0);
     return io_ok_uint32((uint32_t)((ALLEGRO_LOCKED_REGION *)u64_to_ptr(lr))->format);
@@ -308,20 +448,20 @@ lean_object* allegro_al_is_bitmap_drawing_held(void) {
     return io_ok_uint32(al_is_bitmap_drawing_held() ? 1u : 0u);
 }
 
-/* ── Tuple-returning queries ── */
+/* ── Record-returning queries (Rect / Rgba) ── */
 
 lean_object* allegro_al_get_clipping_rectangle(void) {
     int x = 0, y = 0, w = 0, h = 0;
     al_get_clipping_rectangle(&x, &y, &w, &h);
-    return io_ok_u32_quad((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h);
+    return io_ok_rect(x, y, w, h);
 }
 
 lean_object* allegro_al_get_pixel_rgba(uint64_t bitmap, int32_t x, int32_t y) {
-    if (bitmap == 0) return io_ok_u32_quad(0, 0, 0, 0);
+    if (bitmap == 0) return io_ok_color(0, 0, 0, 0);
     ALLEGRO_COLOR c = al_get_pixel((ALLEGRO_BITMAP *)u64_to_ptr(bitmap), x, y);
     unsigned char r, g, b, a;
     al_unmap_rgba(c, &r, &g, &b, &a);
-    return io_ok_u32_quad((uint32_t)r, (uint32_t)g, (uint32_t)b, (uint32_t)a);
+    return io_ok_color(r, g, b, a);
 }
 
 /* ── Depth / samples / wrap (UNSTABLE) ── */
@@ -390,26 +530,16 @@ lean_object* allegro_al_convert_mask_to_alpha(uint64_t bitmap,
 
 /* ── Per-bitmap blender (UNSTABLE) ── */
 
-lean_object* allegro_al_get_bitmap_blender(void) {
-    int op, src, dst;
-    al_get_bitmap_blender(&op, &src, &dst);
-    return io_ok_u32_triple((uint32_t)op, (uint32_t)src, (uint32_t)dst);
-}
-
 lean_object* allegro_al_set_bitmap_blender(uint32_t op, uint32_t src, uint32_t dst) {
     al_set_bitmap_blender((int)op, (int)src, (int)dst);
     return io_ok_unit();
 }
 
+/* Returns a BlenderState; the (op, src, dst) form is a Lean-side projection. */
 lean_object* allegro_al_get_separate_bitmap_blender(void) {
     int op, src, dst, aop, asrc, adst;
     al_get_separate_bitmap_blender(&op, &src, &dst, &aop, &asrc, &adst);
-    lean_object* p5 = mk_pair(lean_box_uint32((uint32_t)asrc), lean_box_uint32((uint32_t)adst));
-    lean_object* p4 = mk_pair(lean_box_uint32((uint32_t)aop), p5);
-    lean_object* p3 = mk_pair(lean_box_uint32((uint32_t)dst), p4);
-    lean_object* p2 = mk_pair(lean_box_uint32((uint32_t)src), p3);
-    lean_object* p1 = mk_pair(lean_box_uint32((uint32_t)op), p2);
-    return lean_io_result_mk_ok(p1);
+    return io_ok_blender_state(op, src, dst, aop, asrc, adst);
 }
 
 lean_object* allegro_al_set_separate_bitmap_blender(
@@ -424,7 +554,7 @@ lean_object* allegro_al_get_bitmap_blend_color(void) {
     ALLEGRO_COLOR c = al_get_bitmap_blend_color();
     float r, g, b, a;
     al_unmap_rgba_f(c, &r, &g, &b, &a);
-    return io_ok_f64_quad((double)r, (double)g, (double)b, (double)a);
+    return io_ok_color_f((double)r, (double)g, (double)b, (double)a);
 }
 
 lean_object* allegro_al_set_bitmap_blend_color(double r, double g, double b, double a) {
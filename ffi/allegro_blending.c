@@ -37,24 +37,14 @@ lean_object* allegro_al_draw_tinted_bitmap_rgba(
     return io_ok_unit();
 }
 
-/* ── Tuple-returning queries ── */
-
-lean_object* allegro_al_get_blender(void) {
-    int op, src, dest;
-    al_get_blender(&op, &src, &dest);
-    return io_ok_u32_triple((uint32_t)op, (uint32_t)src, (uint32_t)dest);
-}
+/* ── Record-returning queries ── */
 
+/* Returns a BlenderState. al_get_blender reports the colour half of the
+   separate blender, so getBlender is a Lean-side projection of this. */
 lean_object* allegro_al_get_separate_blender(void) {
     int op, src, dst, aop, asrc, adst;
     al_get_separate_blender(&op, &src, &dst, &aop, &asrc, &adst);
-    /* Return (op, src, dst, alphaOp, alphaSrc, alphaDst) as nested pairs */
-    lean_object* p5 = mk_pair(lean_box_uint32((uint32_t)asrc), lean_box_uint32((uint32_t)adst));
-    lean_object* p4 = mk_pair(lean_box_uint32((uint32_t)aop), p5);
-    lean_object* p3 = mk_pair(lean_box_uint32((uint32_t)dst), p4);
-    lean_object* p2 = mk_pair(lean_box_uint32((uint32_t)src), p3);
-    lean_object* p1 = mk_pair(lean_box_uint32((uint32_t)op), p2);
-    return lean_io_result_mk_ok(p1);
+    return io_ok_blender_state(op, src, dst, aop, asrc, adst);
 }
 
 /* ── Blend colour ── */
@@ -63,7 +53,7 @@ lean_object* allegro_al_get_blend_color(void) {
     ALLEGRO_COLOR c = al_get_blend_color();
     float r, g, b, a;
     al_unmap_rgba_f(c, &r, &g, &b, &a);
-    return io_ok_f64_quad((double)r, (double)g, (double)b, (double)a);
+    return io_ok_color_f((double)r, (double)g, (double)b, (double)a);
 }
 
 lean_object* allegro_al_set_blend_color(double r, double g, double b, double a) {
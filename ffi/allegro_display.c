@@ -260,9 +260,11 @@ lean_object* allegro_al_get_window_position(uint64_t display) {
 
 lean_object* allegro_al_get_monitor_info(uint32_t adapter) {
     ALLEGRO_MONITOR_INFO info;
-    if (!al_get_monitor_info((int)adapter, &info)) return io_ok_u32_quad(0, 0, 0, 0);
-    return io_ok_u32_quad((uint32_t)info.x1, (uint32_t)info.y1,
-                          (uint32_t)info.x2, (uint32_t)info.y2);
+    if (!al_get_monitor_info((int)adapter, &info))
+        return lean_io_result_mk_ok(mk_u32x4(0, 0, 0, 0));
+    /* MonitorInfo: x1@0 y1@4 x2@8 y2@12 */
+    return lean_io_result_mk_ok(mk_u32x4((uint32_t)info.x1, (uint32_t)info.y1,
+                                         (uint32_t)info.x2, (uint32_t)info.y2));
 }
 
 lean_object* allegro_al_get_display_mode(uint32_t index) {
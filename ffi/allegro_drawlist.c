@@ -0,0 +1,209 @@
+#include "allegro_ffi.h"
+#include <string.h>
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <allegro5/allegro_primitives.h>
+
+/* ── Recorded draw lists ──
+   Replays a buffer encoded by Allegro.DrawList: a one-byte opcode followed
+   by little-endian, unpadded fields (u64 handles, f32 coordinates, u32
+   colours packed r | g<<8 | b<<16 | a<<24). Fields are read with memcpy so
+   the buffer need not be aligned. Opcode numbers must match DrawList.lean. */
+
+enum {
+    DL_CLEAR = 1,
+    DL_BITMAP = 2,
+    DL_BITMAP_REGION = 3,
+    DL_SCALED_BITMAP = 4,
+    DL_TINTED_SCALED_ROTATED_REGION = 5,
+    DL_FILLED_RECT = 6,
+    DL_RECT = 7,
+    DL_LINE = 8,
+    DL_FILLED_CIRCLE = 9,
+    DL_CIRCLE = 10,
+    DL_TEXT = 11,
+    DL_CLIP = 12,
+    DL_RESET_CLIP = 13
+};
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+} dl_reader;
+
+static inline int dl_has(const dl_reader *r, size_t n) {
+    return (size_t)(r->end - r->p) >= n;
+}
+
+static inline uint32_t dl_u32(dl_reader *r) {
+    uint32_t v;
+    memcpy(&v, r->p, 4);
+    r->p += 4;
+    return v;
+}
+
+static inline uint64_t dl_u64(dl_reader *r) {
+    uint64_t v;
+    memcpy(&v, r->p, 8);
+    r->p += 8;
+    return v;
+}
+
+static inline float dl_f32(dl_reader *r) {
+    float v;
+    memcpy(&v, r->p, 4);
+    r->p += 4;
+    return v;
+}
+
+static inline ALLEGRO_COLOR dl_color(dl_reader *r) {
+    uint32_t c = dl_u32(r);
+    return al_map_rgba((unsigned char)c, (unsigned char)(c >> 8),
+                       (unsigned char)(c >> 16), (unsigned char)(c >> 24));
+}
+
+/* Payload size after the opcode for fixed-size commands; 0 for unknown.
+   DL_TEXT is variable and checked separately. */
+static size_t dl_fixed_size(uint8_t op) {
+    switch (op) {
+    case DL_CLEAR:                        return 4;
+    case DL_BITMAP:                       return 8 + 2 * 4 + 4;
+    case DL_BITMAP_REGION:                return 8 + 6 * 4 + 4;
+    case DL_SCALED_BITMAP:                return 8 + 8 * 4 + 4;
+    case DL_TINTED_SCALED_ROTATED_REGION: return 8 + 4 * 4 + 4 + 7 * 4 + 4;
+    case DL_FILLED_RECT:                  return 4 * 4 + 4;
+    case DL_RECT:                         return 5 * 4 + 4;
+    case DL_LINE:                         return 5 * 4 + 4;
+    case DL_FILLED_CIRCLE:                return 3 * 4 + 4;
+    case DL_CIRCLE:                       return 4 * 4 + 4;
+    case DL_TEXT:                         return 8 + 4 + 2 * 4 + 4 + 4;
+    case DL_CLIP:                         return 4 * 4;
+    case DL_RESET_CLIP:                   return 0;
+    default:                              return (size_t)-1;
+    }
+}
+
+/* Bitmap and text commands may run under al_hold_bitmap_drawing. */
+static inline int dl_is_bitmap_op(uint8_t op) {
+    return op == DL_BITMAP || op == DL_BITMAP_REGION || op == DL_SCALED_BITMAP
+        || op == DL_TINTED_SCALED_ROTATED_REGION || op == DL_TEXT;
+}
+
+lean_object* allegro_execute_draw_list(b_lean_obj_arg bytes) {
+    dl_reader r;
+    r.p = lean_sarray_cptr(bytes);
+    r.end = r.p + lean_sarray_size(bytes);
+
+    bool was_held = al_is_bitmap_drawing_held();
+    bool held = was_held;
+    uint32_t executed = 0;
+
+    while (dl_has(&r, 1)) {
+        uint8_t op = *r.p;
+        size_t need = dl_fixed_size(op);
+        if (need == (size_t)-1 || !dl_has(&r, 1 + need)) break;
+        r.p++;
+
+        int bitmap_op = dl_is_bitmap_op(op);
+        if (bitmap_op != held) {
+            al_hold_bitmap_drawing(bitmap_op);
+            held = bitmap_op;
+        }
+
+        switch (op) {
+        case DL_CLEAR:
+            al_clear_to_color(dl_color(&r));
+            break;
+        case DL_BITMAP: {
+            ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(dl_u64(&r));
+            float dx = dl_f32(&r), dy = dl_f32(&r);
+            int flags = (int)dl_u32(&r);
+            if (bmp) al_draw_bitmap(bmp, dx, dy, flags);
+            break;
+        }
+        case DL_BITMAP_REGION: {
+            ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(dl_u64(&r));
+            float sx = dl_f32(&r), sy = dl_f32(&r), sw = dl_f32(&r), sh = dl_f32(&r);
+            float dx = dl_f32(&r), dy = dl_f32(&r);
+            int flags = (int)dl_u32(&r);
+            if (bmp) al_draw_bitmap_region(bmp, sx, sy, sw, sh, dx, dy, flags);
+            break;
+        }
+        case DL_SCALED_BITMAP: {
+            ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(dl_u64(&r));
+            float sx = dl_f32(&r), sy = dl_f32(&r), sw = dl_f32(&r), sh = dl_f32(&r);
+            float dx = dl_f32(&r), dy = dl_f32(&r), dw = dl_f32(&r), dh = dl_f32(&r);
+            int flags = (int)dl_u32(&r);
+            if (bmp) al_draw_scaled_bitmap(bmp, sx, sy, sw, sh, dx, dy, dw, dh, flags);
+            break;
+        }
+        case DL_TINTED_SCALED_ROTATED_REGION: {
+            ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(dl_u64(&r));
+            float sx = dl_f32(&r), sy = dl_f32(&r), sw = dl_f32(&r), sh = dl_f32(&r);
+            ALLEGRO_COLOR tint = dl_color(&r);
+            float cx = dl_f32(&r), cy = dl_f32(&r), dx = dl_f32(&r), dy = dl_f32(&r);
+            float xs = dl_f32(&r), ys = dl_f32(&r), angle = dl_f32(&r);
+            int flags = (int)dl_u32(&r);
+            if (bmp)
+                al_draw_tinted_scaled_rotated_bitmap_region(
+                    bmp, sx, sy, sw, sh, tint, cx, cy, dx, dy, xs, ys, angle, flags);
+            break;
+        }
+        case DL_FILLED_RECT: {
+            float x1 = dl_f32(&r), y1 = dl_f32(&r), x2 = dl_f32(&r), y2 = dl_f32(&r);
+            al_draw_filled_rectangle(x1, y1, x2, y2, dl_color(&r));
+            break;
+        }
+        case DL_RECT: {
+            float x1 = dl_f32(&r), y1 = dl_f32(&r), x2 = dl_f32(&r), y2 = dl_f32(&r);
+            float t = dl_f32(&r);
+            al_draw_rectangle(x1, y1, x2, y2, dl_color(&r), t);
+            break;
+        }
+        case DL_LINE: {
+            float x1 = dl_f32(&r), y1 = dl_f32(&r), x2 = dl_f32(&r), y2 = dl_f32(&r);
+            float t = dl_f32(&r);
+            al_draw_line(x1, y1, x2, y2, dl_color(&r), t);
+            break;
+        }
+        case DL_FILLED_CIRCLE: {
+            float cx = dl_f32(&r), cy = dl_f32(&r), rad = dl_f32(&r);
+            al_draw_filled_circle(cx, cy, rad, dl_color(&r));
+            break;
+        }
+        case DL_CIRCLE: {
+            float cx = dl_f32(&r), cy = dl_f32(&r), rad = dl_f32(&r), t = dl_f32(&r);
+            al_draw_circle(cx, cy, rad, dl_color(&r), t);
+            break;
+        }
+        case DL_TEXT: {
+            ALLEGRO_FONT *font = (ALLEGRO_FONT *)u64_to_ptr(dl_u64(&r));
+            ALLEGRO_COLOR color = dl_color(&r);
+            float x = dl_f32(&r), y = dl_f32(&r);
+            int flags = (int)dl_u32(&r);
+            uint32_t len = dl_u32(&r);
+            if (!dl_has(&r, len)) goto done;
+            /* Reference the UTF-8 bytes in place — no copy, no NUL needed. */
+            ALLEGRO_USTR_INFO info;
+            const ALLEGRO_USTR *us = al_ref_buffer(&info, (const char *)r.p, len);
+            r.p += len;
+            if (font) al_draw_ustr(font, color, x, y, flags, us);
+            break;
+        }
+        case DL_CLIP: {
+            int x = (int)(int32_t)dl_u32(&r), y = (int)(int32_t)dl_u32(&r);
+            int w = (int)dl_u32(&r), h = (int)dl_u32(&r);
+            al_set_clipping_rectangle(x, y, w, h);
+            break;
+        }
+        case DL_RESET_CLIP:
+            al_reset_clipping_rectangle();
+            break;
+        }
+        executed++;
+    }
+
+done:
+    if (held != was_held) al_hold_bitmap_drawing(was_held);
+    return io_ok_uint32(executed);
+}
@@ -1,6 +1,243 @@
 #include "allegro_ffi.h"
 #include <allegro5/allegro.h>
 
+/* ── Native event filtering ──
+   Per-queue drop masks and coalescing rules, kept in a small registry keyed
+   by queue pointer.  They are applied by the `*_data` entry points before
+   pack_event_data runs, so dropped or merged events never reach Lean.
+   Queues without an entry only pay for the (usually empty) list scan.
+
+   The registry may be changed from one thread while another waits on a
+   queue, so it is guarded by `event_filters_mutex`.  The lock is never held
+   across an Allegro wait: each fetch copies the queue's rules into a
+   FilterScope, works on that copy, and folds its counters back at the end. */
+
+#define EVENT_COALESCE_MOUSE_AXES 1u
+#define EVENT_COALESCE_TOUCH_MOVE 2u
+
+typedef struct EventFilter {
+    ALLEGRO_EVENT_QUEUE *queue;
+    uint64_t drop_mask;   /* bit n set → drop built-in event type n (n < 64) */
+    uint32_t coalesce;    /* EVENT_COALESCE_* flags */
+    uint64_t dropped;
+    uint64_t merged;
+    /* A peek that coalesces has to take the merged events off the queue;
+       the result waits here and is the queue's next event for every fetch. */
+    bool has_pending;
+    ALLEGRO_EVENT pending;
+    struct EventFilter *next;
+} EventFilter;
+
+static EventFilter *event_filters = NULL;
+static ALLEGRO_MUTEX *event_filters_mutex = NULL;
+
+/* Called from allegro_al_init, before any queue can exist. */
+void allegro_event_filters_init(void) {
+    if (event_filters_mutex == NULL) event_filters_mutex = al_create_mutex();
+}
+
+static void lock_event_filters(void) {
+    if (event_filters_mutex != NULL) al_lock_mutex(event_filters_mutex);
+}
+
+static void unlock_event_filters(void) {
+    if (event_filters_mutex != NULL) al_unlock_mutex(event_filters_mutex);
+}
+
+/* The registry helpers below expect the lock to be held. */
+
+static EventFilter *find_event_filter(ALLEGRO_EVENT_QUEUE *q) {
+    for (EventFilter *f = event_filters; f != NULL; f = f->next) {
+        if (f->queue == q) return f;
+    }
+    return NULL;
+}
+
+static EventFilter *get_or_create_event_filter(ALLEGRO_EVENT_QUEUE *q) {
+    EventFilter *f = find_event_filter(q);
+    if (f == NULL) {
+        f = (EventFilter *)calloc(1, sizeof(EventFilter));
+        if (f == NULL) return NULL;
+        f->queue = q;
+        f->next = event_filters;
+        event_filters = f;
+    }
+    return f;
+}
+
+static void remove_event_filter(ALLEGRO_EVENT_QUEUE *q) {
+    for (EventFilter **pp = &event_filters; *pp != NULL; pp = &(*pp)->next) {
+        if ((*pp)->queue == q) {
+            EventFilter *dead = *pp;
+            *pp = dead->next;
+            free(dead);
+            return;
+        }
+    }
+}
+
+/* One fetch's view of a queue's filter: the rules as they were when the
+   fetch started, plus the counts to add when it ends. */
+typedef struct {
+    ALLEGRO_EVENT_QUEUE *queue;
+    uint64_t drop_mask;
+    uint32_t coalesce;
+    uint64_t dropped;
+    uint64_t merged;
+} FilterScope;
+
+static void filter_begin(FilterScope *s, ALLEGRO_EVENT_QUEUE *q) {
+    s->queue = q;
+    s->drop_mask = 0;
+    s->coalesce = 0;
+    s->dropped = 0;
+    s->merged = 0;
+    lock_event_filters();
+    EventFilter *f = find_event_filter(q);
+    if (f != NULL) {
+        s->drop_mask = f->drop_mask;
+        s->coalesce = f->coalesce;
+    }
+    unlock_event_filters();
+}
+
+/* Copy the event a peek parked for `q` into `ev` (if `ev` is non-NULL);
+   `take` also removes it.  Every fetch, filtered or raw, checks this first
+   so the parked event keeps its place at the head of the queue. */
+static bool pending_event(ALLEGRO_EVENT_QUEUE *q, ALLEGRO_EVENT *ev, bool take) {
+    bool got = false;
+    lock_event_filters();
+    EventFilter *f = find_event_filter(q);
+    if (f != NULL && f->has_pending) {
+        if (ev != NULL) *ev = f->pending;
+        if (take) f->has_pending = false;
+        got = true;
+    }
+    unlock_event_filters();
+    return got;
+}
+
+/* Fold the counts back into the registry; with `keep` non-NULL, also store
+   it as the queue's pending event (see peek_filtered). */
+static void filter_end(FilterScope *s, const ALLEGRO_EVENT *keep) {
+    if (s->dropped == 0 && s->merged == 0 && keep == NULL) return;
+    lock_event_filters();
+    EventFilter *f = keep != NULL ? get_or_create_event_filter(s->queue)
+                                  : find_event_filter(s->queue);
+    if (f != NULL) {
+        f->dropped += s->dropped;
+        f->merged += s->merged;
+        if (keep != NULL) {
+            f->pending = *keep;
+            f->has_pending = true;
+        }
+    }
+    unlock_event_filters();
+}
+
+static bool event_filter_drops(FilterScope *s, const ALLEGRO_EVENT *ev) {
+    if (ev->type >= 64) return false;
+    if (s->drop_mask & ((uint64_t)1 << ev->type)) {
+        s->dropped++;
+        return true;
+    }
+    return false;
+}
+
+static bool event_coalesces(const FilterScope *s, const ALLEGRO_EVENT *ev) {
+    return (ev->type == ALLEGRO_EVENT_MOUSE_AXES && (s->coalesce & EVENT_COALESCE_MOUSE_AXES))
+        || (ev->type == ALLEGRO_EVENT_TOUCH_MOVE && (s->coalesce & EVENT_COALESCE_TOUCH_MOVE));
+}
+
+/* Fold queued successors of the same coalescible kind into `ev`:
+   the latest position wins, relative deltas are summed. */
+static void coalesce_events(FilterScope *s, ALLEGRO_EVENT *ev) {
+    if (!event_coalesces(s, ev)) return;
+    ALLEGRO_EVENT_QUEUE *q = s->queue;
+    ALLEGRO_EVENT nx;
+    if (ev->type == ALLEGRO_EVENT_MOUSE_AXES) {
+        while (al_peek_next_event(q, &nx)
+               && nx.type == ALLEGRO_EVENT_MOUSE_AXES
+               && nx.mouse.display == ev->mouse.display) {
+            nx.mouse.dx += ev->mouse.dx;
+            nx.mouse.dy += ev->mouse.dy;
+            nx.mouse.dz += ev->mouse.dz;
+            nx.mouse.dw += ev->mouse.dw;
+            *ev = nx;
+            al_drop_next_event(q);
+            s->merged++;
+        }
+    } else {
+        while (al_peek_next_event(q, &nx)
+               && nx.type == ALLEGRO_EVENT_TOUCH_MOVE
+               && nx.touch.id == ev->touch.id
+               && nx.touch.display == ev->touch.display) {
+            nx.touch.dx += ev->touch.dx;
+            nx.touch.dy += ev->touch.dy;
+            *ev = nx;
+            al_drop_next_event(q);
+            s->merged++;
+        }
+    }
+}
+
+/* Filter-aware fetch helpers, on a scope from filter_begin.  Without a
+   registry entry they reduce to the plain Allegro calls. */
+
+static void wait_filtered(FilterScope *s, ALLEGRO_EVENT *ev) {
+    if (!pending_event(s->queue, ev, true)) {
+        do {
+            al_wait_for_event(s->queue, ev);
+        } while (event_filter_drops(s, ev));
+    }
+    coalesce_events(s, ev);
+}
+
+static bool next_filtered(FilterScope *s, ALLEGRO_EVENT *ev) {
+    bool got = pending_event(s->queue, ev, true);
+    while (!got && al_get_next_event(s->queue, ev)) {
+        got = !event_filter_drops(s, ev);
+    }
+    if (got) coalesce_events(s, ev);
+    return got;
+}
+
+static bool until_filtered(FilterScope *s, ALLEGRO_EVENT *ev, ALLEGRO_TIMEOUT *timeout) {
+    bool got = pending_event(s->queue, ev, true);
+    while (!got && al_wait_for_event_until(s->queue, ev, timeout)) {
+        got = !event_filter_drops(s, ev);
+    }
+    if (got) coalesce_events(s, ev);
+    return got;
+}
+
+/* Peeking returns exactly what the next fetch would: filtered-out events at
+   the head are discarded, and a coalescible head is merged with its queued
+   successors.  Allegro cannot look past the head, so that merge takes the
+   events off the queue and parks the result as the pending event. */
+static bool peek_filtered(FilterScope *s, ALLEGRO_EVENT *ev) {
+    bool park = pending_event(s->queue, ev, true);
+    bool got = park;
+    while (!got && al_peek_next_event(s->queue, ev)) {
+        if (!event_filter_drops(s, ev)) {
+            got = true;
+        } else {
+            al_drop_next_event(s->queue);
+        }
+    }
+    if (got && !park && event_coalesces(s, ev)) {
+        al_drop_next_event(s->queue);
+        park = true;
+    }
+    if (park) {
+        coalesce_events(s, ev);
+        filter_end(s, ev);
+    } else {
+        filter_end(s, NULL);
+    }
+    return got;
+}
+
 /* ── Event queue lifecycle ── */
 
 lean_object* allegro_al_create_event_queue(void) {
@@ -9,6 +246,9 @@ lean_object* allegro_al_create_event_queue(void) {
 
 lean_object* allegro_al_destroy_event_queue(uint64_t queue) {
     if (queue != 0) {
+        lock_event_filters();
+        remove_event_filter((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        unlock_event_filters();
         al_destroy_event_queue((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
     }
     return io_ok_unit();
@@ -30,6 +270,7 @@ lean_object* allegro_al_unregister_event_source(uint64_t queue, uint64_t source)
 
 lean_object* allegro_al_flush_event_queue(uint64_t queue) {
     if (queue != 0) {
+        pending_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), NULL, true);
         al_flush_event_queue((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
     }
     return io_ok_unit();
@@ -61,42 +302,51 @@ lean_object* allegro_al_destroy_event(uint64_t eventPtr) {
     return io_ok_unit();
 }
 
-/* ── Waiting and polling ── */
+/* ── Waiting and polling ──
+   These raw-buffer calls are unfiltered, but an event parked by a filtered
+   peek (see peek_filtered) is still the head of the queue. */
 
 lean_object* allegro_al_wait_for_event(uint64_t queue, uint64_t eventPtr) {
     if (queue != 0 && eventPtr != 0) {
-        al_wait_for_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), (ALLEGRO_EVENT *)u64_to_ptr(eventPtr));
+        ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+        ALLEGRO_EVENT *ev = (ALLEGRO_EVENT *)u64_to_ptr(eventPtr);
+        if (!pending_event(q, ev, true)) al_wait_for_event(q, ev);
     }
     return io_ok_unit();
 }
 
 lean_object* allegro_al_wait_for_event_timed(uint64_t queue, uint64_t eventPtr, double secs) {
     if (queue == 0 || eventPtr == 0) return io_ok_uint32(0);
-    bool got = al_wait_for_event_timed(
-        (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue),
-        (ALLEGRO_EVENT *)u64_to_ptr(eventPtr),
-        (float)secs);
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    ALLEGRO_EVENT *ev = (ALLEGRO_EVENT *)u64_to_ptr(eventPtr);
+    bool got = pending_event(q, ev, true) || al_wait_for_event_timed(q, ev, (float)secs);
     return io_ok_uint32(got ? 1u : 0u);
 }
 
 lean_object* allegro_al_get_next_event(uint64_t queue, uint64_t eventPtr) {
     if (queue == 0 || eventPtr == 0) return io_ok_uint32(0);
-    return io_ok_uint32(al_get_next_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), (ALLEGRO_EVENT *)u64_to_ptr(eventPtr)) ? 1u : 0u);
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    ALLEGRO_EVENT *ev = (ALLEGRO_EVENT *)u64_to_ptr(eventPtr);
+    return io_ok_uint32(pending_event(q, ev, true) || al_get_next_event(q, ev) ? 1u : 0u);
 }
 
 lean_object* allegro_al_peek_next_event(uint64_t queue, uint64_t eventPtr) {
     if (queue == 0 || eventPtr == 0) return io_ok_uint32(0);
-    return io_ok_uint32(al_peek_next_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), (ALLEGRO_EVENT *)u64_to_ptr(eventPtr)) ? 1u : 0u);
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    ALLEGRO_EVENT *ev = (ALLEGRO_EVENT *)u64_to_ptr(eventPtr);
+    return io_ok_uint32(pending_event(q, ev, false) || al_peek_next_event(q, ev) ? 1u : 0u);
 }
 
 lean_object* allegro_al_drop_next_event(uint64_t queue) {
     if (queue == 0) return io_ok_uint32(0);
-    return io_ok_uint32(al_drop_next_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue)) ? 1u : 0u);
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    return io_ok_uint32(pending_event(q, NULL, true) || al_drop_next_event(q) ? 1u : 0u);
 }
 
 lean_object* allegro_al_is_event_queue_empty(uint64_t queue) {
     if (queue == 0) return io_ok_uint32(1);
-    return io_ok_uint32(al_is_event_queue_empty((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue)) ? 1u : 0u);
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    return io_ok_uint32(!pending_event(q, NULL, false) && al_is_event_queue_empty(q) ? 1u : 0u);
 }
 
 lean_object* allegro_al_is_event_queue_paused(uint64_t queue) {
@@ -111,6 +361,29 @@ lean_object* allegro_al_pause_event_queue(uint64_t queue, uint32_t pause) {
     return io_ok_unit();
 }
 
+/* ── Layout mirrors for the inline Lean accessors ──
+   Events.lean binds the hottest field reads with `@[extern c inline]`,
+   casting the handle to these same anonymous-struct layouts.  The casts are
+   spelled out in full so the pasted code needs nothing beyond lean.h in the
+   caller's C file (including consumer packages).  If Allegro's event union
+   ever changes, these asserts fail here instead of the inline reads
+   silently misreading memory.  Keep both sides in sync. */
+
+typedef struct { unsigned int type; void *source; double timestamp; void *display;
+                 int x, y, z, w, dx, dy, dz, dw; unsigned int button; } InlineMouseEventMirror;
+typedef struct { unsigned int type; void *source; double timestamp; void *display;
+                 int keycode; int unichar; } InlineKeyboardEventMirror;
+
+_Static_assert(offsetof(ALLEGRO_EVENT, type) == 0, "ALLEGRO_EVENT.type moved");
+_Static_assert(sizeof(ALLEGRO_EVENT_TYPE) == sizeof(unsigned int), "ALLEGRO_EVENT_TYPE size changed");
+_Static_assert(offsetof(ALLEGRO_EVENT, mouse.x) == offsetof(InlineMouseEventMirror, x), "mouse.x moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, mouse.y) == offsetof(InlineMouseEventMirror, y), "mouse.y moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, mouse.dx) == offsetof(InlineMouseEventMirror, dx), "mouse.dx moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, mouse.dy) == offsetof(InlineMouseEventMirror, dy), "mouse.dy moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, mouse.button) == offsetof(InlineMouseEventMirror, button), "mouse.button moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, keyboard.keycode) == offsetof(InlineKeyboardEventMirror, keycode), "keyboard.keycode moved");
+_Static_assert(offsetof(ALLEGRO_EVENT, keyboard.unichar) == offsetof(InlineKeyboardEventMirror, unichar), "keyboard.unichar moved");
+
 /* ── General event fields ── */
 
 lean_object* allegro_al_event_get_type(uint64_t eventPtr) {
@@ -472,7 +745,10 @@ static lean_object* pack_event_data(const ALLEGRO_EVENT *ev) {
 lean_object* allegro_al_wait_for_event_data(uint64_t queue) {
     ALLEGRO_EVENT ev;
     if (queue != 0) {
-        al_wait_for_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), &ev);
+        FilterScope s;
+        filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        wait_filtered(&s, &ev);
+        filter_end(&s, NULL);
     } else {
         memset(&ev, 0, sizeof(ev));
     }
@@ -484,8 +760,13 @@ lean_object* allegro_al_wait_for_event_timed_data(uint64_t queue, double secs) {
     memset(&ev, 0, sizeof(ev));
     uint32_t got = 0;
     if (queue != 0) {
-        got = al_wait_for_event_timed(
-            (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), &ev, (float)secs) ? 1u : 0u;
+        /* Dropped events must not restart the wait, so use one deadline. */
+        ALLEGRO_TIMEOUT timeout;
+        al_init_timeout(&timeout, secs);
+        FilterScope s;
+        filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        got = until_filtered(&s, &ev, &timeout) ? 1u : 0u;
+        filter_end(&s, NULL);
     }
     /* Return (got : UInt32, data : EventData) as a pair */
     lean_object* data = pack_event_data(&ev);
@@ -498,7 +779,10 @@ lean_object* allegro_al_get_next_event_data(uint64_t queue) {
     memset(&ev, 0, sizeof(ev));
     uint32_t got = 0;
     if (queue != 0) {
-        got = al_get_next_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), &ev) ? 1u : 0u;
+        FilterScope s;
+        filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        got = next_filtered(&s, &ev) ? 1u : 0u;
+        filter_end(&s, NULL);
     }
     lean_object* data = pack_event_data(&ev);
     lean_object* pair = mk_pair(lean_box_uint32(got), data);
@@ -510,13 +794,177 @@ lean_object* allegro_al_peek_next_event_data(uint64_t queue) {
     memset(&ev, 0, sizeof(ev));
     uint32_t got = 0;
     if (queue != 0) {
-        got = al_peek_next_event((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue), &ev) ? 1u : 0u;
+        FilterScope s;
+        filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        got = peek_filtered(&s, &ev) ? 1u : 0u;
     }
     lean_object* data = pack_event_data(&ev);
     lean_object* pair = mk_pair(lean_box_uint32(got), data);
     return lean_io_result_mk_ok(pair);
 }
 
+/* ── Batched drain ──
+   Blocks for the first event, then pulls up to `max - 1` further events
+   that are already queued, all in one FFI crossing.  `pack` converts each
+   event to its Lean value; the result is an `Array` of them in queue
+   order (empty for a null queue or max == 0).  Queue filters apply. */
+typedef lean_object* (*EventPacker)(const ALLEGRO_EVENT *ev);
+
+static lean_object* drain_events(uint64_t queue, uint32_t max, EventPacker pack) {
+    if (queue == 0 || max == 0) {
+        return lean_io_result_mk_ok(lean_alloc_array(0, 0));
+    }
+    FilterScope s;
+    filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+    ALLEGRO_EVENT ev;
+    wait_filtered(&s, &ev);
+    /* Start small; lean_array_push grows the array if a burst needs it. */
+    size_t cap = max < 16u ? (size_t)max : 16u;
+    lean_object* arr = lean_alloc_array(0, cap);
+    arr = lean_array_push(arr, pack(&ev));
+    while (lean_array_size(arr) < (size_t)max && next_filtered(&s, &ev)) {
+        arr = lean_array_push(arr, pack(&ev));
+    }
+    filter_end(&s, NULL);
+    return lean_io_result_mk_ok(arr);
+}
+
+lean_object* allegro_al_drain_event_data(uint64_t queue, uint32_t max) {
+    return drain_events(queue, max, pack_event_data);
+}
+
+/* ── ALLEGRO_EVENT → GameEvent ──
+   Builds the `Allegro.GameEvent` constructors (src/Allegro/GameLoop.lean)
+   directly, skipping the intermediate EventData object.  KeyCode and
+   EventType are single-field structures, so they are unboxed to uint32_t.
+   Layout (ctor tag: scalar area, Floats before UInt32s):
+     0 tick                      boxed
+     1 keyDown   key            4 bytes  (key @0)
+     2 keyUp     key            4 bytes  (key @0)
+     3 keyChar   key unichar    8 bytes  (key @0, unichar @4)
+     4 mouseMove x y           16 bytes  (x @0, y @8)
+     5 mouseDown button x y    20 bytes  (x @0, y @8, button @16)
+     6 mouseUp   button x y    20 bytes  (x @0, y @8, button @16)
+     7 quit                      boxed
+     8 resize    w h            8 bytes  (w @0, h @4)
+     9 other     evType         4 bytes  (evType @0)
+   Keep in sync with the `GameEvent` declaration. */
+static lean_object* mk_game_event_u32(unsigned tag, uint32_t v) {
+    lean_object* obj = lean_alloc_ctor(tag, 0, 4);
+    lean_ctor_set_uint32(obj, 0, v);
+    return obj;
+}
+
+static lean_object* mk_game_event_u32_pair(unsigned tag, uint32_t a, uint32_t b) {
+    lean_object* obj = lean_alloc_ctor(tag, 0, 8);
+    lean_ctor_set_uint32(obj, 0, a);
+    lean_ctor_set_uint32(obj, 4, b);
+    return obj;
+}
+
+static lean_object* mk_game_event_mouse(unsigned tag, const ALLEGRO_EVENT *ev) {
+    lean_object* obj = lean_alloc_ctor(tag, 0, 20);
+    lean_ctor_set_float(obj, 0, (double)ev->mouse.x);
+    lean_ctor_set_float(obj, 8, (double)ev->mouse.y);
+    lean_ctor_set_uint32(obj, 16, (uint32_t)ev->mouse.button);
+    return obj;
+}
+
+static lean_object* pack_game_event(const ALLEGRO_EVENT *ev) {
+    switch (ev->type) {
+    case ALLEGRO_EVENT_TIMER:
+        return lean_box(0);
+    case ALLEGRO_EVENT_KEY_DOWN:
+        return mk_game_event_u32(1, (uint32_t)ev->keyboard.keycode);
+    case ALLEGRO_EVENT_KEY_UP:
+        return mk_game_event_u32(2, (uint32_t)ev->keyboard.keycode);
+    case ALLEGRO_EVENT_KEY_CHAR:
+        return mk_game_event_u32_pair(3, (uint32_t)ev->keyboard.keycode,
+                                      (uint32_t)ev->keyboard.unichar);
+    case ALLEGRO_EVENT_MOUSE_AXES: {
+        lean_object* obj = lean_alloc_ctor(4, 0, 16);
+        lean_ctor_set_float(obj, 0, (double)ev->mouse.x);
+        lean_ctor_set_float(obj, 8, (double)ev->mouse.y);
+        return obj;
+    }
+    case ALLEGRO_EVENT_MOUSE_BUTTON_DOWN:
+        return mk_game_event_mouse(5, ev);
+    case ALLEGRO_EVENT_MOUSE_BUTTON_UP:
+        return mk_game_event_mouse(6, ev);
+    case ALLEGRO_EVENT_DISPLAY_CLOSE:
+        return lean_box(7);
+    case ALLEGRO_EVENT_DISPLAY_RESIZE:
+        return mk_game_event_u32_pair(8, (uint32_t)ev->display.width,
+                                      (uint32_t)ev->display.height);
+    default:
+        return mk_game_event_u32(9, (uint32_t)ev->type);
+    }
+}
+
+/* drain_events yielding GameEvent values. */
+lean_object* allegro_al_drain_game_events(uint64_t queue, uint32_t max) {
+    return drain_events(queue, max, pack_game_event);
+}
+
+/* ── Native filter configuration ── */
+
+lean_object* allegro_al_set_event_queue_drop_type(uint64_t queue, uint32_t type, uint32_t drop) {
+    if (queue == 0 || type >= 64) return io_ok_unit();
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    lock_event_filters();
+    if (drop != 0) {
+        EventFilter *f = get_or_create_event_filter(q);
+        if (f != NULL) f->drop_mask |= ((uint64_t)1 << type);
+    } else {
+        EventFilter *f = find_event_filter(q);
+        if (f != NULL) f->drop_mask &= ~((uint64_t)1 << type);
+    }
+    unlock_event_filters();
+    return io_ok_unit();
+}
+
+lean_object* allegro_al_set_event_queue_coalesce(uint64_t queue, uint32_t flags) {
+    if (queue == 0) return io_ok_unit();
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    lock_event_filters();
+    EventFilter *f = flags != 0 ? get_or_create_event_filter(q) : find_event_filter(q);
+    if (f != NULL) f->coalesce = flags;
+    unlock_event_filters();
+    return io_ok_unit();
+}
+
+lean_object* allegro_al_clear_event_queue_filter(uint64_t queue) {
+    if (queue == 0) return io_ok_unit();
+    ALLEGRO_EVENT_QUEUE *q = (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue);
+    lock_event_filters();
+    EventFilter *f = find_event_filter(q);
+    if (f != NULL && f->has_pending) {
+        /* Keep the entry until the parked event has been fetched. */
+        f->drop_mask = 0;
+        f->coalesce = 0;
+        f->dropped = 0;
+        f->merged = 0;
+    } else {
+        remove_event_filter(q);
+    }
+    unlock_event_filters();
+    return io_ok_unit();
+}
+
+lean_object* allegro_al_get_event_queue_filter_stats(uint64_t queue) {
+    uint64_t dropped = 0, merged = 0;
+    if (queue != 0) {
+        lock_event_filters();
+        EventFilter *f = find_event_filter((ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        if (f != NULL) {
+            dropped = f->dropped;
+            merged = f->merged;
+        }
+        unlock_event_filters();
+    }
+    return io_ok_u64_pair(dropped, merged);
+}
+
 /* ── Event source queries ── */
 
 lean_object* allegro_al_is_event_source_registered(uint64_t queue, uint64_t source) {
@@ -566,10 +1014,10 @@ lean_object* allegro_al_wait_for_event_until_data(uint64_t queue, uint64_t timeo
     memset(&ev, 0, sizeof(ev));
     uint32_t got = 0;
     if (queue != 0 && timeout != 0) {
-        got = al_wait_for_event_until(
-            (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue),
-            &ev,
-            (ALLEGRO_TIMEOUT *)u64_to_ptr(timeout)) ? 1u : 0u;
+        FilterScope s;
+        filter_begin(&s, (ALLEGRO_EVENT_QUEUE *)u64_to_ptr(queue));
+        got = until_filtered(&s, &ev, (ALLEGRO_TIMEOUT *)u64_to_ptr(timeout)) ? 1u : 0u;
+        filter_end(&s, NULL);
     }
     lean_object* data = pack_event_data(&ev);
     lean_object* pair = mk_pair(lean_box_uint32(got), data);
@@ -1,6 +1,7 @@
 #pragma once
 #define ALLEGRO_UNSTABLE
 #include <lean/lean.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -44,10 +45,15 @@ static inline lean_object* io_ok_u32_pair(uint32_t a, uint32_t b) {
     return lean_io_result_mk_ok(mk_pair(lean_box_uint32(a), lean_box_uint32(b)));
 }
 
+/* A UInt32 triple: (UInt32 × UInt32 × UInt32) */
+static inline lean_object* mk_u32_triple(uint32_t a, uint32_t b, uint32_t c) {
+    lean_object* inner = mk_pair(lean_box_uint32(b), lean_box_uint32(c));
+    return mk_pair(lean_box_uint32(a), inner);
+}
+
 /* IO-ok a UInt32 triple: (UInt32 × UInt32 × UInt32) */
 static inline lean_object* io_ok_u32_triple(uint32_t a, uint32_t b, uint32_t c) {
-    lean_object* inner = mk_pair(lean_box_uint32(b), lean_box_uint32(c));
-    return lean_io_result_mk_ok(mk_pair(lean_box_uint32(a), inner));
+    return lean_io_result_mk_ok(mk_u32_triple(a, b, c));
 }
 
 /* IO-ok a UInt32 quad: (UInt32 × UInt32 × UInt32 × UInt32) */
@@ -57,22 +63,86 @@ static inline lean_object* io_ok_u32_quad(uint32_t a, uint32_t b, uint32_t c, ui
     return lean_io_result_mk_ok(mk_pair(lean_box_uint32(a), d2));
 }
 
+/* IO-ok a UInt64 pair: (UInt64 × UInt64) */
+static inline lean_object* io_ok_u64_pair(uint64_t a, uint64_t b) {
+    return lean_io_result_mk_ok(mk_pair(lean_box_uint64(a), lean_box_uint64(b)));
+}
+
 /* IO-ok a Float pair: (Float × Float) */
 static inline lean_object* io_ok_f64_pair(double a, double b) {
     return lean_io_result_mk_ok(mk_pair(lean_box_float(a), lean_box_float(b)));
 }
 
+/* A Float triple: (Float × Float × Float) */
+static inline lean_object* mk_f64_triple(double a, double b, double c) {
+    lean_object* inner = mk_pair(lean_box_float(b), lean_box_float(c));
+    return mk_pair(lean_box_float(a), inner);
+}
+
 /* IO-ok a Float triple: (Float × Float × Float) */
 static inline lean_object* io_ok_f64_triple(double a, double b, double c) {
-    lean_object* inner = mk_pair(lean_box_float(b), lean_box_float(c));
-    return lean_io_result_mk_ok(mk_pair(lean_box_float(a), inner));
+    return lean_io_result_mk_ok(mk_f64_triple(a, b, c));
 }
 
-/* IO-ok a Float quad: (Float × Float × Float × Float) */
-static inline lean_object* io_ok_f64_quad(double a, double b, double c, double d) {
+/* A Float quad: (Float × Float × Float × Float) */
+static inline lean_object* mk_f64_quad(double a, double b, double c, double d) {
     lean_object* d3 = mk_pair(lean_box_float(c), lean_box_float(d));
     lean_object* d2 = mk_pair(lean_box_float(b), d3);
-    return lean_io_result_mk_ok(mk_pair(lean_box_float(a), d2));
+    return mk_pair(lean_box_float(a), d2);
+}
+
+/* IO-ok a Float quad: (Float × Float × Float × Float) */
+static inline lean_object* io_ok_f64_quad(double a, double b, double c, double d) {
+    return lean_io_result_mk_ok(mk_f64_quad(a, b, c, d));
+}
+
+/* ── Scalar-packed records ──
+   All-scalar Lean structures compile to ctor 0 with no object fields, so
+   each result is one allocation instead of a mk_pair chain. Offsets must
+   match the layouts documented next to the Lean structures
+   (Color / ColorF / Rect in Allegro.Core.System). */
+
+/* Color / Rect / MonitorInfo: four 4-byte fields at 0, 4, 8, 12. */
+static inline lean_object* mk_u32x4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    lean_object* obj = lean_alloc_ctor(0, 0, 16);
+    lean_ctor_set_uint32(obj,  0, a);
+    lean_ctor_set_uint32(obj,  4, b);
+    lean_ctor_set_uint32(obj,  8, c);
+    lean_ctor_set_uint32(obj, 12, d);
+    return obj;
+}
+
+static inline lean_object* io_ok_color(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+    return lean_io_result_mk_ok(mk_u32x4(r, g, b, a));
+}
+
+static inline lean_object* io_ok_rect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    return lean_io_result_mk_ok(
+        mk_u32x4((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h));
+}
+
+/* ColorF: four Float fields at 0, 8, 16, 24. */
+static inline lean_object* io_ok_color_f(double r, double g, double b, double a) {
+    lean_object* obj = lean_alloc_ctor(0, 0, 32);
+    lean_ctor_set_float(obj,  0, r);
+    lean_ctor_set_float(obj,  8, g);
+    lean_ctor_set_float(obj, 16, b);
+    lean_ctor_set_float(obj, 24, a);
+    return lean_io_result_mk_ok(obj);
+}
+
+/* BlenderState (Allegro.Core.Blending): six UInt32 fields
+   op@0 src@4 dst@8 alphaOp@12 alphaSrc@16 alphaDst@20. */
+static inline lean_object* io_ok_blender_state(int op, int src, int dst,
+                                               int aop, int asrc, int adst) {
+    lean_object* obj = lean_alloc_ctor(0, 0, 24);
+    lean_ctor_set_uint32(obj,  0, (uint32_t)op);
+    lean_ctor_set_uint32(obj,  4, (uint32_t)src);
+    lean_ctor_set_uint32(obj,  8, (uint32_t)dst);
+    lean_ctor_set_uint32(obj, 12, (uint32_t)aop);
+    lean_ctor_set_uint32(obj, 16, (uint32_t)asrc);
+    lean_ctor_set_uint32(obj, 20, (uint32_t)adst);
+    return lean_io_result_mk_ok(obj);
 }
 
 /* ── EventData constructor ──
@@ -126,3 +196,30 @@ static inline lean_object* mk_event_data(
     lean_ctor_set_uint32(obj, 76, (uint32_t)i);
     return obj;
 }
+
+/* ── Event filter registry (allegro_event.c) ──
+   Creates the mutex guarding the per-queue filters; allegro_al_init calls
+   it once al_init has succeeded. */
+void allegro_event_filters_init(void);
+
+/* ── Pixel kernels (allegro_pixels.c) ──
+   Format conversion and solid fill on raw (pointer, pitch) rectangles, used
+   by the ByteArray entry points and by the locked-region paths in
+   allegro_bitmap.c. Supported formats: ARGB_8888, RGBA_8888, ABGR_8888,
+   RGB_565, ABGR_F32. `rgba` is a packed colour r | g<<8 | b<<16 | a<<24. */
+
+/* Bytes per pixel for a supported format, 0 otherwise. */
+int allegro_px_size(uint32_t format);
+
+void allegro_px_convert_rect(const uint8_t *src, ptrdiff_t src_pitch, uint32_t src_fmt,
+                             uint8_t *dst, ptrdiff_t dst_pitch, uint32_t dst_fmt,
+                             uint32_t w, uint32_t h);
+
+void allegro_px_fill_rect(uint8_t *dst, ptrdiff_t pitch, uint32_t fmt,
+                          uint32_t w, uint32_t h, uint32_t rgba);
+
+/* ── Glyph runs (allegro_font.c / allegro_primitives.c) ──
+   Bytes per record written by allegro_shape_glyph_run and read by
+   allegro_draw_glyph_run: u64 page, then f32 sx sy sw sh dx dy. Must match
+   the record size documented on GlyphRun in GlyphRun.lean. */
+#define GLYPH_RUN_RECORD 32
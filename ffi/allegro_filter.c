@@ -0,0 +1,693 @@
+#include "allegro_ffi.h"
+#include <string.h>
+#include <math.h>
+#include <allegro5/allegro.h>
+
+/* ── Image filters on locked memory bitmaps ──
+   A filter job locks a memory bitmap, then runs one or more passes; each
+   pass is split into row bands that Allegro.Filter hands to Lean tasks.
+   allegro_filter_run touches only the job's buffers (no Allegro calls), so
+   bands of the same pass may run concurrently; passes run in order.
+
+   Parameters arrive as a packed buffer from Filter.encode: a u32 opcode
+   followed by little-endian fields. Opcode numbers must match Filter.lean.
+
+   Pixels are processed as four float lanes in memory byte order (one SSE
+   register per pixel); `ch` maps r, g, b, a to byte positions so the same
+   loops serve ARGB_8888, RGBA_8888 and ABGR_8888 bitmaps without a format
+   conversion. Other formats are locked as ABGR_8888 and converted by
+   Allegro.
+
+   Resampling (allegro_resample_begin) uses the same job and pass
+   machinery with a source bitmap locked read-only next to the
+   destination: pass 0 filters source rows horizontally into a float
+   buffer, pass 1 filters that buffer vertically into the destination. */
+
+enum {
+    FX_BOX_BLUR = 1,
+    FX_GAUSSIAN_BLUR = 2,
+    FX_CONVOLVE_3X3 = 3,
+    FX_COLOR_MATRIX = 4,
+    FX_PREMULTIPLY = 5,
+    FX_UNPREMULTIPLY = 6,
+    FX_RESAMPLE = 7
+};
+
+/* Resampling kernels (must match ResampleFilter in Filter.lean). */
+enum {
+    FX_KERNEL_BOX = 0,
+    FX_KERNEL_BILINEAR = 1,
+    FX_KERNEL_LANCZOS3 = 2
+};
+
+/* Entries in the linear → 8-bit encode table. */
+#define FX_ENC_SIZE 16384
+
+#define FX_MAX_RADIUS 256
+
+/* ── Four-lane float helpers ── */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+typedef __m128 fx4;
+
+static inline fx4 fx_set1(float f) { return _mm_set1_ps(f); }
+static inline fx4 fx_add(fx4 a, fx4 b) { return _mm_add_ps(a, b); }
+static inline fx4 fx_sub(fx4 a, fx4 b) { return _mm_sub_ps(a, b); }
+static inline fx4 fx_mul(fx4 a, fx4 b) { return _mm_mul_ps(a, b); }
+static inline fx4 fx_loadf(const float *p) { return _mm_loadu_ps(p); }
+static inline void fx_storef(float *p, fx4 v) { _mm_storeu_ps(p, v); }
+static inline float fx_lane(fx4 v, int i) { float f[4]; _mm_storeu_ps(f, v); return f[i]; }
+
+static inline fx4 fx_load(const uint8_t *p) {
+    int32_t v;
+    memcpy(&v, p, 4);
+    const __m128i z = _mm_setzero_si128();
+    __m128i x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), z), z);
+    return _mm_cvtepi32_ps(x);
+}
+
+static inline void fx_store(uint8_t *p, fx4 v) {
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    __m128i x = _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f)));
+    x = _mm_packs_epi32(x, x);
+    x = _mm_packus_epi16(x, x);
+    int32_t out = _mm_cvtsi128_si32(x);
+    memcpy(p, &out, 4);
+}
+
+/* Lanes of `mask` that are all-ones take `a`, the rest `b`. */
+static inline fx4 fx_select(fx4 mask, fx4 a, fx4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline fx4 fx_lane_mask(int i) {
+    int32_t m[4] = {0, 0, 0, 0};
+    m[i] = -1;
+    return _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)m));
+}
+
+#else
+
+typedef struct { float v[4]; } fx4;
+
+static inline fx4 fx_set1(float f) { fx4 r = {{f, f, f, f}}; return r; }
+static inline fx4 fx_add(fx4 a, fx4 b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+static inline fx4 fx_sub(fx4 a, fx4 b) { for (int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+static inline fx4 fx_mul(fx4 a, fx4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+static inline fx4 fx_loadf(const float *p) { fx4 r; memcpy(r.v, p, 16); return r; }
+static inline void fx_storef(float *p, fx4 v) { memcpy(p, v.v, 16); }
+static inline float fx_lane(fx4 v, int i) { return v.v[i]; }
+
+static inline fx4 fx_load(const uint8_t *p) {
+    fx4 r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+
+static inline void fx_store(uint8_t *p, fx4 v) {
+    for (int i = 0; i < 4; i++) {
+        float f = v.v[i] > 0.0f ? (v.v[i] < 255.0f ? v.v[i] : 255.0f) : 0.0f;
+        p[i] = (uint8_t)(f + 0.5f);
+    }
+}
+
+static inline fx4 fx_select(fx4 mask, fx4 a, fx4 b) {
+    for (int i = 0; i < 4; i++) if (mask.v[i] == 0.0f) a.v[i] = b.v[i];
+    return a;
+}
+
+static inline fx4 fx_lane_mask(int i) {
+    fx4 r = {{0, 0, 0, 0}};
+    r.v[i] = 1.0f;
+    return r;
+}
+
+#endif
+
+static inline fx4 fx_madd(fx4 acc, fx4 v, fx4 w) { return fx_add(acc, fx_mul(v, w)); }
+
+/* ── Job ── */
+
+/* Per-output-coordinate filter taps along one axis: output i reads
+   count[i] consecutive inputs from start[i] with weights w[i * stride ..]. */
+typedef struct {
+    int *start;
+    int *count;
+    float *w;
+    int stride;
+} fx_taps;
+
+typedef struct {
+    ALLEGRO_BITMAP *bmp;
+    uint8_t *data;          /* locked pixels, row 0 */
+    ptrdiff_t pitch;
+    uint32_t w, h;
+    int op;
+    int passes;
+    int ch[4];              /* byte position of r, g, b, a */
+    uint8_t *tmp;           /* w * h * 4 intermediate for two-pass filters */
+    int radius;
+    float *weights;         /* gaussian: 2 * radius + 1 taps */
+    float k[9];
+    float bias;
+    fx4 mcol[5];            /* colour matrix columns in memory order (last = offset) */
+    /* resample: source locked alongside the destination (bmp / data) */
+    ALLEGRO_BITMAP *src_bmp;
+    const uint8_t *src;
+    ptrdiff_t src_pitch;
+    uint32_t sw, sh;
+    fx_taps xt, yt;
+    float *ftmp;            /* sh * w * 4 linear, premultiplied */
+    float lin[4][256];      /* byte → linear 0–1, per memory lane */
+    uint8_t *enc;           /* FX_ENC_SIZE entries: linear 0–1 → byte */
+    int failed;             /* set (atomically) when a band lacks scratch memory */
+} fx_job;
+
+static inline uint8_t *fx_row(const fx_job *j, uint32_t y) {
+    return j->data + (ptrdiff_t)y * j->pitch;
+}
+
+static inline uint8_t *fx_tmp_row(const fx_job *j, uint32_t y) {
+    return j->tmp + (size_t)y * j->w * 4;
+}
+
+static inline int fx_clamp(int v, int hi) {
+    return v < 0 ? 0 : (v > hi ? hi : v);
+}
+
+static inline float fx_f32(const uint8_t *p) {
+    float f;
+    memcpy(&f, p, 4);
+    return f;
+}
+
+static inline uint32_t fx_u32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/* Parse the packed parameters into `j`; 0 if malformed. */
+static int fx_parse(fx_job *j, const uint8_t *p, size_t n) {
+    if (n < 4) return 0;
+    j->op = (int)fx_u32(p);
+    p += 4; n -= 4;
+    switch (j->op) {
+    case FX_BOX_BLUR:
+        if (n < 4) return 0;
+        j->radius = (int)(fx_u32(p) > FX_MAX_RADIUS ? FX_MAX_RADIUS : fx_u32(p));
+        j->passes = j->radius > 0 ? 2 : 0;
+        return 1;
+    case FX_GAUSSIAN_BLUR: {
+        if (n < 4) return 0;
+        float sigma = fx_f32(p);
+        if (!(sigma > 0.0f)) { j->passes = 0; return 1; }
+        /* Cap in float: converting an out-of-range float to int is undefined.
+           NaN and non-positive sigma were rejected above. */
+        j->radius = (int)ceilf(fminf(3.0f * sigma, (float)FX_MAX_RADIUS));
+        j->weights = (float *)malloc(sizeof(float) * (size_t)(2 * j->radius + 1));
+        if (!j->weights) return 0;
+        float sum = 0.0f;
+        for (int i = -j->radius; i <= j->radius; i++) {
+            float wgt = expf(-(float)(i * i) / (2.0f * sigma * sigma));
+            j->weights[i + j->radius] = wgt;
+            sum += wgt;
+        }
+        for (int i = 0; i <= 2 * j->radius; i++) j->weights[i] /= sum;
+        j->passes = 2;
+        return 1;
+    }
+    case FX_CONVOLVE_3X3:
+        if (n < 40) return 0;
+        for (int i = 0; i < 9; i++) j->k[i] = fx_f32(p + 4 * i);
+        j->bias = fx_f32(p + 36) * 255.0f;
+        j->passes = 2;
+        return 1;
+    case FX_COLOR_MATRIX: {
+        if (n < 80) return 0;
+        /* Row-major 4 × 5 over (r, g, b, a, 1); offsets in 0–1 units. */
+        float cols[5][4];
+        for (int row = 0; row < 4; row++)
+            for (int col = 0; col < 5; col++) {
+                float v = fx_f32(p + 4 * (row * 5 + col));
+                if (col == 4) {
+                    cols[4][j->ch[row]] = v * 255.0f;
+                } else {
+                    cols[j->ch[col]][j->ch[row]] = v;
+                }
+            }
+        /* Columns are indexed by input byte position. */
+        for (int c = 0; c < 5; c++) j->mcol[c] = fx_loadf(cols[c]);
+        j->passes = 1;
+        return 1;
+    }
+    case FX_PREMULTIPLY:
+    case FX_UNPREMULTIPLY:
+        j->passes = 1;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void fx_taps_free(fx_taps *t) {
+    free(t->start);
+    free(t->count);
+    free(t->w);
+}
+
+static void fx_job_free(fx_job *j) {
+    free(j->weights);
+    free(j->tmp);
+    free(j->ftmp);
+    free(j->enc);
+    fx_taps_free(&j->xt);
+    fx_taps_free(&j->yt);
+    free(j);
+}
+
+/* Memory byte positions of r, g, b, a for an 8888 format; other formats
+   are replaced by ABGR_8888. */
+static int fx_channels(int format, int ch[4]) {
+    switch (format) {
+    case ALLEGRO_PIXEL_FORMAT_ARGB_8888:
+        ch[0] = 2; ch[1] = 1; ch[2] = 0; ch[3] = 3; return format;
+    case ALLEGRO_PIXEL_FORMAT_RGBA_8888:
+        ch[0] = 3; ch[1] = 2; ch[2] = 1; ch[3] = 0; return format;
+    default:
+        ch[0] = 0; ch[1] = 1; ch[2] = 2; ch[3] = 3; return ALLEGRO_PIXEL_FORMAT_ABGR_8888;
+    }
+}
+
+lean_object* allegro_filter_begin(uint64_t bitmap, b_lean_obj_arg params) {
+    ALLEGRO_BITMAP *bmp = (ALLEGRO_BITMAP *)u64_to_ptr(bitmap);
+    if (!bmp || !(al_get_bitmap_flags(bmp) & ALLEGRO_MEMORY_BITMAP) || al_is_bitmap_locked(bmp))
+        return io_ok_uint64(0);
+    int w = al_get_bitmap_width(bmp), h = al_get_bitmap_height(bmp);
+    if (w <= 0 || h <= 0) return io_ok_uint64(0);
+    fx_job *j = (fx_job *)calloc(1, sizeof(fx_job));
+    if (!j) return io_ok_uint64(0);
+    j->bmp = bmp;
+    j->w = (uint32_t)w;
+    j->h = (uint32_t)h;
+
+    int format = fx_channels(al_get_bitmap_format(bmp), j->ch);
+    if (!fx_parse(j, lean_sarray_cptr(params), lean_sarray_size(params))) {
+        fx_job_free(j);
+        return io_ok_uint64(0);
+    }
+    if (j->passes == 2) {
+        j->tmp = (uint8_t *)malloc((size_t)j->w * j->h * 4);
+        if (!j->tmp) { fx_job_free(j); return io_ok_uint64(0); }
+    }
+    ALLEGRO_LOCKED_REGION *lr = al_lock_bitmap(bmp, format, ALLEGRO_LOCK_READWRITE);
+    if (!lr) { fx_job_free(j); return io_ok_uint64(0); }
+    j->data = (uint8_t *)lr->data;
+    j->pitch = lr->pitch;
+    return io_ok_uint64(ptr_to_u64(j));
+}
+
+lean_object* allegro_filter_passes(uint64_t job) {
+    fx_job *j = (fx_job *)u64_to_ptr(job);
+    return io_ok_uint32(j ? (uint32_t)j->passes : 0u);
+}
+
+/* Rows to split into bands for `pass`: destination rows, except the
+   horizontal resampling pass, which runs over source rows. */
+static uint32_t fx_rows(const fx_job *j, uint32_t pass) {
+    return (j->op == FX_RESAMPLE && pass == 0) ? j->sh : j->h;
+}
+
+lean_object* allegro_filter_rows(uint64_t job, uint32_t pass) {
+    fx_job *j = (fx_job *)u64_to_ptr(job);
+    return io_ok_uint32(j && pass < (uint32_t)j->passes ? fx_rows(j, pass) : 0u);
+}
+
+/* ── Resampling ── */
+
+static float fx_kernel_radius(int kernel) {
+    return kernel == FX_KERNEL_LANCZOS3 ? 3.0f : (kernel == FX_KERNEL_BILINEAR ? 1.0f : 0.5f);
+}
+
+static float fx_kernel(int kernel, float x) {
+    switch (kernel) {
+    case FX_KERNEL_BILINEAR:
+        x = fabsf(x);
+        return x < 1.0f ? 1.0f - x : 0.0f;
+    case FX_KERNEL_LANCZOS3: {
+        if (x == 0.0f) return 1.0f;
+        if (x <= -3.0f || x >= 3.0f) return 0.0f;
+        const float pi = 3.14159265358979f;
+        float px = pi * x;
+        return 3.0f * sinf(px) * sinf(px / 3.0f) / (px * px);
+    }
+    default:
+        return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+    }
+}
+
+/* Taps mapping `in` samples to `out`. When shrinking, the kernel is
+   stretched by the scale factor so every input contributes; taps past
+   the edges are folded onto the edge sample. */
+static int fx_make_taps(fx_taps *t, uint32_t in, uint32_t out, int kernel) {
+    float scale = (float)in / (float)out;
+    float fs = scale > 1.0f ? scale : 1.0f;
+    float support = fx_kernel_radius(kernel) * fs;
+    t->stride = 2 * (int)ceilf(support) + 2;
+    t->start = (int *)malloc(sizeof(int) * out);
+    t->count = (int *)malloc(sizeof(int) * out);
+    t->w = (float *)calloc((size_t)out * (size_t)t->stride, sizeof(float));
+    if (!t->start || !t->count || !t->w) return 0;
+    int last = (int)in - 1;
+    for (uint32_t i = 0; i < out; i++) {
+        float center = ((float)i + 0.5f) * scale;
+        int lo = (int)floorf(center - support), hi = (int)ceilf(center + support);
+        if (hi - lo + 1 > t->stride) hi = lo + t->stride - 1;
+        int first = fx_clamp(lo, last), n = fx_clamp(hi, last) - first + 1;
+        float *w = t->w + (size_t)i * (size_t)t->stride;
+        float sum = 0.0f;
+        for (int k = lo; k <= hi; k++) {
+            float wt = fx_kernel(kernel, ((float)k + 0.5f - center) / fs);
+            w[fx_clamp(k, last) - first] += wt;
+            sum += wt;
+        }
+        if (sum == 0.0f) {
+            w[fx_clamp((int)floorf(center), last) - first] = 1.0f;
+            sum = 1.0f;
+        }
+        for (int k = 0; k < n; k++) w[k] /= sum;
+        t->start[i] = first;
+        t->count[i] = n;
+    }
+    return 1;
+}
+
+static float fx_srgb_to_linear(float c) {
+    return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float fx_linear_to_srgb(float c) {
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static int fx_make_tables(fx_job *j, int gamma) {
+    j->enc = (uint8_t *)malloc(FX_ENC_SIZE);
+    if (!j->enc) return 0;
+    for (int v = 0; v < 256; v++) {
+        float c = (float)v / 255.0f;
+        float l = gamma ? fx_srgb_to_linear(c) : c;
+        for (int lane = 0; lane < 4; lane++)
+            j->lin[lane][v] = lane == j->ch[3] ? c : l;
+    }
+    for (int i = 0; i < FX_ENC_SIZE; i++) {
+        float l = (float)i / (float)(FX_ENC_SIZE - 1);
+        float c = gamma ? fx_linear_to_srgb(l) : l;
+        j->enc[i] = (uint8_t)(c * 255.0f + 0.5f);
+    }
+    return 1;
+}
+
+/* Pass 0: source rows → linear premultiplied floats, filtered along x. */
+static int resample_h(const fx_job *j, uint32_t y0, uint32_t y1) {
+    float *line = (float *)malloc((size_t)j->sw * 4 * sizeof(float));
+    if (!line) return 0;
+    int ai = j->ch[3];
+    fx4 amask = fx_lane_mask(ai);
+    for (uint32_t y = y0; y < y1; y++) {
+        const uint8_t *s = j->src + (ptrdiff_t)y * j->src_pitch;
+        for (uint32_t x = 0; x < j->sw; x++) {
+            const uint8_t *p = s + 4 * x;
+            float px[4] = { j->lin[0][p[0]], j->lin[1][p[1]], j->lin[2][p[2]], j->lin[3][p[3]] };
+            fx4 v = fx_loadf(px);
+            fx_storef(line + 4 * x, fx_select(amask, v, fx_mul(v, fx_set1(px[ai]))));
+        }
+        float *d = j->ftmp + (size_t)y * j->w * 4;
+        for (uint32_t x = 0; x < j->w; x++) {
+            const float *in = line + 4 * j->xt.start[x];
+            const float *w = j->xt.w + (size_t)x * (size_t)j->xt.stride;
+            fx4 acc = fx_set1(0.0f);
+            for (int k = 0; k < j->xt.count[x]; k++)
+                acc = fx_madd(acc, fx_loadf(in + 4 * k), fx_set1(w[k]));
+            fx_storef(d + 4 * x, acc);
+        }
+    }
+    free(line);
+    return 1;
+}
+
+/* Pass 1: filter along y, un-premultiply and encode into the destination. */
+static int resample_v(const fx_job *j, uint32_t y0, uint32_t y1) {
+    uint32_t w = j->w;
+    float *acc = (float *)malloc((size_t)w * 4 * sizeof(float));
+    if (!acc) return 0;
+    int ai = j->ch[3];
+    const float scale = (float)(FX_ENC_SIZE - 1);
+    for (uint32_t y = y0; y < y1; y++) {
+        memset(acc, 0, (size_t)w * 4 * sizeof(float));
+        const float *wy = j->yt.w + (size_t)y * (size_t)j->yt.stride;
+        for (int k = 0; k < j->yt.count[y]; k++) {
+            const float *s = j->ftmp + (size_t)(j->yt.start[y] + k) * w * 4;
+            fx4 wk = fx_set1(wy[k]);
+            for (uint32_t x = 0; x < w; x++)
+                fx_storef(acc + 4 * x, fx_madd(fx_loadf(acc + 4 * x), fx_loadf(s + 4 * x), wk));
+        }
+        uint8_t *d = fx_row(j, y);
+        for (uint32_t x = 0; x < w; x++) {
+            float *px = acc + 4 * x;
+            float a = px[ai] > 0.0f ? (px[ai] < 1.0f ? px[ai] : 1.0f) : 0.0f;
+            float inv = a > 0.0f ? 1.0f / a : 0.0f;
+            uint8_t *o = d + 4 * x;
+            for (int lane = 0; lane < 4; lane++) {
+                if (lane == ai) {
+                    o[lane] = (uint8_t)(a * 255.0f + 0.5f);
+                } else {
+                    float c = px[lane] * inv;
+                    c = c > 0.0f ? (c < 1.0f ? c : 1.0f) : 0.0f;
+                    o[lane] = j->enc[(int)(c * scale + 0.5f)];
+                }
+            }
+        }
+    }
+    free(acc);
+    return 1;
+}
+
+/* Lock `src` read-only and the memory bitmap `dst` write-only, both in
+   dst's format, and prepare a two-pass resampling job. */
+lean_object* allegro_resample_begin(uint64_t src, uint64_t dst, uint32_t kernel, uint32_t gamma) {
+    ALLEGRO_BITMAP *sb = (ALLEGRO_BITMAP *)u64_to_ptr(src);
+    ALLEGRO_BITMAP *db = (ALLEGRO_BITMAP *)u64_to_ptr(dst);
+    if (!sb || !db || sb == db || kernel > FX_KERNEL_LANCZOS3) return io_ok_uint64(0);
+    if (!(al_get_bitmap_flags(db) & ALLEGRO_MEMORY_BITMAP) || al_is_bitmap_locked(sb) || al_is_bitmap_locked(db))
+        return io_ok_uint64(0);
+    int sw = al_get_bitmap_width(sb), sh = al_get_bitmap_height(sb);
+    int w = al_get_bitmap_width(db), h = al_get_bitmap_height(db);
+    if (sw <= 0 || sh <= 0 || w <= 0 || h <= 0) return io_ok_uint64(0);
+    fx_job *j = (fx_job *)calloc(1, sizeof(fx_job));
+    if (!j) return io_ok_uint64(0);
+    j->op = FX_RESAMPLE;
+    j->passes = 2;
+    j->w = (uint32_t)w;
+    j->h = (uint32_t)h;
+    j->sw = (uint32_t)sw;
+    j->sh = (uint32_t)sh;
+    int format = fx_channels(al_get_bitmap_format(db), j->ch);
+    j->ftmp = (float *)malloc((size_t)j->sh * j->w * 4 * sizeof(float));
+    if (!j->ftmp || !fx_make_tables(j, gamma != 0)
+        || !fx_make_taps(&j->xt, j->sw, j->w, (int)kernel)
+        || !fx_make_taps(&j->yt, j->sh, j->h, (int)kernel)) {
+        fx_job_free(j);
+        return io_ok_uint64(0);
+    }
+    ALLEGRO_LOCKED_REGION *slr = al_lock_bitmap(sb, format, ALLEGRO_LOCK_READONLY);
+    if (!slr) { fx_job_free(j); return io_ok_uint64(0); }
+    ALLEGRO_LOCKED_REGION *dlr = al_lock_bitmap(db, format, ALLEGRO_LOCK_WRITEONLY);
+    if (!dlr) { al_unlock_bitmap(sb); fx_job_free(j); return io_ok_uint64(0); }
+    j->src_bmp = sb;
+    j->src = (const uint8_t *)slr->data;
+    j->src_pitch = slr->pitch;
+    j->bmp = db;
+    j->data = (uint8_t *)dlr->data;
+    j->pitch = dlr->pitch;
+    return io_ok_uint64(ptr_to_u64(j));
+}
+
+/* ── Box blur: O(1) per pixel with running sums ── */
+
+static void box_h(const fx_job *j, uint32_t y0, uint32_t y1) {
+    int r = j->radius, last = (int)j->w - 1;
+    fx4 inv = fx_set1(1.0f / (float)(2 * r + 1));
+    for (uint32_t y = y0; y < y1; y++) {
+        const uint8_t *s = fx_row(j, y);
+        uint8_t *d = fx_tmp_row(j, y);
+        fx4 acc = fx_set1(0.0f);
+        for (int k = -r; k <= r; k++) acc = fx_add(acc, fx_load(s + 4 * fx_clamp(k, last)));
+        for (int x = 0; x <= last; x++) {
+            fx_store(d + 4 * x, fx_mul(acc, inv));
+            acc = fx_add(acc, fx_load(s + 4 * fx_clamp(x + r + 1, last)));
+            acc = fx_sub(acc, fx_load(s + 4 * fx_clamp(x - r, last)));
+        }
+    }
+}
+
+static int box_v(const fx_job *j, uint32_t y0, uint32_t y1) {
+    int r = j->radius, last = (int)j->h - 1;
+    uint32_t w = j->w;
+    float *acc = (float *)calloc((size_t)w * 4, sizeof(float));
+    if (!acc) return 0;
+    fx4 inv = fx_set1(1.0f / (float)(2 * r + 1));
+    for (int k = (int)y0 - r; k <= (int)y0 + r; k++) {
+        const uint8_t *s = fx_tmp_row(j, (uint32_t)fx_clamp(k, last));
+        for (uint32_t x = 0; x < w; x++)
+            fx_storef(acc + 4 * x, fx_add(fx_loadf(acc + 4 * x), fx_load(s + 4 * x)));
+    }
+    for (uint32_t y = y0; y < y1; y++) {
+        uint8_t *d = fx_row(j, y);
+        const uint8_t *in = fx_tmp_row(j, (uint32_t)fx_clamp((int)y + r + 1, last));
+        const uint8_t *out = fx_tmp_row(j, (uint32_t)fx_clamp((int)y - r, last));
+        for (uint32_t x = 0; x < w; x++) {
+            fx4 a = fx_loadf(acc + 4 * x);
+            fx_store(d + 4 * x, fx_mul(a, inv));
+            fx_storef(acc + 4 * x, fx_sub(fx_add(a, fx_load(in + 4 * x)), fx_load(out + 4 * x)));
+        }
+    }
+    free(acc);
+    return 1;
+}
+
+/* ── Gaussian blur: separable, float accumulation per row ── */
+
+static void gauss_h(const fx_job *j, uint32_t y0, uint32_t y1) {
+    int r = j->radius, last = (int)j->w - 1;
+    for (uint32_t y = y0; y < y1; y++) {
+        const uint8_t *s = fx_row(j, y);
+        uint8_t *d = fx_tmp_row(j, y);
+        for (int x = 0; x <= last; x++) {
+            fx4 acc = fx_set1(0.0f);
+            if (x >= r && x + r <= last) {
+                const uint8_t *p = s + 4 * (x - r);
+                for (int k = 0; k <= 2 * r; k++)
+                    acc = fx_madd(acc, fx_load(p + 4 * k), fx_set1(j->weights[k]));
+            } else {
+                for (int k = -r; k <= r; k++)
+                    acc = fx_madd(acc, fx_load(s + 4 * fx_clamp(x + k, last)), fx_set1(j->weights[k + r]));
+            }
+            fx_store(d + 4 * x, acc);
+        }
+    }
+}
+
+static int gauss_v(const fx_job *j, uint32_t y0, uint32_t y1) {
+    int r = j->radius, last = (int)j->h - 1;
+    uint32_t w = j->w;
+    float *acc = (float *)malloc((size_t)w * 4 * sizeof(float));
+    if (!acc) return 0;
+    for (uint32_t y = y0; y < y1; y++) {
+        memset(acc, 0, (size_t)w * 4 * sizeof(float));
+        for (int k = -r; k <= r; k++) {
+            const uint8_t *s = fx_tmp_row(j, (uint32_t)fx_clamp((int)y + k, last));
+            fx4 wk = fx_set1(j->weights[k + r]);
+            for (uint32_t x = 0; x < w; x++)
+                fx_storef(acc + 4 * x, fx_madd(fx_loadf(acc + 4 * x), fx_load(s + 4 * x), wk));
+        }
+        uint8_t *d = fx_row(j, y);
+        for (uint32_t x = 0; x < w; x++) fx_store(d + 4 * x, fx_loadf(acc + 4 * x));
+    }
+    free(acc);
+    return 1;
+}
+
+/* ── 3×3 convolution (alpha preserved) ── */
+
+static void copy_to_tmp(const fx_job *j, uint32_t y0, uint32_t y1) {
+    for (uint32_t y = y0; y < y1; y++)
+        memcpy(fx_tmp_row(j, y), fx_row(j, y), (size_t)j->w * 4);
+}
+
+static void convolve3(const fx_job *j, uint32_t y0, uint32_t y1) {
+    int lastx = (int)j->w - 1, lasty = (int)j->h - 1;
+    fx4 amask = fx_lane_mask(j->ch[3]);
+    fx4 bias = fx_set1(j->bias);
+    fx4 k[9];
+    for (int i = 0; i < 9; i++) k[i] = fx_set1(j->k[i]);
+    for (uint32_t y = y0; y < y1; y++) {
+        const uint8_t *rows[3];
+        for (int dy = -1; dy <= 1; dy++)
+            rows[dy + 1] = fx_tmp_row(j, (uint32_t)fx_clamp((int)y + dy, lasty));
+        uint8_t *d = fx_row(j, y);
+        for (int x = 0; x <= lastx; x++) {
+            int xs[3] = { fx_clamp(x - 1, lastx), x, fx_clamp(x + 1, lastx) };
+            fx4 acc = bias;
+            for (int dy = 0; dy < 3; dy++)
+                for (int dx = 0; dx < 3; dx++)
+                    acc = fx_madd(acc, fx_load(rows[dy] + 4 * xs[dx]), k[dy * 3 + dx]);
+            fx_store(d + 4 * x, fx_select(amask, fx_load(rows[1] + 4 * x), acc));
+        }
+    }
+}
+
+/* ── Per-pixel filters (in place) ── */
+
+static void color_matrix(const fx_job *j, uint32_t y0, uint32_t y1) {
+    for (uint32_t y = y0; y < y1; y++) {
+        uint8_t *d = fx_row(j, y);
+        for (uint32_t x = 0; x < j->w; x++) {
+            fx4 v = fx_load(d + 4 * x);
+            fx4 acc = j->mcol[4];
+            acc = fx_madd(acc, fx_set1(fx_lane(v, 0)), j->mcol[0]);
+            acc = fx_madd(acc, fx_set1(fx_lane(v, 1)), j->mcol[1]);
+            acc = fx_madd(acc, fx_set1(fx_lane(v, 2)), j->mcol[2]);
+            acc = fx_madd(acc, fx_set1(fx_lane(v, 3)), j->mcol[3]);
+            fx_store(d + 4 * x, acc);
+        }
+    }
+}
+
+static void premultiply(const fx_job *j, uint32_t y0, uint32_t y1, int inverse) {
+    int ai = j->ch[3];
+    fx4 amask = fx_lane_mask(ai);
+    for (uint32_t y = y0; y < y1; y++) {
+        uint8_t *d = fx_row(j, y);
+        for (uint32_t x = 0; x < j->w; x++) {
+            uint8_t *p = d + 4 * x;
+            uint8_t a = p[ai];
+            if (a == 255) continue;
+            if (inverse && a == 0) continue;
+            float s = inverse ? 255.0f / (float)a : (float)a / 255.0f;
+            fx4 v = fx_load(p);
+            fx_store(p, fx_select(amask, v, fx_mul(v, fx_set1(s))));
+        }
+    }
+}
+
+lean_object* allegro_filter_run(uint64_t job, uint32_t pass, uint32_t y0, uint32_t y1) {
+    fx_job *j = (fx_job *)u64_to_ptr(job);
+    if (!j || pass >= (uint32_t)j->passes) return io_ok_unit();
+    if (y1 > fx_rows(j, pass)) y1 = fx_rows(j, pass);
+    if (y0 >= y1) return io_ok_unit();
+    int ok = 1;
+    switch (j->op) {
+    case FX_BOX_BLUR:      if (pass == 0) box_h(j, y0, y1); else ok = box_v(j, y0, y1); break;
+    case FX_GAUSSIAN_BLUR: if (pass == 0) gauss_h(j, y0, y1); else ok = gauss_v(j, y0, y1); break;
+    case FX_CONVOLVE_3X3:  if (pass == 0) copy_to_tmp(j, y0, y1); else convolve3(j, y0, y1); break;
+    case FX_COLOR_MATRIX:  color_matrix(j, y0, y1); break;
+    case FX_PREMULTIPLY:   premultiply(j, y0, y1, 0); break;
+    case FX_UNPREMULTIPLY: premultiply(j, y0, y1, 1); break;
+    case FX_RESAMPLE:      ok = pass == 0 ? resample_h(j, y0, y1) : resample_v(j, y0, y1); break;
+    }
+    /* Bands run concurrently; a band that could not allocate its scratch row
+       left its rows unwritten, so the whole job is reported as failed. */
+    if (!ok) __atomic_store_n(&j->failed, 1, __ATOMIC_RELAXED);
+    return io_ok_unit();
+}
+
+lean_object* allegro_filter_end(uint64_t job) {
+    fx_job *j = (fx_job *)u64_to_ptr(job);
+    if (!j) return io_ok_uint32(0);
+    int failed = __atomic_load_n(&j->failed, __ATOMIC_RELAXED);
+    al_unlock_bitmap(j->bmp);
+    if (j->src_bmp) al_unlock_bitmap(j->src_bmp);
+    fx_job_free(j);
+    return io_ok_uint32(failed ? 0 : 1);
+}
@@ -202,28 +202,28 @@ lean_object* allegro_al_get_fallback_font(uint64_t font) {
 /* ── Tuple-returning queries ── */
 
 lean_object* allegro_al_get_text_dimensions(uint64_t font, b_lean_obj_arg textObj) {
-    if (font == 0) return io_ok_u32_quad(0, 0, 0, 0);
+    if (font == 0) return io_ok_rect(0, 0, 0, 0);
     int x, y, w, h;
     al_get_text_dimensions((ALLEGRO_FONT *)u64_to_ptr(font), lean_string_cstr(textObj), &x, &y, &w, &h);
-    return io_ok_u32_quad((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h);
+    return io_ok_rect(x, y, w, h);
 }
 
 /* ── Additional font functions ── */
 
 lean_object* allegro_al_get_ustr_dimensions(uint64_t font, uint64_t ustr) {
-    if (font == 0 || ustr == 0) return io_ok_u32_quad(0, 0, 0, 0);
+    if (font == 0 || ustr == 0) return io_ok_rect(0, 0, 0, 0);
     int x, y, w, h;
     al_get_ustr_dimensions((ALLEGRO_FONT *)u64_to_ptr(font),
                            (ALLEGRO_USTR *)u64_to_ptr(ustr), &x, &y, &w, &h);
-    return io_ok_u32_quad((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h);
+    return io_ok_rect(x, y, w, h);
 }
 
 lean_object* allegro_al_get_glyph_dimensions(uint64_t font, int32_t codepoint) {
-    if (font == 0) return io_ok_u32_quad(0, 0, 0, 0);
+    if (font == 0) return io_ok_rect(0, 0, 0, 0);
     int x, y, w, h;
     bool ok = al_get_glyph_dimensions((ALLEGRO_FONT *)u64_to_ptr(font), codepoint, &x, &y, &w, &h);
-    if (!ok) return io_ok_u32_quad(0, 0, 0, 0);
-    return io_ok_u32_quad((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h);
+    if (!ok) return io_ok_rect(0, 0, 0, 0);
+    return io_ok_rect(x, y, w, h);
 }
 
 lean_object* allegro_al_draw_justified_ustr_rgb(
@@ -282,32 +282,31 @@ lean_object* allegro_al_get_allegro_font_version(void) {
 
 /* ── Glyph info (UNSTABLE) ── */
 
+/* GlyphInfo layout (0 object fields, 40-byte scalar area):
+     bitmap@0 (UInt64), x@8 y@12 w@16 h@20 kerning@24
+     offsetX@28 offsetY@32 advance@36 (Int32) */
+static lean_object* mk_glyph_info(const ALLEGRO_GLYPH *g) {
+    lean_object* obj = lean_alloc_ctor(0, 0, 40);
+    lean_ctor_set_uint64(obj,  0, ptr_to_u64(g->bitmap));
+    lean_ctor_set_uint32(obj,  8, (uint32_t)g->x);
+    lean_ctor_set_uint32(obj, 12, (uint32_t)g->y);
+    lean_ctor_set_uint32(obj, 16, (uint32_t)g->w);
+    lean_ctor_set_uint32(obj, 20, (uint32_t)g->h);
+    lean_ctor_set_uint32(obj, 24, (uint32_t)g->kerning);
+    lean_ctor_set_uint32(obj, 28, (uint32_t)g->offset_x);
+    lean_ctor_set_uint32(obj, 32, (uint32_t)g->offset_y);
+    lean_ctor_set_uint32(obj, 36, (uint32_t)g->advance);
+    return obj;
+}
+
 lean_object* allegro_al_get_glyph(uint64_t font, uint32_t codepoint) {
-    if (font == 0) {
-        /* Return (bitmap=0, x=0, y=0, w=0, h=0, kerning=0, offset_x=0, offset_y=0, advance=0) */
-        lean_object* t8 = mk_pair(lean_box_uint32(0), lean_box_uint32(0));
-        lean_object* t7 = mk_pair(lean_box_uint32(0), t8);
-        lean_object* t6 = mk_pair(lean_box_uint32(0), t7);
-        lean_object* t5 = mk_pair(lean_box_uint32(0), t6);
-        lean_object* t4 = mk_pair(lean_box_uint32(0), t5);
-        lean_object* t3 = mk_pair(lean_box_uint32(0), t4);
-        lean_object* t2 = mk_pair(lean_box_uint32(0), t3);
-        return lean_io_result_mk_ok(mk_pair(lean_box_uint64(0), t2));
-    }
     ALLEGRO_GLYPH glyph;
     memset(&glyph, 0, sizeof(glyph));
-    bool ok = al_get_glyph((ALLEGRO_FONT *)u64_to_ptr(font), 0, (int)codepoint, &glyph);
-    if (!ok) memset(&glyph, 0, sizeof(glyph));
-    lean_object* t8 = mk_pair(lean_box_uint32((uint32_t)glyph.offset_y),
-                               lean_box_uint32((uint32_t)glyph.advance));
-    lean_object* t7 = mk_pair(lean_box_uint32((uint32_t)glyph.offset_x), t8);
-    lean_object* t6 = mk_pair(lean_box_uint32((uint32_t)glyph.kerning), t7);
-    lean_object* t5 = mk_pair(lean_box_uint32((uint32_t)glyph.h), t6);
-    lean_object* t4 = mk_pair(lean_box_uint32((uint32_t)glyph.w), t5);
-    lean_object* t3 = mk_pair(lean_box_uint32((uint32_t)glyph.y), t4);
-    lean_object* t2 = mk_pair(lean_box_uint32((uint32_t)glyph.x), t3);
-    return lean_io_result_mk_ok(
-        mk_pair(lean_box_uint64(ptr_to_u64(glyph.bitmap)), t2));
+    if (font != 0) {
+        bool ok = al_get_glyph((ALLEGRO_FONT *)u64_to_ptr(font), 0, (int)codepoint, &glyph);
+        if (!ok) memset(&glyph, 0, sizeof(glyph));
+    }
+    return lean_io_result_mk_ok(mk_glyph_info(&glyph));
 }
 
 /* ── Callback-collecting multiline text ── */
@@ -375,3 +374,68 @@ lean_object* allegro_al_do_multiline_ustr(uint64_t font, double maxWidth, uint64
     free(data.lines);
     return lean_io_result_mk_ok(arr);
 }
+
+/* ── Glyph runs ──
+   Shapes a string once into 32-byte records (see GlyphRun in
+   GlyphRun.lean): u64 glyph page, f32 sx sy sw sh (region within the
+   page), f32 dx dy (offset from the draw origin). The pen moves by
+   al_get_glyph_advance between consecutive codepoints, which includes
+   kerning, and glyphs are placed at pen + offset as al_get_glyph
+   documents. Glyphs without an image (spaces) only advance the pen.
+   Records are grouped by page, keeping string order within a page, so
+   drawing needs one al_draw_prim per page. Returns (records, advance). */
+
+typedef struct {
+    ALLEGRO_BITMAP *page;
+    float sx, sy, sw, sh, dx, dy;
+} glyph_run_quad;
+
+lean_object* allegro_shape_glyph_run(uint64_t font, b_lean_obj_arg textObj) {
+    ALLEGRO_FONT *f = (ALLEGRO_FONT *)u64_to_ptr(font);
+    size_t len = lean_string_size(textObj) - 1;
+    glyph_run_quad *quads = (f && len) ? (glyph_run_quad *)malloc(len * sizeof(glyph_run_quad)) : NULL;
+    size_t count = 0;
+    int pen = 0;
+    if (quads) {
+        ALLEGRO_USTR_INFO info;
+        const ALLEGRO_USTR *us = al_ref_buffer(&info, lean_string_cstr(textObj), len);
+        int pos = 0;
+        int32_t prev = ALLEGRO_NO_KERNING, cp;
+        while ((cp = al_ustr_get_next(us, &pos)) != -1) {
+            if (cp < 0) continue;   /* invalid UTF-8 byte */
+            if (prev != ALLEGRO_NO_KERNING) pen += al_get_glyph_advance(f, prev, cp);
+            ALLEGRO_GLYPH g;
+            if (al_get_glyph(f, 0, cp, &g) && g.bitmap && g.w > 0 && g.h > 0) {
+                glyph_run_quad *q = &quads[count++];
+                q->page = g.bitmap;
+                q->sx = (float)g.x;
+                q->sy = (float)g.y;
+                q->sw = (float)g.w;
+                q->sh = (float)g.h;
+                q->dx = (float)(pen + g.offset_x);
+                q->dy = (float)g.offset_y;
+            }
+            prev = cp;
+        }
+        if (prev != ALLEGRO_NO_KERNING) pen += al_get_glyph_advance(f, prev, ALLEGRO_NO_KERNING);
+    }
+
+    size_t bytes = count * GLYPH_RUN_RECORD;
+    lean_object *out = lean_alloc_sarray(1, bytes, bytes);
+    uint8_t *p = lean_sarray_cptr(out);
+    /* Group by page in order of first use; runs touch few pages. */
+    for (size_t i = 0; i < count; i++) {
+        ALLEGRO_BITMAP *page = quads[i].page;
+        if (!page) continue;
+        for (size_t j = i; j < count; j++) {
+            if (quads[j].page != page) continue;
+            uint64_t h = ptr_to_u64(page);
+            memcpy(p, &h, 8);
+            memcpy(p + 8, &quads[j].sx, 24);
+            p += GLYPH_RUN_RECORD;
+            quads[j].page = NULL;
+        }
+    }
+    free(quads);
+    return lean_io_result_mk_ok(mk_pair(out, lean_box_float((double)pen)));
+}
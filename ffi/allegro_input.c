@@ -81,6 +81,13 @@ lean_object* allegro_al_get_keyboard_state(uint64_t state) {
     return io_ok_unit();
 }
 
+/* Mirror used by the `extern c inline` keyDown in Input.lean.  The bitset
+   layout matches Allegro's _AL_KEYBOARD_STATE_KEY_DOWN macro. */
+typedef struct { void *display; unsigned int keys[8]; } InlineKeyboardStateMirror;
+
+_Static_assert(sizeof(ALLEGRO_KEYBOARD_STATE) == sizeof(InlineKeyboardStateMirror), "ALLEGRO_KEYBOARD_STATE size changed");
+_Static_assert(offsetof(ALLEGRO_KEYBOARD_STATE, __key_down__internal__) == offsetof(InlineKeyboardStateMirror, keys), "key bitset moved");
+
 lean_object* allegro_al_key_down(uint64_t state, uint32_t keycode) {
     if (state == 0) {
         return io_ok_uint32(0);
@@ -0,0 +1,407 @@
+#include "allegro_ffi.h"
+#include <allegro5/allegro.h>
+#include <string.h>
+
+/* ── Pixel conversion and fill kernels ──
+   Supported formats: ARGB_8888, RGBA_8888, ABGR_8888, RGB_565 and
+   ABGR_F32. 8888 formats are native-endian 32-bit words; conversions
+   between them are one shift/mask swizzle. Anything involving RGB_565 or
+   ABGR_F32 goes through ABGR_8888 words (r in the low byte, the
+   "canonical" form) in 256-pixel chunks that stay in L1.
+
+   Vector paths: SSE2 (baseline on x86-64) and AVX2, picked at run time via
+   cpuid. Every kernel has a scalar loop that also handles the tail.
+   Results match Allegro's own converters (565 channels widen as
+   v * 255 / 31 and v * 255 / 63, 8-bit → float is v / 255) except that
+   float → 8-bit rounds to nearest and clamps to [0, 1] (NaN → 0). */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  include <immintrin.h>
+#  include <cpuid.h>
+#  define PX_AVX2 1
+#  if defined(__SSE2__)
+#    define PX_SSE2 1
+#  endif
+#endif
+
+#define PX_CHUNK 256
+
+typedef struct { unsigned r, g, b, a; } px_shifts;
+
+static const px_shifts PX_SHIFTS_ARGB = {16, 8, 0, 24};
+static const px_shifts PX_SHIFTS_RGBA = {24, 16, 8, 0};
+static const px_shifts PX_SHIFTS_ABGR = {0, 8, 16, 24};
+
+int allegro_px_size(uint32_t format) {
+    switch (format) {
+        case ALLEGRO_PIXEL_FORMAT_ARGB_8888:
+        case ALLEGRO_PIXEL_FORMAT_RGBA_8888:
+        case ALLEGRO_PIXEL_FORMAT_ABGR_8888: return 4;
+        case ALLEGRO_PIXEL_FORMAT_RGB_565:   return 2;
+        case ALLEGRO_PIXEL_FORMAT_ABGR_F32:  return 16;
+        default: return 0;
+    }
+}
+
+static inline int px_is_8888(uint32_t format) {
+    return allegro_px_size(format) == 4;
+}
+
+static inline px_shifts px_shifts_of(uint32_t format) {
+    switch (format) {
+        case ALLEGRO_PIXEL_FORMAT_ARGB_8888: return PX_SHIFTS_ARGB;
+        case ALLEGRO_PIXEL_FORMAT_RGBA_8888: return PX_SHIFTS_RGBA;
+        default:                             return PX_SHIFTS_ABGR;
+    }
+}
+
+#ifdef PX_AVX2
+/* -1 until detected. Any thread may convert pixels, so the cached result is
+   read and written atomically; detection is idempotent, so a race only
+   repeats it. */
+static int px_avx2_state = -1;
+
+static int px_detect_avx2(void) {
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return 0;
+    if (!(c & bit_OSXSAVE) || !(c & bit_AVX)) return 0;
+    unsigned lo, hi;
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    (void)hi;
+    if ((lo & 6) != 6) return 0;  /* OS saves XMM and YMM state */
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return 0;
+    return (b & bit_AVX2) != 0;
+}
+
+static inline int px_has_avx2(void) {
+    int state = __atomic_load_n(&px_avx2_state, __ATOMIC_RELAXED);
+    if (state < 0) {
+        state = px_detect_avx2();
+        __atomic_store_n(&px_avx2_state, state, __ATOMIC_RELAXED);
+    }
+    return state;
+}
+#endif
+
+/* ── 8888 ↔ 8888 swizzle ── */
+
+static void swizzle_scalar(const uint8_t *src, uint8_t *dst, uint32_t i, uint32_t n,
+                           px_shifts s, px_shifts d) {
+    for (; i < n; i++) {
+        uint32_t p, q;
+        memcpy(&p, src + 4 * (size_t)i, 4);
+        q = ((p >> s.r) & 0xFF) << d.r | ((p >> s.g) & 0xFF) << d.g |
+            ((p >> s.b) & 0xFF) << d.b | ((p >> s.a) & 0xFF) << d.a;
+        memcpy(dst + 4 * (size_t)i, &q, 4);
+    }
+}
+
+#ifdef PX_SSE2
+static uint32_t swizzle_sse2(const uint8_t *src, uint8_t *dst, uint32_t n,
+                             px_shifts s, px_shifts d) {
+    const __m128i m = _mm_set1_epi32(0xFF);
+    const __m128i sr = _mm_cvtsi32_si128((int)s.r), sg = _mm_cvtsi32_si128((int)s.g);
+    const __m128i sb = _mm_cvtsi32_si128((int)s.b), sa = _mm_cvtsi32_si128((int)s.a);
+    const __m128i dr = _mm_cvtsi32_si128((int)d.r), dg = _mm_cvtsi32_si128((int)d.g);
+    const __m128i db = _mm_cvtsi32_si128((int)d.b), da = _mm_cvtsi32_si128((int)d.a);
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i *)(src + 4 * (size_t)i));
+        __m128i q = _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(p, sr), m), dr);
+        q = _mm_or_si128(q, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(p, sg), m), dg));
+        q = _mm_or_si128(q, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(p, sb), m), db));
+        q = _mm_or_si128(q, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(p, sa), m), da));
+        _mm_storeu_si128((__m128i *)(dst + 4 * (size_t)i), q);
+    }
+    return i;
+}
+#endif
+
+#ifdef PX_AVX2
+__attribute__((target("avx2")))
+static uint32_t swizzle_avx2(const uint8_t *src, uint8_t *dst, uint32_t n,
+                             px_shifts s, px_shifts d) {
+    const __m256i m = _mm256_set1_epi32(0xFF);
+    const __m128i sr = _mm_cvtsi32_si128((int)s.r), sg = _mm_cvtsi32_si128((int)s.g);
+    const __m128i sb = _mm_cvtsi32_si128((int)s.b), sa = _mm_cvtsi32_si128((int)s.a);
+    const __m128i dr = _mm_cvtsi32_si128((int)d.r), dg = _mm_cvtsi32_si128((int)d.g);
+    const __m128i db = _mm_cvtsi32_si128((int)d.b), da = _mm_cvtsi32_si128((int)d.a);
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_loadu_si256((const __m256i *)(src + 4 * (size_t)i));
+        __m256i q = _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(p, sr), m), dr);
+        q = _mm256_or_si256(q, _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(p, sg), m), dg));
+        q = _mm256_or_si256(q, _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(p, sb), m), db));
+        q = _mm256_or_si256(q, _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(p, sa), m), da));
+        _mm256_storeu_si256((__m256i *)(dst + 4 * (size_t)i), q);
+    }
+    return i;
+}
+#endif
+
+static void swizzle_row(const uint8_t *src, uint8_t *dst, uint32_t n,
+                        px_shifts s, px_shifts d) {
+    uint32_t i = 0;
+#ifdef PX_AVX2
+    if (px_has_avx2()) i = swizzle_avx2(src, dst, n, s, d);
+#endif
+#ifdef PX_SSE2
+    i += swizzle_sse2(src + 4 * (size_t)i, dst + 4 * (size_t)i, n - i, s, d);
+#endif
+    swizzle_scalar(src, dst, i, n, s, d);
+}
+
+/* ── Canonical ↔ RGB_565 ── */
+
+static void canon_to_565(const uint8_t *src, uint8_t *dst, uint32_t n) {
+    uint32_t i = 0;
+#ifdef PX_SSE2
+    const __m128i mr = _mm_set1_epi32(0xF8), mg = _mm_set1_epi32(0x7E0), mb = _mm_set1_epi32(0x1F);
+#define PX_565(p) _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128((p), mr), 8), \
+                      _mm_and_si128(_mm_srli_epi32((p), 5), mg)), _mm_and_si128(_mm_srli_epi32((p), 19), mb))
+/* Sign-extend the low 16 bits so _mm_packs_epi32 does not saturate. */
+#define PX_SX16(v) _mm_srai_epi32(_mm_slli_epi32((v), 16), 16)
+    for (; i + 8 <= n; i += 8) {
+        __m128i p0 = _mm_loadu_si128((const __m128i *)(src + 4 * (size_t)i));
+        __m128i p1 = _mm_loadu_si128((const __m128i *)(src + 4 * (size_t)i + 16));
+        __m128i q = _mm_packs_epi32(PX_SX16(PX_565(p0)), PX_SX16(PX_565(p1)));
+        _mm_storeu_si128((__m128i *)(dst + 2 * (size_t)i), q);
+    }
+#undef PX_565
+#undef PX_SX16
+#endif
+    for (; i < n; i++) {
+        uint32_t p;
+        memcpy(&p, src + 4 * (size_t)i, 4);
+        uint16_t q = (uint16_t)(((p & 0xF8) << 8) | ((p >> 5) & 0x7E0) | ((p >> 19) & 0x1F));
+        memcpy(dst + 2 * (size_t)i, &q, 2);
+    }
+}
+
+static void rgb565_to_canon(const uint8_t *src, uint8_t *dst, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t p;
+        memcpy(&p, src + 2 * (size_t)i, 2);
+        uint32_t r = ((p >> 11) & 0x1F) * 255 / 31;
+        uint32_t g = ((p >> 5) & 0x3F) * 255 / 63;
+        uint32_t b = (p & 0x1F) * 255 / 31;
+        uint32_t q = r | (g << 8) | (b << 16) | 0xFF000000u;
+        memcpy(dst + 4 * (size_t)i, &q, 4);
+    }
+}
+
+/* ── Canonical ↔ ABGR_F32 ── */
+
+static void canon_to_f32(const uint8_t *src, uint8_t *dst, uint32_t n) {
+    uint32_t i = 0;
+#ifdef PX_SSE2
+    const __m128i z = _mm_setzero_si128();
+    const __m128 k = _mm_set1_ps(255.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + 4 * (size_t)i));
+        __m128i lo = _mm_unpacklo_epi8(v, z), hi = _mm_unpackhi_epi8(v, z);
+        float *d = (float *)(void *)(dst + 16 * (size_t)i);
+        _mm_storeu_ps(d,      _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, z)), k));
+        _mm_storeu_ps(d + 4,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, z)), k));
+        _mm_storeu_ps(d + 8,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, z)), k));
+        _mm_storeu_ps(d + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, z)), k));
+    }
+#endif
+    for (; i < n; i++) {
+        const uint8_t *s = src + 4 * (size_t)i;
+        float f[4] = { s[0] / 255.0f, s[1] / 255.0f, s[2] / 255.0f, s[3] / 255.0f };
+        memcpy(dst + 16 * (size_t)i, f, 16);
+    }
+}
+
+static inline uint32_t px_unit_to_u8(float f) {
+    f = f > 0.0f ? (f < 1.0f ? f : 1.0f) : 0.0f;
+    return (uint32_t)(f * 255.0f + 0.5f);
+}
+
+static void f32_to_canon(const uint8_t *src, uint8_t *dst, uint32_t n) {
+    uint32_t i = 0;
+#ifdef PX_SSE2
+    const __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(1.0f);
+    const __m128 k = _mm_set1_ps(255.0f), half = _mm_set1_ps(0.5f);
+/* max(v, 0) returns 0 for NaN lanes. */
+#define PX_F2I(p) _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps( \
+                      _mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), lo), hi), k), half))
+    for (; i + 4 <= n; i += 4) {
+        const float *s = (const float *)(const void *)(src + 16 * (size_t)i);
+        __m128i a = _mm_packs_epi32(PX_F2I(s),     PX_F2I(s + 4));
+        __m128i b = _mm_packs_epi32(PX_F2I(s + 8), PX_F2I(s + 12));
+        _mm_storeu_si128((__m128i *)(dst + 4 * (size_t)i), _mm_packus_epi16(a, b));
+    }
+#undef PX_F2I
+#endif
+    for (; i < n; i++) {
+        float f[4];
+        memcpy(f, src + 16 * (size_t)i, 16);
+        uint32_t q = px_unit_to_u8(f[0]) | (px_unit_to_u8(f[1]) << 8) |
+                     (px_unit_to_u8(f[2]) << 16) | (px_unit_to_u8(f[3]) << 24);
+        memcpy(dst + 4 * (size_t)i, &q, 4);
+    }
+}
+
+/* ── Row / rect conversion ── */
+
+static void to_canon(const uint8_t *src, uint32_t fmt, uint8_t *dst, uint32_t n) {
+    switch (fmt) {
+        case ALLEGRO_PIXEL_FORMAT_RGB_565:   rgb565_to_canon(src, dst, n); break;
+        case ALLEGRO_PIXEL_FORMAT_ABGR_F32:  f32_to_canon(src, dst, n); break;
+        case ALLEGRO_PIXEL_FORMAT_ABGR_8888: memcpy(dst, src, 4 * (size_t)n); break;
+        default: swizzle_row(src, dst, n, px_shifts_of(fmt), PX_SHIFTS_ABGR); break;
+    }
+}
+
+static void from_canon(const uint8_t *src, uint32_t fmt, uint8_t *dst, uint32_t n) {
+    switch (fmt) {
+        case ALLEGRO_PIXEL_FORMAT_RGB_565:   canon_to_565(src, dst, n); break;
+        case ALLEGRO_PIXEL_FORMAT_ABGR_F32:  canon_to_f32(src, dst, n); break;
+        case ALLEGRO_PIXEL_FORMAT_ABGR_8888: memcpy(dst, src, 4 * (size_t)n); break;
+        default: swizzle_row(src, dst, n, PX_SHIFTS_ABGR, px_shifts_of(fmt)); break;
+    }
+}
+
+static void convert_row(const uint8_t *src, uint32_t sfmt, uint8_t *dst, uint32_t dfmt, uint32_t n) {
+    if (sfmt == dfmt) {
+        memmove(dst, src, (size_t)n * (size_t)allegro_px_size(sfmt));
+        return;
+    }
+    if (px_is_8888(sfmt) && px_is_8888(dfmt)) {
+        swizzle_row(src, dst, n, px_shifts_of(sfmt), px_shifts_of(dfmt));
+        return;
+    }
+    size_t ss = (size_t)allegro_px_size(sfmt), ds = (size_t)allegro_px_size(dfmt);
+    uint32_t chunk[PX_CHUNK];
+    for (uint32_t off = 0; off < n; off += PX_CHUNK) {
+        uint32_t k = n - off < PX_CHUNK ? n - off : PX_CHUNK;
+        const uint8_t *s = src + off * ss;
+        uint8_t *d = dst + off * ds;
+        if (dfmt == ALLEGRO_PIXEL_FORMAT_ABGR_8888) {
+            to_canon(s, sfmt, d, k);
+        } else if (sfmt == ALLEGRO_PIXEL_FORMAT_ABGR_8888) {
+            from_canon(s, dfmt, d, k);
+        } else {
+            to_canon(s, sfmt, (uint8_t *)chunk, k);
+            from_canon((const uint8_t *)chunk, dfmt, d, k);
+        }
+    }
+}
+
+void allegro_px_convert_rect(const uint8_t *src, ptrdiff_t src_pitch, uint32_t src_fmt,
+                             uint8_t *dst, ptrdiff_t dst_pitch, uint32_t dst_fmt,
+                             uint32_t w, uint32_t h) {
+    for (uint32_t r = 0; r < h; r++)
+        convert_row(src + (ptrdiff_t)r * src_pitch, src_fmt,
+                    dst + (ptrdiff_t)r * dst_pitch, dst_fmt, w);
+}
+
+void allegro_px_fill_rect(uint8_t *dst, ptrdiff_t pitch, uint32_t fmt,
+                          uint32_t w, uint32_t h, uint32_t rgba) {
+    /* One 16-byte pattern holds a whole number of pixels for every
+       supported size (2, 4, 16), so rows are filled in 16-byte stores. */
+    uint8_t pat[16];
+    size_t ps = (size_t)allegro_px_size(fmt);
+    if (ps == 0) return;
+    uint8_t one[16];
+    memcpy(one, &rgba, 4);
+    if (fmt != ALLEGRO_PIXEL_FORMAT_ABGR_8888) from_canon((const uint8_t *)&rgba, fmt, one, 1);
+    for (size_t k = 0; k < 16; k += ps) memcpy(pat + k, one, ps);
+    size_t row = (size_t)w * ps;
+#ifdef PX_SSE2
+    const __m128i v = _mm_loadu_si128((const __m128i *)pat);
+#endif
+    for (uint32_t r = 0; r < h; r++) {
+        uint8_t *d = dst + (ptrdiff_t)r * pitch;
+        size_t k = 0;
+#ifdef PX_SSE2
+        for (; k + 16 <= row; k += 16) _mm_storeu_si128((__m128i *)(d + k), v);
+#else
+        for (; k + 16 <= row; k += 16) memcpy(d + k, pat, 16);
+#endif
+        memcpy(d + k, pat, row - k);
+    }
+}
+
+/* ── ByteArray entry points ──
+   Pixel buffers are tightly packed rows (width * pixel size bytes, top row
+   first), the layout readRegion / writeRegion use. These are pure: they
+   touch no Allegro state. */
+
+static lean_object* px_empty(void) {
+    return lean_alloc_sarray(1, 0, 0);
+}
+
+/* A writable version of `a` (owned). Copies when `a` is shared or is the
+   same object as the borrowed `alias`; the original is returned through
+   `release` so the caller drops it only after reading from `alias`. */
+static lean_object* px_writable(lean_object *a, b_lean_obj_arg alias, lean_object **release) {
+    *release = NULL;
+    if (a != alias && lean_is_exclusive(a)) return a;
+    size_t n = lean_sarray_size(a);
+    lean_object *c = lean_alloc_sarray(1, n, n);
+    memcpy(lean_sarray_cptr(c), lean_sarray_cptr(a), n);
+    *release = a;
+    return c;
+}
+
+uint32_t allegro_pixel_format_has_kernel(uint32_t format) {
+    return allegro_px_size(format) != 0 ? 1u : 0u;
+}
+
+lean_object* allegro_convert_pixels(b_lean_obj_arg src, uint32_t src_fmt, uint32_t dst_fmt,
+                                    uint32_t w, uint32_t h) {
+    int ss = allegro_px_size(src_fmt), ds = allegro_px_size(dst_fmt);
+    uint64_t n = (uint64_t)w * h;
+    if (!ss || !ds || n == 0 || n * (uint64_t)ss > lean_sarray_size(src) || n > SIZE_MAX / 16)
+        return px_empty();
+    lean_object *out = lean_alloc_sarray(1, (size_t)n * ds, (size_t)n * ds);
+    /* Tight rows are one long row. */
+    for (uint64_t off = 0; off < n; off += 0x40000000u) {
+        uint32_t k = n - off < 0x40000000u ? (uint32_t)(n - off) : 0x40000000u;
+        convert_row(lean_sarray_cptr(src) + off * ss, src_fmt,
+                    lean_sarray_cptr(out) + off * ds, dst_fmt, k);
+    }
+    return out;
+}
+
+/* Rows in a tight buffer of `width` pixels of `ps` bytes, 0 if unusable. */
+static inline uint64_t px_rows(b_lean_obj_arg buf, uint32_t width, int ps) {
+    if (width == 0 || ps == 0) return 0;
+    return lean_sarray_size(buf) / ((uint64_t)width * (uint64_t)ps);
+}
+
+lean_object* allegro_blit_pixels(lean_obj_arg dst, uint32_t dst_fmt, uint32_t dst_w,
+                                 uint32_t dx, uint32_t dy,
+                                 b_lean_obj_arg src, uint32_t src_fmt, uint32_t src_w,
+                                 uint32_t sx, uint32_t sy, uint32_t w, uint32_t h) {
+    int ds = allegro_px_size(dst_fmt), ss = allegro_px_size(src_fmt);
+    if (w == 0 || h == 0 || !ds || !ss) return dst;
+    if ((uint64_t)dx + w > dst_w || (uint64_t)dy + h > px_rows(dst, dst_w, ds)) return dst;
+    if ((uint64_t)sx + w > src_w || (uint64_t)sy + h > px_rows(src, src_w, ss)) return dst;
+    lean_object *release;
+    dst = px_writable(dst, src, &release);
+    ptrdiff_t dpitch = (ptrdiff_t)dst_w * ds, spitch = (ptrdiff_t)src_w * ss;
+    allegro_px_convert_rect(lean_sarray_cptr(src) + (ptrdiff_t)sy * spitch + (ptrdiff_t)sx * ss,
+                            spitch, src_fmt,
+                            lean_sarray_cptr(dst) + (ptrdiff_t)dy * dpitch + (ptrdiff_t)dx * ds,
+                            dpitch, dst_fmt, w, h);
+    if (release) lean_dec(release);
+    return dst;
+}
+
+lean_object* allegro_fill_pixels(lean_obj_arg dst, uint32_t fmt, uint32_t dst_w,
+                                 uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t rgba) {
+    int ps = allegro_px_size(fmt);
+    if (w == 0 || h == 0 || !ps) return dst;
+    if ((uint64_t)x + w > dst_w || (uint64_t)y + h > px_rows(dst, dst_w, ps)) return dst;
+    lean_object *release;
+    dst = px_writable(dst, NULL, &release);
+    if (release) lean_dec(release);
+    ptrdiff_t pitch = (ptrdiff_t)dst_w * ps;
+    allegro_px_fill_rect(lean_sarray_cptr(dst) + (ptrdiff_t)y * pitch + (ptrdiff_t)x * ps,
+                         pitch, fmt, w, h, rgba);
+    return dst;
+}
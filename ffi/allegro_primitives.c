@@ -1,5 +1,6 @@
 #include "allegro_ffi.h"
 #include <string.h>
+#include <math.h>
 #include <allegro5/allegro_primitives.h>
 
 /* ── Addon lifecycle ── */
@@ -303,7 +304,7 @@ lean_object* allegro_al_draw_spline_rgb(
    Each pair is (x, y). */
 
 lean_object* allegro_al_draw_ribbon_rgb(
-    lean_object* pointsObj,
+    b_lean_obj_arg pointsObj,
     uint32_t r, uint32_t g, uint32_t b,
     double thickness, uint32_t numSegments) {
     size_t len = lean_sarray_byte_size(pointsObj);
@@ -313,16 +314,16 @@ lean_object* allegro_al_draw_ribbon_rgb(
     if (npts < 2) return io_ok_unit();
     ALLEGRO_COLOR color = al_map_rgb((unsigned char)r, (unsigned char)g, (unsigned char)b);
     al_draw_ribbon(pts, 2 * sizeof(float), color, (float)thickness,
-                   numSegments > 0 ? (int)numSegments : npts);
+                   numSegments > 0 && (int)numSegments < npts ? (int)numSegments : npts);
     return io_ok_unit();
 }
 
 /* ── Polyline ── */
 
 lean_object* allegro_al_draw_polyline_rgb(
-    lean_object* pointsObj,
-    uint32_t joinStyle, uint32_t capStyle,
+    b_lean_obj_arg pointsObj,
     uint32_t r, uint32_t g, uint32_t b,
+    uint32_t joinStyle, uint32_t capStyle,
     double thickness, double miterLimit) {
     size_t len = lean_sarray_byte_size(pointsObj);
     const float *pts = (const float *)lean_sarray_cptr(pointsObj);
@@ -338,9 +339,9 @@ lean_object* allegro_al_draw_polyline_rgb(
 /* ── Polygon ── */
 
 lean_object* allegro_al_draw_polygon_rgb(
-    lean_object* pointsObj,
-    uint32_t joinStyle,
+    b_lean_obj_arg pointsObj,
     uint32_t r, uint32_t g, uint32_t b,
+    uint32_t joinStyle,
     double thickness, double miterLimit) {
     size_t len = lean_sarray_byte_size(pointsObj);
     const float *pts = (const float *)lean_sarray_cptr(pointsObj);
@@ -352,7 +353,7 @@ lean_object* allegro_al_draw_polygon_rgb(
 }
 
 lean_object* allegro_al_draw_filled_polygon_rgb(
-    lean_object* pointsObj,
+    b_lean_obj_arg pointsObj,
     uint32_t r, uint32_t g, uint32_t b) {
     size_t len = lean_sarray_byte_size(pointsObj);
     const float *pts = (const float *)lean_sarray_cptr(pointsObj);
@@ -435,6 +436,90 @@ lean_object* allegro_al_unlock_vertex_buffer(uint64_t vb) {
     return io_ok_unit();
 }
 
+/* ── Streaming vertex buffer ring ──
+   A ring of ALLEGRO_PRIM_BUFFER_STREAM vertex buffers. Appends fill the
+   current buffer from its write cursor; when a batch does not fit, the ring
+   advances and the next buffer is overwritten from the start (its previous
+   contents were drawn at least ring-1 advances ago, so the driver need not
+   stall on it). Each append locks only the range it writes, write-only. */
+
+#define STREAM_VB_MAX_RING 8
+
+static int vertex_decl_stride(uint64_t decl);   /* see Vertex declaration */
+
+typedef struct {
+    ALLEGRO_VERTEX_BUFFER *bufs[STREAM_VB_MAX_RING];
+    int ring;
+    int cur;
+    int capacity;   /* vertices per buffer */
+    int stride;     /* bytes per vertex */
+    int used;       /* vertices written to bufs[cur] */
+} stream_vb;
+
+/* `stride` must match the decl: sizeof(ALLEGRO_VERTEX) for decl 0, the
+   stride the decl was created with otherwise. Appends trust it to turn
+   byte counts into vertex counts. */
+lean_object* allegro_create_streaming_vertex_buffer(uint64_t decl, uint32_t stride,
+                                                    uint32_t capacity, uint32_t ring) {
+    if (stride == 0 || (int)stride != vertex_decl_stride(decl)) return io_ok_uint64(0);
+    if (capacity == 0 || capacity > INT32_MAX / stride) return io_ok_uint64(0);
+    if (ring < 1) ring = 1;
+    if (ring > STREAM_VB_MAX_RING) ring = STREAM_VB_MAX_RING;
+    stream_vb *s = (stream_vb *)calloc(1, sizeof(stream_vb));
+    if (!s) return io_ok_uint64(0);
+    s->ring = (int)ring;
+    s->capacity = (int)capacity;
+    s->stride = (int)stride;
+    for (int i = 0; i < s->ring; i++) {
+        s->bufs[i] = al_create_vertex_buffer(
+            decl ? (ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl) : NULL,
+            NULL, s->capacity, ALLEGRO_PRIM_BUFFER_STREAM);
+        if (!s->bufs[i]) {
+            for (int j = 0; j < i; j++) al_destroy_vertex_buffer(s->bufs[j]);
+            free(s);
+            return io_ok_uint64(0);
+        }
+    }
+    return io_ok_uint64(ptr_to_u64(s));
+}
+
+lean_object* allegro_destroy_streaming_vertex_buffer(uint64_t h) {
+    stream_vb *s = (stream_vb *)u64_to_ptr(h);
+    if (s) {
+        for (int i = 0; i < s->ring; i++) al_destroy_vertex_buffer(s->bufs[i]);
+        free(s);
+    }
+    return io_ok_unit();
+}
+
+/* VertexRange (Primitives.lean): buffer u64 @0, start u32 @8, count u32 @12. */
+static inline lean_object* io_ok_vertex_range(ALLEGRO_VERTEX_BUFFER *vb, int start, int count) {
+    lean_object* obj = lean_alloc_ctor(0, 0, 16);
+    lean_ctor_set_uint64(obj, 0, ptr_to_u64(vb));
+    lean_ctor_set_uint32(obj, 8, (uint32_t)start);
+    lean_ctor_set_uint32(obj, 12, (uint32_t)count);
+    return lean_io_result_mk_ok(obj);
+}
+
+lean_object* allegro_streaming_vertex_buffer_append(uint64_t h, b_lean_obj_arg bytes) {
+    stream_vb *s = (stream_vb *)u64_to_ptr(h);
+    if (!s) return io_ok_vertex_range(NULL, 0, 0);
+    size_t n = lean_sarray_size(bytes) / (size_t)s->stride;
+    if (n == 0 || n > (size_t)s->capacity) return io_ok_vertex_range(NULL, 0, 0);
+    if (s->used + (int)n > s->capacity) {
+        s->cur = (s->cur + 1) % s->ring;
+        s->used = 0;
+    }
+    ALLEGRO_VERTEX_BUFFER *vb = s->bufs[s->cur];
+    void *dst = al_lock_vertex_buffer(vb, s->used, (int)n, ALLEGRO_LOCK_WRITEONLY);
+    if (!dst) return io_ok_vertex_range(NULL, 0, 0);
+    memcpy(dst, lean_sarray_cptr(bytes), n * (size_t)s->stride);
+    al_unlock_vertex_buffer(vb);
+    int start = s->used;
+    s->used += (int)n;
+    return io_ok_vertex_range(vb, start, (int)n);
+}
+
 lean_object* allegro_al_lock_index_buffer(uint64_t ib, uint32_t offset, uint32_t length, uint32_t flags) {
     if (ib == 0) return io_ok_uint64(0);
     void *ptr = al_lock_index_buffer(
@@ -469,7 +554,65 @@ lean_object* allegro_pack_floats(b_lean_obj_arg arr) {
     return ba;
 }
 
-/* ── Vertex declaration ── */
+/* Bulk FloatArray → packed f32. Unboxed doubles in, floats out, with no
+   aliasing: a plain loop the compiler turns into SIMD narrowing
+   (cvtpd2ps / fcvtn) at -O2 and above. */
+lean_object* allegro_pack_float_array(b_lean_obj_arg arr) {
+    size_t n = lean_sarray_size(arr);
+    lean_object* ba = lean_alloc_sarray(1, n * sizeof(float), n * sizeof(float));
+    const double *restrict src = lean_float_array_cptr(arr);
+    float *restrict dst = (float *)lean_sarray_cptr(ba);
+    for (size_t i = 0; i < n; i++) dst[i] = (float)src[i];
+    return ba;
+}
+
+/* ── Vertex declaration ──
+   Allegro keeps a decl's stride private, so the shim records it for every
+   decl it creates; the packed draw and streaming paths use it to turn byte
+   sizes into vertex counts. Decls are created and destroyed on the display
+   thread, like the drawing that reads them. */
+
+typedef struct {
+    ALLEGRO_VERTEX_DECL *decl;
+    int stride;
+} vertex_decl_entry;
+
+static vertex_decl_entry *vertex_decls = NULL;
+static size_t vertex_decl_count = 0;
+static size_t vertex_decl_cap = 0;
+
+/* Bytes per vertex for `decl` (sizeof(ALLEGRO_VERTEX) for the default
+   layout), or 0 for a decl the shim did not create. */
+static int vertex_decl_stride(uint64_t decl) {
+    if (decl == 0) return (int)sizeof(ALLEGRO_VERTEX);
+    for (size_t i = 0; i < vertex_decl_count; i++) {
+        if (vertex_decls[i].decl == (ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl))
+            return vertex_decls[i].stride;
+    }
+    return 0;
+}
+
+static void vertex_decl_remember(ALLEGRO_VERTEX_DECL *decl, int stride) {
+    if (vertex_decl_count == vertex_decl_cap) {
+        size_t cap = vertex_decl_cap ? vertex_decl_cap * 2 : 8;
+        vertex_decl_entry *p = (vertex_decl_entry *)realloc(vertex_decls, cap * sizeof(vertex_decl_entry));
+        if (!p) return;
+        vertex_decls = p;
+        vertex_decl_cap = cap;
+    }
+    vertex_decls[vertex_decl_count].decl = decl;
+    vertex_decls[vertex_decl_count].stride = stride;
+    vertex_decl_count++;
+}
+
+static void vertex_decl_forget(ALLEGRO_VERTEX_DECL *decl) {
+    for (size_t i = 0; i < vertex_decl_count; i++) {
+        if (vertex_decls[i].decl == decl) {
+            vertex_decls[i] = vertex_decls[--vertex_decl_count];
+            return;
+        }
+    }
+}
 
 lean_object* allegro_al_create_vertex_decl(b_lean_obj_arg elements, uint32_t stride) {
     /* elements is a Lean Array (UInt32 × UInt32 × UInt32) — (attribute, storage, offset) triples.
@@ -493,12 +636,15 @@ lean_object* allegro_al_create_vertex_decl(b_lean_obj_arg elements, uint32_t str
     elems[n].storage   = 0;
     elems[n].offset    = 0;
     ALLEGRO_VERTEX_DECL *decl = al_create_vertex_decl(elems, (int)stride);
+    if (decl) vertex_decl_remember(decl, (int)stride);
     return io_ok_uint64(ptr_to_u64(decl));
 }
 
 lean_object* allegro_al_destroy_vertex_decl(uint64_t decl) {
-    if (decl != 0)
+    if (decl != 0) {
+        vertex_decl_forget((ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl));
         al_destroy_vertex_decl((ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl));
+    }
     return io_ok_unit();
 }
 
@@ -549,7 +695,11 @@ lean_object* allegro_al_draw_indexed_prim_ba(b_lean_obj_arg vtxData, uint64_t de
     if (sz == 0) return io_ok_uint32(0);
     const void *data = lean_sarray_cptr(vtxData);
     size_t n = lean_array_size(indices);
-    int *idx = (int *)alloca(n * sizeof(int));
+    if ((size_t)numVtx > n) numVtx = (uint32_t)n;
+    /* Small index lists stay on the stack; large meshes go to the heap. */
+    int small[256];
+    int *idx = n <= 256 ? small : (int *)malloc(n * sizeof(int));
+    if (!idx) return io_ok_uint32(0);
     for (size_t i = 0; i < n; i++) {
         idx[i] = (int)lean_unbox_uint32(lean_array_get_core(indices, i));
     }
@@ -558,9 +708,328 @@ lean_object* allegro_al_draw_indexed_prim_ba(b_lean_obj_arg vtxData, uint64_t de
         decl ? (ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl) : NULL,
         texture ? (ALLEGRO_BITMAP *)u64_to_ptr(texture) : NULL,
         idx, (int)numVtx, (int)type);
+    if (idx != small) free(idx);
+    return io_ok_uint32((uint32_t)(drawn > 0 ? drawn : 0));
+}
+
+/* Packed-index variant: `indices` is a ByteArray of native int32 and is
+   handed to Allegro in place. Lean's ByteArray payload is 8-byte aligned.
+   Nothing is drawn if any index falls outside `vtxData`. */
+lean_object* allegro_al_draw_indexed_prim_packed(b_lean_obj_arg vtxData, uint64_t decl,
+                                                 uint64_t texture, b_lean_obj_arg indices,
+                                                 uint32_t type) {
+    size_t n = lean_sarray_size(indices) / sizeof(int);
+    int stride = vertex_decl_stride(decl);
+    if (stride == 0 || n == 0) return io_ok_uint32(0);
+    size_t num_vtx = lean_sarray_size(vtxData) / (size_t)stride;
+    if (num_vtx == 0) return io_ok_uint32(0);
+    if (n > INT32_MAX) n = INT32_MAX;
+    const int *idx = (const int *)lean_sarray_cptr(indices);
+    for (size_t i = 0; i < n; i++) {
+        if ((size_t)(unsigned int)idx[i] >= num_vtx) return io_ok_uint32(0);
+    }
+    int drawn = al_draw_indexed_prim(
+        lean_sarray_cptr(vtxData),
+        decl ? (ALLEGRO_VERTEX_DECL *)u64_to_ptr(decl) : NULL,
+        texture ? (ALLEGRO_BITMAP *)u64_to_ptr(texture) : NULL,
+        idx, (int)n, (int)type);
     return io_ok_uint32((uint32_t)(drawn > 0 ? drawn : 0));
 }
 
+/* ── Batch vertex scratch ──
+   Shared by the sprite and shape batches. Grown on demand and reused across
+   calls; drawing only happens on the display thread. */
+
+static ALLEGRO_VERTEX *vertex_scratch = NULL;
+static size_t vertex_scratch_cap = 0;
+
+static ALLEGRO_VERTEX *vertex_scratch_reserve(size_t n) {
+    if (n > vertex_scratch_cap) {
+        size_t cap = vertex_scratch_cap ? vertex_scratch_cap : 1024;
+        while (cap < n) cap *= 2;
+        ALLEGRO_VERTEX *p = (ALLEGRO_VERTEX *)realloc(vertex_scratch, cap * sizeof(ALLEGRO_VERTEX));
+        if (!p) return NULL;
+        vertex_scratch = p;
+        vertex_scratch_cap = cap;
+    }
+    return vertex_scratch;
+}
+
+static inline ALLEGRO_COLOR unpack_color(uint32_t c) {
+    return al_map_rgba((unsigned char)c, (unsigned char)(c >> 8),
+                       (unsigned char)(c >> 16), (unsigned char)(c >> 24));
+}
+
+/* ── Sprite batch ──
+   Each 40-byte record (see SpriteBatch in Primitives.lean):
+     f32 sx sy sw sh dx dy scale rotation, u32 tint (r | g<<8 | b<<16 | a<<24),
+     u32 flip flags.
+   Expanded into two triangles per sprite and drawn with one al_draw_prim. */
+
+#define SPRITE_RECORD_SIZE 40
+
+lean_object* allegro_draw_sprite_batch(uint64_t atlas, b_lean_obj_arg instances) {
+    ALLEGRO_BITMAP *tex = (ALLEGRO_BITMAP *)u64_to_ptr(atlas);
+    size_t count = lean_sarray_size(instances) / SPRITE_RECORD_SIZE;
+    if (!tex || count == 0) return io_ok_uint32(0);
+    if (count > (size_t)INT32_MAX / 6) count = (size_t)INT32_MAX / 6;
+
+    ALLEGRO_VERTEX *v = vertex_scratch_reserve(count * 6);
+    if (!v) return io_ok_uint32(0);
+
+    const uint8_t *rec = lean_sarray_cptr(instances);
+    for (size_t i = 0; i < count; i++, rec += SPRITE_RECORD_SIZE, v += 6) {
+        float f[8];
+        uint32_t tint, flags;
+        memcpy(f, rec, sizeof f);
+        memcpy(&tint, rec + 32, 4);
+        memcpy(&flags, rec + 36, 4);
+        float sx = f[0], sy = f[1], sw = f[2], sh = f[3];
+        float dx = f[4], dy = f[5], scale = f[6], rot = f[7];
+
+        ALLEGRO_COLOR c = unpack_color(tint);
+        float hw = 0.5f * sw * scale, hh = 0.5f * sh * scale;
+        float cs = 1.0f, sn = 0.0f;
+        if (rot != 0.0f) { cs = cosf(rot); sn = sinf(rot); }
+
+        /* Texture coordinates are in pixels; flipping swaps the edges. */
+        float u0 = sx, u1 = sx + sw, v0 = sy, v1 = sy + sh;
+        if (flags & ALLEGRO_FLIP_HORIZONTAL) { float t = u0; u0 = u1; u1 = t; }
+        if (flags & ALLEGRO_FLIP_VERTICAL)   { float t = v0; v0 = v1; v1 = t; }
+
+        /* Corners relative to the centre, rotated clockwise (y down). */
+        float ax = -hw * cs + hh * sn, ay = -hw * sn - hh * cs;   /* top-left */
+        float bx =  hw * cs + hh * sn, by =  hw * sn - hh * cs;   /* top-right */
+        ALLEGRO_VERTEX tl = { dx + ax, dy + ay, 0, u0, v0, c };
+        ALLEGRO_VERTEX tr = { dx + bx, dy + by, 0, u1, v0, c };
+        ALLEGRO_VERTEX br = { dx - ax, dy - ay, 0, u1, v1, c };
+        ALLEGRO_VERTEX bl = { dx - bx, dy - by, 0, u0, v1, c };
+        v[0] = tl; v[1] = tr; v[2] = br;
+        v[3] = tl; v[4] = br; v[5] = bl;
+    }
+
+    al_draw_prim(vertex_scratch, NULL, tex, 0, (int)(count * 6), ALLEGRO_PRIM_TRIANGLE_LIST);
+    return io_ok_uint32((uint32_t)count);
+}
+
+/* ── Glyph runs ──
+   Draws records from allegro_shape_glyph_run (allegro_font.c): u64 page,
+   f32 sx sy sw sh dx dy. Records arrive grouped by page, so each group of
+   equal pages becomes one al_draw_prim. Returns the number of draw calls. */
+
+lean_object* allegro_draw_glyph_run(b_lean_obj_arg run, double x, double y, uint32_t tint) {
+    size_t count = lean_sarray_size(run) / GLYPH_RUN_RECORD;
+    if (count == 0) return io_ok_uint32(0);
+    if (count > (size_t)INT32_MAX / 6) count = (size_t)INT32_MAX / 6;
+
+    ALLEGRO_VERTEX *v = vertex_scratch_reserve(count * 6);
+    if (!v) return io_ok_uint32(0);
+
+    ALLEGRO_COLOR c = unpack_color(tint);
+    const uint8_t *rec = lean_sarray_cptr(run);
+    uint64_t page = 0;
+    size_t start = 0;
+    uint32_t calls = 0;
+    for (size_t i = 0; i <= count; i++, rec += GLYPH_RUN_RECORD) {
+        uint64_t h = 0;
+        if (i < count) memcpy(&h, rec, 8);
+        if (i == count || h != page) {
+            if (i > start && page != 0) {
+                al_draw_prim(vertex_scratch + start * 6, NULL, (ALLEGRO_BITMAP *)u64_to_ptr(page),
+                             0, (int)((i - start) * 6), ALLEGRO_PRIM_TRIANGLE_LIST);
+                calls++;
+            }
+            if (i == count) break;
+            page = h;
+            start = i;
+        }
+        float f[6];
+        memcpy(f, rec + 8, sizeof f);
+        float x0 = (float)x + f[4], y0 = (float)y + f[5];
+        float x1 = x0 + f[2], y1 = y0 + f[3];
+        float u0 = f[0], v0 = f[1], u1 = f[0] + f[2], v1 = f[1] + f[3];
+        ALLEGRO_VERTEX tl = { x0, y0, 0, u0, v0, c };
+        ALLEGRO_VERTEX tr = { x1, y0, 0, u1, v0, c };
+        ALLEGRO_VERTEX br = { x1, y1, 0, u1, v1, c };
+        ALLEGRO_VERTEX bl = { x0, y1, 0, u0, v1, c };
+        ALLEGRO_VERTEX *q = v + i * 6;
+        q[0] = tl; q[1] = tr; q[2] = br;
+        q[3] = tl; q[4] = br; q[5] = bl;
+    }
+    return io_ok_uint32(calls);
+}
+
+/* ── Shape batch ──
+   Records from ShapeBatch in Primitives.lean: a one-byte opcode, f32
+   geometry, then a packed u32 colour. Every shape is tessellated into
+   triangles so the whole batch is one al_draw_prim; hairlines
+   (thickness <= 0) are drawn one pixel wide. */
+
+enum {
+    SB_FILLED_RECT = 1,     /* x1 y1 x2 y2, colour */
+    SB_RECT = 2,            /* x1 y1 x2 y2 thickness, colour */
+    SB_FILLED_CIRCLE = 3,   /* cx cy r, colour */
+    SB_CIRCLE = 4,          /* cx cy r thickness, colour */
+    SB_LINE = 5,            /* x1 y1 x2 y2 thickness, colour */
+    SB_POINT = 6            /* x y, colour */
+};
+
+/* Circle tessellation cache. Segment counts follow Allegro's own heuristic
+   (ALLEGRO_PRIM_QUALITY * sqrt(r), clamped) and are memoised per integer
+   radius; the unit-circle cos/sin table is built once per segment count. */
+#define CIRCLE_MIN_SEGS 8
+#define CIRCLE_MAX_SEGS 256
+#define CIRCLE_RADIUS_CACHE 2048
+/* Radii are clamped to this before converting to int; the segment count
+   reaches CIRCLE_MAX_SEGS long before it. */
+#define CIRCLE_MAX_RADIUS 1.0e6f
+
+static uint16_t circle_segs_by_radius[CIRCLE_RADIUS_CACHE];
+static float *circle_unit[CIRCLE_MAX_SEGS + 1];
+
+static int circle_segments(float r) {
+    /* NaN, zero and negative radii fall to the minimum; inf to the cap. */
+    if (!(r > 0.0f)) r = 0.0f;
+    int key = (int)ceilf(fminf(r, CIRCLE_MAX_RADIUS));
+    if (key < CIRCLE_RADIUS_CACHE && circle_segs_by_radius[key])
+        return circle_segs_by_radius[key];
+    int n = (int)(ALLEGRO_PRIM_QUALITY * sqrtf((float)key));
+    if (n < CIRCLE_MIN_SEGS) n = CIRCLE_MIN_SEGS;
+    if (n > CIRCLE_MAX_SEGS) n = CIRCLE_MAX_SEGS;
+    if (key < CIRCLE_RADIUS_CACHE) circle_segs_by_radius[key] = (uint16_t)n;
+    return n;
+}
+
+/* Interleaved cos/sin for n + 1 points (the last repeats the first). */
+static const float *circle_table(int n) {
+    if (!circle_unit[n]) {
+        float *t = (float *)malloc((size_t)(n + 1) * 2 * sizeof(float));
+        if (!t) return NULL;
+        for (int i = 0; i <= n; i++) {
+            double a = (2.0 * ALLEGRO_PI * (i % n)) / n;
+            t[2 * i] = (float)cos(a);
+            t[2 * i + 1] = (float)sin(a);
+        }
+        circle_unit[n] = t;
+    }
+    return circle_unit[n];
+}
+
+static inline void put_vertex(ALLEGRO_VERTEX *v, float x, float y, ALLEGRO_COLOR c) {
+    v->x = x; v->y = y; v->z = 0; v->u = 0; v->v = 0; v->color = c;
+}
+
+/* Two triangles for the quad a-b-c-d (in order around the edge). */
+static inline ALLEGRO_VERTEX *put_quad(ALLEGRO_VERTEX *v,
+                                       float ax, float ay, float bx, float by,
+                                       float cx, float cy, float dx, float dy,
+                                       ALLEGRO_COLOR col) {
+    put_vertex(v + 0, ax, ay, col); put_vertex(v + 1, bx, by, col); put_vertex(v + 2, cx, cy, col);
+    put_vertex(v + 3, ax, ay, col); put_vertex(v + 4, cx, cy, col); put_vertex(v + 5, dx, dy, col);
+    return v + 6;
+}
+
+static inline ALLEGRO_VERTEX *put_rect(ALLEGRO_VERTEX *v, float x1, float y1,
+                                       float x2, float y2, ALLEGRO_COLOR c) {
+    return put_quad(v, x1, y1, x2, y1, x2, y2, x1, y2, c);
+}
+
+static inline ALLEGRO_VERTEX *put_line(ALLEGRO_VERTEX *v, float x1, float y1,
+                                       float x2, float y2, float t, ALLEGRO_COLOR c) {
+    float dx = x2 - x1, dy = y2 - y1;
+    float len = sqrtf(dx * dx + dy * dy);
+    float nx = 0.0f, ny = 0.0f;
+    if (len > 0.0f) { nx = -dy / len * 0.5f * t; ny = dx / len * 0.5f * t; }
+    return put_quad(v, x1 + nx, y1 + ny, x2 + nx, y2 + ny, x2 - nx, y2 - ny, x1 - nx, y1 - ny, c);
+}
+
+static size_t shape_payload(uint8_t op) {
+    switch (op) {
+    case SB_FILLED_RECT:   return 4 * 4 + 4;
+    case SB_RECT:          return 5 * 4 + 4;
+    case SB_FILLED_CIRCLE: return 3 * 4 + 4;
+    case SB_CIRCLE:        return 4 * 4 + 4;
+    case SB_LINE:          return 5 * 4 + 4;
+    case SB_POINT:         return 2 * 4 + 4;
+    default:               return 0;
+    }
+}
+
+lean_object* allegro_draw_shape_batch(b_lean_obj_arg shapes) {
+    const uint8_t *p = lean_sarray_cptr(shapes);
+    const uint8_t *end = p + lean_sarray_size(shapes);
+    size_t used = 0;
+    uint32_t drawn = 0;
+
+    while (p < end) {
+        uint8_t op = *p;
+        size_t need = shape_payload(op);
+        if (need == 0 || (size_t)(end - p) < 1 + need) break;
+        float f[5];
+        uint32_t col;
+        memcpy(f, p + 1, need - 4);
+        memcpy(&col, p + 1 + need - 4, 4);
+        p += 1 + need;
+        ALLEGRO_COLOR c = unpack_color(col);
+
+        int segs = (op == SB_FILLED_CIRCLE || op == SB_CIRCLE) ? circle_segments(f[2]) : 0;
+        size_t verts = op == SB_RECT ? 24 : segs ? (size_t)segs * (op == SB_CIRCLE ? 6 : 3) : 6;
+        if (!vertex_scratch_reserve(used + verts)) break;
+        ALLEGRO_VERTEX *v = vertex_scratch + used;
+
+        switch (op) {
+        case SB_FILLED_RECT:
+            put_rect(v, f[0], f[1], f[2], f[3], c);
+            break;
+        case SB_RECT: {
+            /* Four edge quads centred on the outline, like al_draw_rectangle. */
+            float h = (f[4] > 0.0f ? f[4] : 1.0f) * 0.5f;
+            float x1 = f[0], y1 = f[1], x2 = f[2], y2 = f[3];
+            v = put_rect(v, x1 - h, y1 - h, x2 + h, y1 + h, c);
+            v = put_rect(v, x1 - h, y2 - h, x2 + h, y2 + h, c);
+            v = put_rect(v, x1 - h, y1 + h, x1 + h, y2 - h, c);
+            put_rect(v, x2 - h, y1 + h, x2 + h, y2 - h, c);
+            break;
+        }
+        case SB_FILLED_CIRCLE:
+        case SB_CIRCLE: {
+            const float *t = circle_table(segs);
+            if (!t) goto done;
+            float cx = f[0], cy = f[1], r = f[2];
+            if (op == SB_FILLED_CIRCLE) {
+                for (int i = 0; i < segs; i++, v += 3) {
+                    put_vertex(v + 0, cx, cy, c);
+                    put_vertex(v + 1, cx + r * t[2 * i], cy + r * t[2 * i + 1], c);
+                    put_vertex(v + 2, cx + r * t[2 * i + 2], cy + r * t[2 * i + 3], c);
+                }
+            } else {
+                float h = (f[3] > 0.0f ? f[3] : 1.0f) * 0.5f;
+                float ri = r - h, ro = r + h;
+                for (int i = 0; i < segs; i++) {
+                    float c0 = t[2 * i], s0 = t[2 * i + 1], c1 = t[2 * i + 2], s1 = t[2 * i + 3];
+                    v = put_quad(v, cx + ro * c0, cy + ro * s0, cx + ro * c1, cy + ro * s1,
+                                    cx + ri * c1, cy + ri * s1, cx + ri * c0, cy + ri * s0, c);
+                }
+            }
+            break;
+        }
+        case SB_LINE:
+            put_line(v, f[0], f[1], f[2], f[3], f[4] > 0.0f ? f[4] : 1.0f, c);
+            break;
+        case SB_POINT:
+            put_rect(v, f[0], f[1], f[0] + 1.0f, f[1] + 1.0f, c);
+            break;
+        }
+        used += verts;
+        drawn++;
+    }
+
+done:
+    if (used > 0)
+        al_draw_prim(vertex_scratch, NULL, NULL, 0, (int)used, ALLEGRO_PRIM_TRIANGLE_LIST);
+    return io_ok_uint32(drawn);
+}
+
 lean_object* allegro_al_get_allegro_primitives_version(void) {
     return io_ok_uint32(al_get_allegro_primitives_version());
 }
@@ -605,6 +1074,10 @@ lean_object* allegro_al_calculate_spline(double x1, double y1, double x2, double
 lean_object* allegro_al_calculate_ribbon(b_lean_obj_arg pointsBA, double thickness,
                                           uint32_t numSegments) {
     const float *pts = (const float *)lean_sarray_cptr(pointsBA);
+    /* al_calculate_ribbon reads numSegments + 1 input points. */
+    size_t avail = lean_sarray_size(pointsBA) / (2 * sizeof(float));
+    if (avail == 0) return lean_io_result_mk_ok(lean_alloc_sarray(1, 0, 0));
+    if ((size_t)numSegments + 1 > avail) numSegments = (uint32_t)(avail - 1);
     int n = (int)numSegments + 1;
     int numVerts = (thickness > 0.0) ? (n * 2) : n;
     size_t byteLen = (size_t)numVerts * 2 * sizeof(float);
@@ -618,21 +1091,36 @@ lean_object* allegro_al_calculate_ribbon(b_lean_obj_arg pointsBA, double thickne
 
 /* ── Draw filled polygon with holes ── */
 
+/* 0-terminated heap copy of an `Array UInt32` of contour sizes, for the
+   caller to free. Returns NULL (nothing to draw) on the same conditions as
+   packed_vertex_counts below: no contours, a size of 0 or above INT_MAX,
+   more vertices than `verticesBA` holds, or out of memory. */
+static int *boxed_vertex_counts(b_lean_obj_arg verticesBA, b_lean_obj_arg countsArr) {
+    size_t n = lean_array_size(countsArr);
+    if (n == 0) return NULL;
+    int *counts = (int *)malloc((n + 1) * sizeof(int));
+    if (!counts) return NULL;
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t c = lean_unbox_uint32(lean_array_get_core(countsArr, i));
+        if (c == 0 || c > INT32_MAX) { free(counts); return NULL; }
+        counts[i] = (int)c;
+        total += c;
+    }
+    if (total > lean_sarray_size(verticesBA) / (2 * sizeof(float))) { free(counts); return NULL; }
+    counts[n] = 0;
+    return counts;
+}
+
 lean_object* allegro_al_draw_filled_polygon_with_holes(
         b_lean_obj_arg verticesBA,
         b_lean_obj_arg vertexCountsArr,
         uint32_t r, uint32_t g, uint32_t b) {
-    const float *vertices = (const float *)lean_sarray_cptr(verticesBA);
-    size_t nCounts = lean_array_size(vertexCountsArr);
-    /* Build a 0-terminated int array */
-    int *vcounts = (int *)alloca((nCounts + 1) * sizeof(int));
-    for (size_t i = 0; i < nCounts; i++) {
-        lean_object* elem = lean_array_get_core(vertexCountsArr, i);
-        vcounts[i] = (int)lean_unbox_uint32(elem);
-    }
-    vcounts[nCounts] = 0;
+    int *vcounts = boxed_vertex_counts(verticesBA, vertexCountsArr);
+    if (!vcounts) return io_ok_unit();
     ALLEGRO_COLOR color = al_map_rgb((unsigned char)r, (unsigned char)g, (unsigned char)b);
-    al_draw_filled_polygon_with_holes(vertices, vcounts, color);
+    al_draw_filled_polygon_with_holes((const float *)lean_sarray_cptr(verticesBA), vcounts, color);
+    free(vcounts);
     return io_ok_unit();
 }
 
@@ -657,18 +1145,13 @@ static void triangulate_emit_cb(int a, int b, int c, void *extra) {
 
 lean_object* allegro_al_triangulate_polygon(b_lean_obj_arg verticesBA,
                                              b_lean_obj_arg vertexCountsArr) {
-    const float *vertices = (const float *)lean_sarray_cptr(verticesBA);
-    size_t nCounts = lean_array_size(vertexCountsArr);
-    int *vcounts = (int *)alloca((nCounts + 1) * sizeof(int));
-    for (size_t i = 0; i < nCounts; i++) {
-        lean_object* elem = lean_array_get_core(vertexCountsArr, i);
-        vcounts[i] = (int)lean_unbox_uint32(elem);
-    }
-    vcounts[nCounts] = 0;
-
+    int *vcounts = boxed_vertex_counts(verticesBA, vertexCountsArr);
     triangulate_data_t data = {NULL, 0, 0};
-    al_triangulate_polygon(vertices, 2 * (int)sizeof(float),
-                           vcounts, triangulate_emit_cb, &data);
+    if (vcounts) {
+        al_triangulate_polygon((const float *)lean_sarray_cptr(verticesBA),
+                               2 * (int)sizeof(float), vcounts, triangulate_emit_cb, &data);
+        free(vcounts);
+    }
 
     size_t numTri = data.count / 3;
     lean_object *arr = lean_alloc_array(numTri, numTri);
@@ -682,3 +1165,61 @@ lean_object* allegro_al_triangulate_polygon(b_lean_obj_arg verticesBA,
     free(data.indices);
     return lean_io_result_mk_ok(arr);
 }
+
+/* ── Packed vertex-count variants ──
+   `counts` is a ByteArray of native int32 contour sizes. Allegro wants a
+   0-terminated list: a buffer that already ends in 0 is used in place,
+   otherwise it is copied once with the terminator appended. Returns NULL
+   (nothing to draw) if the counts are empty, negative, or need more
+   vertices than `verticesBA` holds. */
+
+static const int *packed_vertex_counts(b_lean_obj_arg verticesBA, b_lean_obj_arg countsBA,
+                                       int **owned) {
+    *owned = NULL;
+    size_t n = lean_sarray_size(countsBA) / sizeof(int);
+    const int *counts = (const int *)lean_sarray_cptr(countsBA);
+    if (n > 0 && counts[n - 1] == 0) n--;
+    if (n == 0) return NULL;
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (counts[i] <= 0) return NULL;
+        total += (size_t)counts[i];
+    }
+    if (total > lean_sarray_size(verticesBA) / (2 * sizeof(float))) return NULL;
+    if (lean_sarray_size(countsBA) / sizeof(int) > n) return counts;
+    int *copy = (int *)malloc((n + 1) * sizeof(int));
+    if (!copy) return NULL;
+    memcpy(copy, counts, n * sizeof(int));
+    copy[n] = 0;
+    *owned = copy;
+    return copy;
+}
+
+lean_object* allegro_al_draw_filled_polygon_with_holes_packed(
+        b_lean_obj_arg verticesBA, b_lean_obj_arg countsBA, uint32_t color) {
+    int *owned;
+    const int *vcounts = packed_vertex_counts(verticesBA, countsBA, &owned);
+    if (vcounts) {
+        al_draw_filled_polygon_with_holes(
+            (const float *)lean_sarray_cptr(verticesBA), vcounts, unpack_color(color));
+        free(owned);
+    }
+    return io_ok_unit();
+}
+
+lean_object* allegro_al_triangulate_polygon_packed(b_lean_obj_arg verticesBA,
+                                                   b_lean_obj_arg countsBA) {
+    int *owned;
+    const int *vcounts = packed_vertex_counts(verticesBA, countsBA, &owned);
+    triangulate_data_t data = {NULL, 0, 0};
+    if (vcounts) {
+        al_triangulate_polygon((const float *)lean_sarray_cptr(verticesBA),
+                               2 * (int)sizeof(float), vcounts, triangulate_emit_cb, &data);
+        free(owned);
+    }
+    size_t bytes = data.count * sizeof(int);
+    lean_object *ba = lean_alloc_sarray(1, bytes, bytes);
+    if (bytes) memcpy(lean_sarray_cptr(ba), data.indices, bytes);
+    free(data.indices);
+    return lean_io_result_mk_ok(ba);
+}
@@ -2,7 +2,9 @@
 #include <allegro5/allegro.h>
 
 lean_object* allegro_al_init(void) {
-    return io_ok_uint32(al_init() ? 1u : 0u);
+    if (!al_init()) return io_ok_uint32(0);
+    allegro_event_filters_init();
+    return io_ok_uint32(1);
 }
 
 lean_object* allegro_al_uninstall_system(void) {
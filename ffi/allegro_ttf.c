@@ -1,4 +1,5 @@
 #include "allegro_ffi.h"
+#include <string.h>
 #include <allegro5/allegro_ttf.h>
 
 /* ── Lifecycle ── */
@@ -57,3 +58,50 @@ lean_object* allegro_al_load_ttf_font_stretch_f(uint64_t file, lean_object* name
     lean_dec_ref(nameObj);
     return io_ok_uint64(ptr_to_u64(font));
 }
+
+/* ── Glyph pre-rasterisation ──
+   TTF fonts render glyphs into their page bitmaps on first use; calling
+   al_get_glyph forces that now. Walks the packed u32 codepoints in `cps`
+   from index `start` until the end or until `budget_ms` (<= 0: no limit)
+   has elapsed, checking the clock every 16 glyphs. Returns
+   (next index, glyphs found, distinct pages touched as packed u64s). */
+
+lean_object* allegro_warm_font_glyphs(uint64_t font, b_lean_obj_arg cps, uint32_t start, double budget_ms) {
+    ALLEGRO_FONT *f = (ALLEGRO_FONT *)u64_to_ptr(font);
+    size_t n = lean_sarray_size(cps) / 4;
+    const uint8_t *p = lean_sarray_cptr(cps);
+    size_t i = start;
+    uint32_t found = 0;
+    uint64_t *pages = NULL;
+    size_t npages = 0, cap = 0;
+    double deadline = budget_ms > 0 ? al_get_time() + budget_ms / 1000.0 : 0;
+    if (!f) i = n;
+    for (; i < n; i++) {
+        if (deadline > 0 && ((i - start) & 15) == 15 && al_get_time() >= deadline) break;
+        uint32_t cp;
+        memcpy(&cp, p + 4 * i, 4);
+        ALLEGRO_GLYPH g;
+        if (!al_get_glyph(f, 0, (int)cp, &g)) continue;
+        found++;
+        if (!g.bitmap) continue;
+        uint64_t h = ptr_to_u64(g.bitmap);
+        size_t k = 0;
+        while (k < npages && pages[k] != h) k++;
+        if (k < npages) continue;
+        if (npages == cap) {
+            /* Grow `cap` only once realloc succeeds, so a failed attempt
+               cannot let the next append write past the old block. */
+            size_t want = cap ? cap * 2 : 8;
+            uint64_t *grown = (uint64_t *)realloc(pages, want * sizeof(uint64_t));
+            if (!grown) continue;
+            pages = grown;
+            cap = want;
+        }
+        pages[npages++] = h;
+    }
+    lean_object *out = lean_alloc_sarray(1, npages * 8, npages * 8);
+    if (npages) memcpy(lean_sarray_cptr(out), pages, npages * 8);
+    free(pages);
+    return lean_io_result_mk_ok(mk_pair(lean_box_uint32((uint32_t)(i < n ? i : n)),
+                                        mk_pair(lean_box_uint32(found), out)));
+}
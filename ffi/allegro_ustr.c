@@ -402,9 +402,10 @@ lean_object* allegro_al_ustr_has_suffix(uint64_t us1, uint64_t us2) {
 
 /* ── Low-level UTF-8 helpers ── */
 
-lean_object* allegro_al_utf8_width(uint32_t codepoint) {
-    size_t w = al_utf8_width((int32_t)codepoint);
-    return io_ok_uint32((uint32_t)w);
+/* The codepoint helpers below are pure and bound without IO. */
+
+uint32_t allegro_al_utf8_width(uint32_t codepoint) {
+    return (uint32_t)al_utf8_width((int32_t)codepoint);
 }
 
 lean_object* allegro_al_utf8_encode(uint32_t codepoint) {
@@ -412,7 +413,7 @@ lean_object* allegro_al_utf8_encode(uint32_t codepoint) {
     size_t n = al_utf8_encode(buf, (int32_t)codepoint);
     /* Return as a Lean String (up to 4 UTF-8 bytes). */
     buf[n] = '\0';
-    return io_ok_string(buf);
+    return lean_mk_string(buf);
 }
 
 /* ── UTF-16 functions ── */
@@ -423,9 +424,8 @@ lean_object* allegro_al_ustr_size_utf16(uint64_t ustr) {
     return io_ok_uint64((uint64_t)sz);
 }
 
-lean_object* allegro_al_utf16_width(uint32_t codepoint) {
-    size_t w = al_utf16_width((int)codepoint);
-    return io_ok_uint32((uint32_t)w);
+uint32_t allegro_al_utf16_width(uint32_t codepoint) {
+    return (uint32_t)al_utf16_width((int)codepoint);
 }
 
 /* ── Duplicate USTR to Lean String ── */
@@ -458,7 +458,7 @@ lean_object* allegro_al_utf16_encode(uint32_t codepoint) {
     uint16_t buf[2] = {0, 0};
     size_t n = al_utf16_encode(buf, (int32_t)codepoint);
     /* Return as (uint32_t hi, uint32_t lo, uint32_t count) */
-    return io_ok_u32_triple((uint32_t)buf[0], (uint32_t)buf[1], (uint32_t)n);
+    return mk_u32_triple((uint32_t)buf[0], (uint32_t)buf[1], (uint32_t)n);
 }
 
 /* ── Read-only USTR references (heap-allocated info structs) ── */
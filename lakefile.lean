@@ -315,6 +315,24 @@ allegro_exe allegroErrorTest where
   root := `Tests.ErrorPath; srcDir := "tests"
   needs := #[Allegro, «Tests.Harness»]
 
+-- ── Benchmark executables ──
+
+allegro_exe allegroInlineBench where
+  root := `Tests.InlineBench; srcDir := "tests"
+allegro_exe allegroFfiBench where
+  root := `Tests.FfiBench; srcDir := "tests"
+allegro_exe allegroSpriteBench where
+  root := `Tests.SpriteBench; srcDir := "tests"
+
+allegro_exe allegroPixelBench where
+  root := `Tests.PixelBench; srcDir := "tests"
+
+allegro_exe allegroFilterBench where
+  root := `Tests.FilterBench; srcDir := "tests"
+
+allegro_exe allegroTextSpriteBench where
+  root := `Tests.TextSpriteBench; srcDir := "tests"
+
 -- ── C shim static library ──
 
 extern_lib allegroshim (pkg : NPackage __name__) := do
@@ -346,7 +364,10 @@ extern_lib allegroshim (pkg : NPackage __name__) := do
     "allegro_file.c",
     "allegro_filesystem.c",
     "allegro_shader.c",
-    "allegro_haptic.c"
+    "allegro_haptic.c",
+    "allegro_drawlist.c",
+    "allegro_pixels.c",
+    "allegro_filter.c"
   ]
   let lean ← getLeanInstall
   let mut oJobs : Array (Job System.FilePath) := #[]
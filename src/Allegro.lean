@@ -5,6 +5,17 @@ import Allegro.Compat
 import Allegro.Math
 import Allegro.Vec2
 import Allegro.GameLoop
+import Allegro.Pack
+import Allegro.DrawList
+import Allegro.Filter
+import Allegro.Atlas
+import Allegro.AssetLoader
+import Allegro.BitmapCache
+import Allegro.FontCaches
+import Allegro.TextCache
+import Allegro.GlyphRun
+import Allegro.TextSprite
+import Allegro.FontWarm
 
 /-!
 # Allegro — Lean 4 bindings for the Allegro 5 game-programming library
@@ -12,6 +23,14 @@ import Allegro.GameLoop
 This is the root import module. Importing `Allegro` brings in every
 sub-module: core APIs (display, input, events, bitmaps …), addon APIs
 (audio, fonts, image I/O, primitives, native dialogs, video, memfile),
-the RAII `Resource` helper, the dot-notation `Compat` layer, and utility
-modules (`Math`, `Vec2`, `GameLoop`).
+the RAII `Resource` helper, the dot-notation `Compat` layer, utility
+modules (`Math`, `Vec2`, `GameLoop`, `Pack`), and `DrawList` for recording a frame's
+drawing and replaying it in one call, and `Filter` for multithreaded image
+filters on memory bitmaps, `Atlas` for packing sprites into texture
+atlas pages, `AssetLoader` for background asset loading,
+`BitmapCache` for sharing decoded bitmaps under a memory budget,
+`FontCaches` for releasing a font from every per-font cache at once,
+`TextCache` for memoised text measurement and word wrapping, `GlyphRun`
+for drawing pre-shaped text, `TextSprite` for static labels rendered
+once into bitmaps, and `FontWarm` for pre-rasterising TTF glyphs.
 -/
@@ -544,18 +544,22 @@ opaque getDefaultVoice : IO Voice
 opaque getAudioVersion : IO UInt32
 
 @[extern "allegro_al_get_channel_count"]
-private opaque getChannelCountRaw : UInt32 → IO UInt32
+private opaque channelCountRaw : UInt32 → UInt32
+
+/-- Number of channels in a channel configuration (pure). -/
+@[inline] def ChannelConf.count (conf : ChannelConf) : UInt32 := channelCountRaw conf.val
 
 /-- Get the number of channels for a channel configuration constant. -/
-@[inline] def getChannelCount (conf : ChannelConf) : IO UInt32 :=
-  getChannelCountRaw conf.val
+@[inline] def getChannelCount (conf : ChannelConf) : IO UInt32 := pure conf.count
 
 @[extern "allegro_al_get_audio_depth_size"]
-private opaque getAudioDepthSizeRaw : UInt32 → IO UInt32
+private opaque audioDepthSizeRaw : UInt32 → UInt32
+
+/-- Byte size of one sample at the given audio depth (pure). -/
+@[inline] def AudioDepth.size (depth : AudioDepth) : UInt32 := audioDepthSizeRaw depth.val
 
 /-- Get the byte size of one sample for the given audio depth. -/
-@[inline] def getAudioDepthSize (depth : AudioDepth) : IO UInt32 :=
-  getAudioDepthSizeRaw depth.val
+@[inline] def getAudioDepthSize (depth : AudioDepth) : IO UInt32 := pure depth.size
 
 /-- Get the acodec addon version (packed as major·minor·revision·release). -/
 @[extern "allegro_al_get_allegro_acodec_version"]
@@ -1,3 +1,5 @@
+import Allegro.Core.System
+
 /-!
 # Color addon bindings
 
@@ -23,6 +25,18 @@ let html ← Allegro.colorRgbToHtml 30 144 255   -- → "#1e90ff"
 ```
 let (l, a, b) ← Allegro.colorRgbToOklab 128 0 255
 ```
+
+## Pure API
+Every conversion here is a pure function of its arguments, so each is bound
+without `IO` in the `Color` namespace (`Color.hsvToRgb`, `Color.rgbToHsl`,
+`Color.hsv`, `Color.ofName`, …). The `color…` IO functions are `pure`
+wrappers over these and remain for existing code. Use the pure forms in hot
+loops; closed calls such as `Color.ofName "red"` can be hoisted by the
+compiler.
+```
+let sky : Color := Color.ofName "skyblue"
+let (h, s, l) := Color.rgbToHsl sky.r sky.g sky.b
+```
 -/
 namespace Allegro
 
@@ -35,11 +49,17 @@ def initColorAddon : IO Unit := pure ()
 
 /-- Find the closest CSS colour name for the given RGB values. -/
 @[extern "allegro_al_color_rgb_to_name"]
-opaque colorRgbToName : UInt32 → UInt32 → UInt32 → IO String
+opaque Color.rgbToName : UInt32 → UInt32 → UInt32 → String
+
+/-- Find the closest CSS colour name for the given RGB values. -/
+@[inline] def colorRgbToName (r g b : UInt32) : IO String := pure (Color.rgbToName r g b)
 
 /-- Convert RGB (0–255) to an HTML hex string like "#1e90ff". -/
 @[extern "allegro_al_color_rgb_to_html"]
-opaque colorRgbToHtml : UInt32 → UInt32 → UInt32 → IO String
+opaque Color.rgbToHtml : UInt32 → UInt32 → UInt32 → String
+
+/-- Convert RGB (0–255) to an HTML hex string like "#1e90ff". -/
+@[inline] def colorRgbToHtml (r g b : UInt32) : IO String := pure (Color.rgbToHtml r g b)
 
 -- ════════════════════════════════════════════════════════════════════
 -- Tuple-returning conversions  (single FFI call → full result)
@@ -49,73 +69,115 @@ opaque colorRgbToHtml : UInt32 → UInt32 → UInt32 → IO String
 
 /-- Convert HSV (hue 0–360, s/v 0–1) to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_hsv_rgb"]
-opaque colorHsvToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.hsvToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert HSV (hue 0–360, s/v 0–1) to RGB (0–255) in one call. -/
+@[inline] def colorHsvToRgb (h s v : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.hsvToRgb h s v)
 
 /-- Convert RGB (0–255) to HSV (hue 0–360, s/v 0–1) in one call. -/
 @[extern "allegro_al_color_rgb_to_hsv"]
-opaque colorRgbToHsv : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToHsv : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to HSV (hue 0–360, s/v 0–1) in one call. -/
+@[inline] def colorRgbToHsv (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToHsv r g b)
 
 -- ── HSL ↔ RGB ──
 
 /-- Convert HSL (hue 0–360, s/l 0–1) to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_hsl_rgb"]
-opaque colorHslToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.hslToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert HSL (hue 0–360, s/l 0–1) to RGB (0–255) in one call. -/
+@[inline] def colorHslToRgb (h s l : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.hslToRgb h s l)
 
 /-- Convert RGB (0–255) to HSL (hue 0–360, s/l 0–1) in one call. -/
 @[extern "allegro_al_color_rgb_to_hsl"]
-opaque colorRgbToHsl : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToHsl : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to HSL (hue 0–360, s/l 0–1) in one call. -/
+@[inline] def colorRgbToHsl (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToHsl r g b)
 
 -- ── CMYK ↔ RGB ──
 
 /-- Convert CMYK (all 0–1) to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_cmyk_rgb"]
-opaque colorCmykToRgb : Float → Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.cmykToRgb : Float → Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert CMYK (all 0–1) to RGB (0–255) in one call. -/
+@[inline] def colorCmykToRgb (c m y k : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.cmykToRgb c m y k)
 
 /-- Convert RGB (0–255) to CMYK (all 0–1) in one call. -/
 @[extern "allegro_al_color_rgb_to_cmyk"]
-opaque colorRgbToCmyk : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float × Float)
+opaque Color.rgbToCmyk : UInt32 → UInt32 → UInt32 → Float × Float × Float × Float
+
+/-- Convert RGB (0–255) to CMYK (all 0–1) in one call. -/
+@[inline] def colorRgbToCmyk (r g b : UInt32) : IO (Float × Float × Float × Float) := pure (Color.rgbToCmyk r g b)
 
 -- ── YUV ↔ RGB ──
 
 /-- Convert YUV to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_yuv_rgb"]
-opaque colorYuvToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.yuvToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert YUV to RGB (0–255) in one call. -/
+@[inline] def colorYuvToRgb (y u v : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.yuvToRgb y u v)
 
 /-- Convert RGB (0–255) to YUV in one call. -/
 @[extern "allegro_al_color_rgb_to_yuv"]
-opaque colorRgbToYuv : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToYuv : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to YUV in one call. -/
+@[inline] def colorRgbToYuv (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToYuv r g b)
 
 -- ── Named CSS colours ──
 
 /-- Get RGB (0–255) of a named colour (e.g. "dodgerblue") in one call. -/
 @[extern "allegro_al_color_name_rgb"]
-opaque colorNameToRgb : @& String → IO (UInt32 × UInt32 × UInt32)
+opaque Color.nameToRgb : @& String → UInt32 × UInt32 × UInt32
+
+/-- Get RGB (0–255) of a named colour (e.g. "dodgerblue") in one call. -/
+@[inline] def colorNameToRgb (name : String) : IO (UInt32 × UInt32 × UInt32) := pure (Color.nameToRgb name)
 
 -- ── HTML hex strings ──
 
 /-- Parse an HTML colour string (e.g. "#1e90ff") and return (r, g, b) 0–255. -/
 @[extern "allegro_al_color_html_rgb"]
-opaque colorHtmlToRgb : @& String → IO (UInt32 × UInt32 × UInt32)
+opaque Color.htmlToRgb : @& String → UInt32 × UInt32 × UInt32
+
+/-- Parse an HTML colour string (e.g. "#1e90ff") and return (r, g, b) 0–255. -/
+@[inline] def colorHtmlToRgb (html : String) : IO (UInt32 × UInt32 × UInt32) := pure (Color.htmlToRgb html)
 
 -- ── OkLab ↔ RGB ──
 
 /-- Convert OkLab to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_oklab_rgb"]
-opaque colorOklabToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.oklabToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert OkLab to RGB (0–255) in one call. -/
+@[inline] def colorOklabToRgb (l a b : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.oklabToRgb l a b)
 
 /-- Convert RGB (0–255) to OkLab in one call. -/
 @[extern "allegro_al_color_rgb_to_oklab"]
-opaque colorRgbToOklab : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToOklab : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to OkLab in one call. -/
+@[inline] def colorRgbToOklab (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToOklab r g b)
 
 -- ── Linear sRGB ↔ RGB ──
 
 /-- Convert linear-light RGB (0–1) to sRGB (0–255) in one call. -/
 @[extern "allegro_al_color_linear_rgb"]
-opaque colorLinearToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.linearToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert linear-light RGB (0–1) to sRGB (0–255) in one call. -/
+@[inline] def colorLinearToRgb (r g b : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.linearToRgb r g b)
 
 /-- Convert sRGB (0–255) to linear-light RGB (0–1) in one call. -/
 @[extern "allegro_al_color_rgb_to_linear"]
-opaque colorRgbToLinear : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToLinear : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert sRGB (0–255) to linear-light RGB (0–1) in one call. -/
+@[inline] def colorRgbToLinear (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToLinear r g b)
 
 -- ── Version ──
 
@@ -127,106 +189,224 @@ opaque getColorVersion : IO UInt32
 
 /-- Convert CIE XYZ to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_xyz_rgb"]
-opaque colorXyzToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.xyzToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert CIE XYZ to RGB (0–255) in one call. -/
+@[inline] def colorXyzToRgb (x y z : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.xyzToRgb x y z)
 
 /-- Convert RGB (0–255) to CIE XYZ in one call. -/
 @[extern "allegro_al_color_rgb_to_xyz"]
-opaque colorRgbToXyz : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToXyz : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to CIE XYZ in one call. -/
+@[inline] def colorRgbToXyz (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToXyz r g b)
 
 -- ── L*a*b* ↔ RGB ──
 
 /-- Convert CIE L*a*b* to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_lab_rgb"]
-opaque colorLabToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.labToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert CIE L*a*b* to RGB (0–255) in one call. -/
+@[inline] def colorLabToRgb (l a b : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.labToRgb l a b)
 
 /-- Convert RGB (0–255) to CIE L*a*b* in one call. -/
 @[extern "allegro_al_color_rgb_to_lab"]
-opaque colorRgbToLab : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToLab : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to CIE L*a*b* in one call. -/
+@[inline] def colorRgbToLab (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToLab r g b)
 
 -- ── xyY ↔ RGB ──
 
 /-- Convert CIE xyY to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_xyy_rgb"]
-opaque colorXyyToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.xyyToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert CIE xyY to RGB (0–255) in one call. -/
+@[inline] def colorXyyToRgb (x y y2 : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.xyyToRgb x y y2)
 
 /-- Convert RGB (0–255) to CIE xyY in one call. -/
 @[extern "allegro_al_color_rgb_to_xyy"]
-opaque colorRgbToXyy : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToXyy : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to CIE xyY in one call. -/
+@[inline] def colorRgbToXyy (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToXyy r g b)
 
 -- ── LCH ↔ RGB ──
 
 /-- Convert CIE LCH to RGB (0–255) in one call. -/
 @[extern "allegro_al_color_lch_rgb"]
-opaque colorLchToRgb : Float → Float → Float → IO (UInt32 × UInt32 × UInt32)
+opaque Color.lchToRgb : Float → Float → Float → UInt32 × UInt32 × UInt32
+
+/-- Convert CIE LCH to RGB (0–255) in one call. -/
+@[inline] def colorLchToRgb (l c h : Float) : IO (UInt32 × UInt32 × UInt32) := pure (Color.lchToRgb l c h)
 
 /-- Convert RGB (0–255) to CIE LCH in one call. -/
 @[extern "allegro_al_color_rgb_to_lch"]
-opaque colorRgbToLch : UInt32 → UInt32 → UInt32 → IO (Float × Float × Float)
+opaque Color.rgbToLch : UInt32 → UInt32 → UInt32 → Float × Float × Float
+
+/-- Convert RGB (0–255) to CIE LCH in one call. -/
+@[inline] def colorRgbToLch (r g b : UInt32) : IO (Float × Float × Float) := pure (Color.rgbToLch r g b)
 
 -- ── Colour distance ──
 
 /-- Compute the CIEDE2000 perceptual distance between two RGB colours. -/
 @[extern "allegro_al_color_distance_ciede2000"]
-opaque colorDistanceCiede2000 : UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → IO Float
+opaque Color.distanceCiede2000 : UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → Float
+
+/-- Compute the CIEDE2000 perceptual distance between two RGB colours. -/
+@[inline] def colorDistanceCiede2000 (r1 g1 b1 r2 g2 b2 : UInt32) : IO Float := pure (Color.distanceCiede2000 r1 g1 b1 r2 g2 b2)
 
 -- ── Colour validity ──
 
 /-- Check if a colour (r, g, b, a in 0.0–1.0) has valid premultiplied alpha values.
     Returns 1 if valid. -/
 @[extern "allegro_al_is_color_valid"]
-opaque isColorValid : Float → Float → Float → Float → IO UInt32
+opaque Color.isValid : Float → Float → Float → Float → UInt32
+
+/-- Check if a colour (r, g, b, a in 0.0–1.0) has valid premultiplied alpha values.
+    Returns 1 if valid. -/
+@[inline] def isColorValid (r g b a : Float) : IO UInt32 := pure (Color.isValid r g b a)
 
 -- ════════════════════════════════════════════════════════════════════
 -- Convenience constructors  (colour-space → RGBA 0–255)
--- Each constructs an ALLEGRO_COLOR and decomposes it to (r, g, b, a).
+-- Each constructs an ALLEGRO_COLOR and decomposes it to one `Color`;
+-- the names without the `Rgba` suffix project that to an `(r, g, b, a)` tuple.
+-- The `Color.*` constructors are pure (the shim reads no global state);
+-- the `color…Rgba` names are `IO` wrappers over them.
 -- ════════════════════════════════════════════════════════════════════
 
 /-- Construct an RGBA colour from HSV (hue 0–360, s/v 0–1). -/
 @[extern "allegro_al_color_hsv"]
-opaque colorHsv : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.hsv : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from HSV (hue 0–360, s/v 0–1). -/
+@[inline] def colorHsvRgba (h s v : Float) : IO Color := pure (Color.hsv h s v)
+
+/-- Construct an RGBA colour from HSV (hue 0–360, s/v 0–1) as `(r, g, b, a)`. -/
+@[inline] def colorHsv (h s v : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorHsvRgba h s v).toTuple
 
 /-- Construct an RGBA colour from HSL (hue 0–360, s/l 0–1). -/
 @[extern "allegro_al_color_hsl"]
-opaque colorHsl : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.hsl : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from HSL (hue 0–360, s/l 0–1). -/
+@[inline] def colorHslRgba (h s l : Float) : IO Color := pure (Color.hsl h s l)
+
+/-- Construct an RGBA colour from HSL (hue 0–360, s/l 0–1) as `(r, g, b, a)`. -/
+@[inline] def colorHsl (h s l : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorHslRgba h s l).toTuple
 
 /-- Construct an RGBA colour from CMYK (all 0–1). -/
 @[extern "allegro_al_color_cmyk"]
-opaque colorCmyk : Float → Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.cmyk : Float → Float → Float → Float → Color
+
+/-- Construct an RGBA colour from CMYK (all 0–1). -/
+@[inline] def colorCmykRgba (c m y k : Float) : IO Color := pure (Color.cmyk c m y k)
+
+/-- Construct an RGBA colour from CMYK (all 0–1) as `(r, g, b, a)`. -/
+@[inline] def colorCmyk (c m y k : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorCmykRgba c m y k).toTuple
 
 /-- Construct an RGBA colour from YUV. -/
 @[extern "allegro_al_color_yuv"]
-opaque colorYuv : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.yuv : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from YUV. -/
+@[inline] def colorYuvRgba (y u v : Float) : IO Color := pure (Color.yuv y u v)
+
+/-- Construct an RGBA colour from YUV as `(r, g, b, a)`. -/
+@[inline] def colorYuv (y u v : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorYuvRgba y u v).toTuple
 
 /-- Construct an RGBA colour from a CSS colour name (e.g. "dodgerblue"). -/
 @[extern "allegro_al_color_name_rgba"]
-opaque colorName : @& String → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.ofName : @& String → Color
+
+/-- Construct an RGBA colour from a CSS colour name (e.g. "dodgerblue"). -/
+@[inline] def colorNameRgba (name : String) : IO Color := pure (Color.ofName name)
+
+/-- Construct an RGBA colour from a CSS colour name (e.g. "dodgerblue") as `(r, g, b, a)`. -/
+@[inline] def colorName (name : String) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorNameRgba name).toTuple
 
 /-- Construct an RGBA colour from an HTML hex string (e.g. "#1e90ff"). -/
 @[extern "allegro_al_color_html_rgba"]
-opaque colorHtml : @& String → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.ofHtml : @& String → Color
+
+/-- Construct an RGBA colour from an HTML hex string (e.g. "#1e90ff"). -/
+@[inline] def colorHtmlRgba (html : String) : IO Color := pure (Color.ofHtml html)
+
+/-- Construct an RGBA colour from an HTML hex string (e.g. "#1e90ff") as `(r, g, b, a)`. -/
+@[inline] def colorHtml (html : String) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorHtmlRgba html).toTuple
 
 /-- Construct an RGBA colour from CIE XYZ. -/
 @[extern "allegro_al_color_xyz"]
-opaque colorXyz : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.xyz : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from CIE XYZ. -/
+@[inline] def colorXyzRgba (x y z : Float) : IO Color := pure (Color.xyz x y z)
+
+/-- Construct an RGBA colour from CIE XYZ as `(r, g, b, a)`. -/
+@[inline] def colorXyz (x y z : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorXyzRgba x y z).toTuple
 
 /-- Construct an RGBA colour from CIE L*a*b*. -/
 @[extern "allegro_al_color_lab"]
-opaque colorLab : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.lab : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from CIE L*a*b*. -/
+@[inline] def colorLabRgba (l a b : Float) : IO Color := pure (Color.lab l a b)
+
+/-- Construct an RGBA colour from CIE L*a*b* as `(r, g, b, a)`. -/
+@[inline] def colorLab (l a b : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorLabRgba l a b).toTuple
 
 /-- Construct an RGBA colour from CIE xyY. -/
 @[extern "allegro_al_color_xyy"]
-opaque colorXyy : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.xyy : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from CIE xyY. -/
+@[inline] def colorXyyRgba (x y y2 : Float) : IO Color := pure (Color.xyy x y y2)
+
+/-- Construct an RGBA colour from CIE xyY as `(r, g, b, a)`. -/
+@[inline] def colorXyy (x y y2 : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorXyyRgba x y y2).toTuple
 
 /-- Construct an RGBA colour from CIE LCH. -/
 @[extern "allegro_al_color_lch"]
-opaque colorLch : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.lch : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from CIE LCH. -/
+@[inline] def colorLchRgba (l c h : Float) : IO Color := pure (Color.lch l c h)
+
+/-- Construct an RGBA colour from CIE LCH as `(r, g, b, a)`. -/
+@[inline] def colorLch (l c h : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorLchRgba l c h).toTuple
 
 /-- Construct an RGBA colour from OkLab. -/
 @[extern "allegro_al_color_oklab"]
-opaque colorOklab : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.oklab : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from OkLab. -/
+@[inline] def colorOklabRgba (l a b : Float) : IO Color := pure (Color.oklab l a b)
+
+/-- Construct an RGBA colour from OkLab as `(r, g, b, a)`. -/
+@[inline] def colorOklab (l a b : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorOklabRgba l a b).toTuple
 
 /-- Construct an RGBA colour from linear-light RGB (0–1). -/
 @[extern "allegro_al_color_linear"]
-opaque colorLinear : Float → Float → Float → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque Color.linear : Float → Float → Float → Color
+
+/-- Construct an RGBA colour from linear-light RGB (0–1). -/
+@[inline] def colorLinearRgba (r g b : Float) : IO Color := pure (Color.linear r g b)
+
+/-- Construct an RGBA colour from linear-light RGB (0–1) as `(r, g, b, a)`. -/
+@[inline] def colorLinear (r g b : Float) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← colorLinearRgba r g b).toTuple
 
 end Allegro
@@ -71,6 +71,15 @@ def centre : TextAlign := ⟨1⟩
 def right : TextAlign := ⟨2⟩
 /-- Snap text drawing to integer coordinates. Combine with `|||`. -/
 def integer : TextAlign := ⟨4⟩
+
+/-- Pen position for text `advance` pixels wide drawn at `(x, y)`, as
+    `al_draw_text` computes it: centring subtracts half the advance in whole
+    pixels, and `integer` floors the result. -/
+def penOrigin (align : TextAlign) (advance x y : Float) : Float × Float :=
+  let a := align.val
+  let x := if a &&& centre.val != 0 then x - (advance.toUInt32 / 2).toFloat
+    else if a &&& right.val != 0 then x - advance else x
+  if a &&& integer.val != 0 then (x.floor, y.floor) else (x, y)
 end TextAlign
 
 -- ── Font creation / loading / destruction ──
@@ -174,9 +183,13 @@ opaque getFontRanges : Font → Int32 → IO UInt32
 @[extern "allegro_al_get_ustr_width"]
 opaque getUstrWidth : Font → UInt64 → IO UInt32
 
-/-- Get the full text bounding box as `(x, y, w, h)` in one call. -/
+/-- Get the full text bounding box as one `Rect`. -/
 @[extern "allegro_al_get_text_dimensions"]
-opaque getTextDimensions : Font → @& String → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque getTextBounds : Font → @& String → IO Rect
+
+/-- Get the full text bounding box as `(x, y, w, h)` in one call. -/
+@[inline] def getTextDimensions (font : Font) (text : String) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← getTextBounds font text).toTuple
 
 -- ── Fallback font ──
 
@@ -206,14 +219,23 @@ def getFallbackFont? (font : Font) : IO (Option Font) := liftOption (getFallback
 
 -- ── Additional queries ──
 
-/-- Get the full ustr bounding box as `(x, y, w, h)` in one call. -/
+/-- Get the full ustr bounding box as one `Rect`. -/
 @[extern "allegro_al_get_ustr_dimensions"]
-opaque getUstrDimensions : Font → UInt64 → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque getUstrBounds : Font → UInt64 → IO Rect
+
+/-- Get the full ustr bounding box as `(x, y, w, h)` in one call. -/
+@[inline] def getUstrDimensions (font : Font) (ustr : UInt64) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← getUstrBounds font ustr).toTuple
+
+/-- Get the bounding box for a single glyph as one `Rect`.
+    All fields are 0 if the glyph is not in the font. -/
+@[extern "allegro_al_get_glyph_dimensions"]
+opaque getGlyphBounds : Font → Int32 → IO Rect
 
 /-- Get the bounding box for a single glyph as `(x, y, w, h)`.
     Returns `(0,0,0,0)` if the glyph is not in the font. -/
-@[extern "allegro_al_get_glyph_dimensions"]
-opaque getGlyphDimensions : Font → Int32 → IO (UInt32 × UInt32 × UInt32 × UInt32)
+@[inline] def getGlyphDimensions (font : Font) (codepoint : Int32) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← getGlyphBounds font codepoint).toTuple
 
 @[extern "allegro_al_draw_justified_ustr_rgb"]
 private opaque drawJustifiedUstrRgbRaw : Font → UInt32 → UInt32 → UInt32 → Float → Float → Float → Float → UInt32 → UInt64 → IO Unit
@@ -241,12 +263,45 @@ opaque getFontVersion : IO UInt32
 
 -- ── Glyph info (UNSTABLE) ──
 
+/-- Glyph information as returned by `al_get_glyph`: the sub-rectangle of the
+    glyph page `bitmap`, plus placement metrics.
+
+    Scalar layout (see `mk_glyph_info`): `bitmap`@0, then the `Int32` fields
+    at 8, 12, … 36 in declaration order (40 bytes). -/
+structure GlyphInfo where
+  /-- Glyph page bitmap handle (0 if the glyph has no image). -/
+  bitmap  : UInt64
+  /-- Left edge of the glyph within `bitmap`. -/
+  x       : Int32
+  /-- Top edge of the glyph within `bitmap`. -/
+  y       : Int32
+  /-- Glyph width in pixels. -/
+  w       : Int32
+  /-- Glyph height in pixels. -/
+  h       : Int32
+  /-- Kerning adjustment against the previous codepoint (0 here). -/
+  kerning : Int32
+  /-- Horizontal drawing offset. -/
+  offsetX : Int32
+  /-- Vertical drawing offset. -/
+  offsetY : Int32
+  /-- Pen advance to the next glyph. -/
+  advance : Int32
+  deriving BEq, Repr, Inhabited
+
+/-- Retrieve glyph information for a codepoint as one `GlyphInfo`.
+    All fields are 0 if the font or glyph is invalid. -/
+@[extern "allegro_al_get_glyph"]
+opaque getGlyphInfo : Font → UInt32 → IO GlyphInfo
+
 /-- Retrieve glyph information for a codepoint. Returns a tuple:
     `(bitmap, x, y, w, h, kerning, offset_x, offset_y, advance)`
     where `bitmap` is a Bitmap handle (UInt64), all others are UInt32.
     Returns all-zeros if the font or glyph is invalid. -/
-@[extern "allegro_al_get_glyph"]
-opaque getGlyph : Font → UInt32 → IO (UInt64 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32)
+@[inline] def getGlyph (font : Font) (codepoint : UInt32) : IO (UInt64 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32) := do
+  let g ← getGlyphInfo font codepoint
+  return (g.bitmap, g.x.toUInt32, g.y.toUInt32, g.w.toUInt32, g.h.toUInt32,
+          g.kerning.toUInt32, g.offsetX.toUInt32, g.offsetY.toUInt32, g.advance.toUInt32)
 
 -- ── Multiline text iteration (callback-collecting) ──
 
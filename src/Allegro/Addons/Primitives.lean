@@ -1,4 +1,7 @@
 import Allegro.Core.System
+import Allegro.Core.Blending
+import Allegro.Pack
+import Allegro.Vec2
 
 /-!
 Primitives addon bindings for Allegro 5.
@@ -14,7 +17,9 @@ All colour-accepting functions use an RGB triplet
 Array-based functions (polyline, polygon, ribbon) accept a `ByteArray`
 containing packed little-endian 32-bit floats, where each consecutive pair
 of floats is an (x, y) coordinate. Use the `packPoints` helper to build
-these from a list of `(Float × Float)` pairs.
+these from a list of `(Float × Float)` pairs, or keep points in a
+`Vec2Array` (already in this layout) and use the `drawPolyline` /
+`drawPolygon` / `drawFilledPolygon` / `drawRibbon` overloads.
 
 ## Quick start
 ```
@@ -249,12 +254,12 @@ opaque drawSplineRgb : Float → Float → Float → Float → Float → Float 
     Use `packPoints` to build this from coordinate pairs.
     `numSegments` is the number of interpolation segments (0 = one per point). -/
 @[extern "allegro_al_draw_ribbon_rgb"]
-opaque drawRibbonRgb : ByteArray → UInt32 → UInt32 → UInt32 → Float → UInt32 → IO Unit
+opaque drawRibbonRgb : @&ByteArray → UInt32 → UInt32 → UInt32 → Float → UInt32 → IO Unit
 
 -- ── Polyline ──
 
 @[extern "allegro_al_draw_polyline_rgb"]
-private opaque drawPolylineRgbRaw : ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → Float → Float → IO Unit
+private opaque drawPolylineRgbRaw : @&ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → Float → Float → IO Unit
 
 /-- Draw a polyline through the given points.
     `points` is a `ByteArray` of packed 32-bit floats `[x₁, y₁, x₂, y₂, …]`.
@@ -265,7 +270,7 @@ private opaque drawPolylineRgbRaw : ByteArray → UInt32 → UInt32 → UInt32 
 -- ── Polygon ──
 
 @[extern "allegro_al_draw_polygon_rgb"]
-private opaque drawPolygonRgbRaw : ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → Float → Float → IO Unit
+private opaque drawPolygonRgbRaw : @&ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → Float → Float → IO Unit
 
 /-- Draw an outlined polygon. `points` is a `ByteArray` of packed 32-bit floats
     `[x₁, y₁, x₂, y₂, …]`. Uses `lineJoin*` for the join style. -/
@@ -275,7 +280,7 @@ private opaque drawPolygonRgbRaw : ByteArray → UInt32 → UInt32 → UInt32 
 /-- Draw a filled polygon. `points` is a `ByteArray` of packed 32-bit floats
     `[x₁, y₁, x₂, y₂, …]`. -/
 @[extern "allegro_al_draw_filled_polygon_rgb"]
-opaque drawFilledPolygonRgb : ByteArray → UInt32 → UInt32 → UInt32 → IO Unit
+opaque drawFilledPolygonRgb : @&ByteArray → UInt32 → UInt32 → UInt32 → IO Unit
 
 -- ── Vertex buffer management ──
 
@@ -295,6 +300,57 @@ opaque destroyVertexBuffer : VertexBuffer → IO Unit
 @[extern "allegro_al_get_vertex_buffer_size"]
 opaque getVertexBufferSize : VertexBuffer → IO UInt32
 
+-- ── Streaming vertex buffers ──
+
+/-- Opaque handle to a ring of streaming vertex buffers (see
+    `createStreamingVertexBuffer`). -/
+def StreamingVertexBuffer := UInt64
+
+instance : BEq StreamingVertexBuffer := inferInstanceAs (BEq UInt64)
+instance : Inhabited StreamingVertexBuffer := inferInstanceAs (Inhabited UInt64)
+instance : DecidableEq StreamingVertexBuffer := inferInstanceAs (DecidableEq UInt64)
+instance : OfNat StreamingVertexBuffer 0 := inferInstanceAs (OfNat UInt64 0)
+instance : ToString StreamingVertexBuffer := ⟨fun (h : UInt64) => s!"StreamingVertexBuffer#{h}"⟩
+instance : Repr StreamingVertexBuffer := ⟨fun (h : UInt64) _ => .text s!"StreamingVertexBuffer#{repr h}"⟩
+
+/-- The null streaming vertex buffer handle. -/
+def StreamingVertexBuffer.null : StreamingVertexBuffer := (0 : UInt64)
+
+/-- Where an append landed: draw vertices `start … start + count` of
+    `buffer`. `count = 0` means nothing was written.
+    Layout: buffer@0 (8 bytes), start@8, count@12. -/
+structure VertexRange where
+  /-- Vertex buffer holding the vertices (owned by the ring). -/
+  buffer : VertexBuffer
+  /-- First vertex. -/
+  start : UInt32
+  /-- Number of vertices. -/
+  count : UInt32
+  deriving BEq, Repr, Inhabited
+
+@[extern "allegro_create_streaming_vertex_buffer"]
+private opaque createStreamingVertexBufferRaw : VertexDecl → UInt32 → UInt32 → UInt32 → IO StreamingVertexBuffer
+
+/-- Create a ring of `ring` (1–8) stream-hinted vertex buffers of `capacity`
+    vertices each, for per-frame dynamic geometry. `decl` is 0 for the
+    built-in `ALLEGRO_VERTEX` (stride 36) or a custom declaration with its
+    `stride` (e.g. `VertexLayout.stride`). Needs a current display.
+    Returns 0 on failure, including when `stride` does not match `decl`. -/
+@[inline] def createStreamingVertexBuffer (decl : VertexDecl) (stride capacity : UInt32) (ring : UInt32 := 3) : IO StreamingVertexBuffer :=
+  createStreamingVertexBufferRaw decl stride capacity ring
+
+/-- Destroy a streaming ring and all its buffers. -/
+@[extern "allegro_destroy_streaming_vertex_buffer"]
+opaque destroyStreamingVertexBuffer : StreamingVertexBuffer → IO Unit
+
+/-- Copy packed vertices into the ring and return where they landed. The
+    bytes are `memcpy`d into a write-only locked range of the current
+    buffer; when they do not fit, the ring moves to its next buffer and
+    starts over, so the GPU never waits on a buffer still being drawn.
+    Returns `count = 0` if `vertices` is empty or larger than one buffer. -/
+@[extern "allegro_streaming_vertex_buffer_append"]
+opaque streamingVertexBufferAppend : StreamingVertexBuffer → @&ByteArray → IO VertexRange
+
 -- ── Index buffer management ──
 
 @[extern "allegro_al_create_index_buffer"]
@@ -331,6 +387,11 @@ private opaque drawIndexedBufferRaw : VertexBuffer → UInt64 → IndexBuffer 
 @[inline] def drawIndexedBuffer (vb : VertexBuffer) (texture : UInt64) (ib : IndexBuffer) (start stop : UInt32) (primType : PrimType) : IO UInt32 :=
   drawIndexedBufferRaw vb texture ib start stop primType.val
 
+/-- Draw a range returned by `streamingVertexBufferAppend`. -/
+@[inline] def drawVertexRange (r : VertexRange) (texture : UInt64) (primType : PrimType) : IO UInt32 :=
+  if r.count == 0 then pure 0
+  else drawVertexBuffer r.buffer texture r.start (r.start + r.count) primType
+
 -- ── Vertex / index buffer locking ──
 
 @[extern "allegro_al_lock_vertex_buffer"]
@@ -484,6 +545,17 @@ private opaque drawIndexedPrimBARaw : @&ByteArray → VertexDecl → UInt64 →
 @[inline] def drawIndexedPrimBA (data : ByteArray) (decl : VertexDecl) (texture : UInt64) (indices : Array UInt32) (numVtx : UInt32) (primType : PrimType) : IO UInt32 :=
   drawIndexedPrimBARaw data decl texture indices numVtx primType.val
 
+@[extern "allegro_al_draw_indexed_prim_packed"]
+private opaque drawIndexedPrimPackedRaw : @&ByteArray → VertexDecl → UInt64 → @&ByteArray → UInt32 → IO UInt32
+
+/-- Like `drawIndexedPrimBA`, but `indices` is a `ByteArray` of packed
+    `int32` (see `packIndices`), passed to `al_draw_indexed_prim` in place
+    with no per-call conversion. All `indices.size / 4` indices are used;
+    nothing is drawn (and `0` is returned) if any of them is not below the
+    number of vertices in `data`. Returns the number of primitives drawn. -/
+@[inline] def drawIndexedPrimPacked (data : ByteArray) (decl : VertexDecl) (texture : UInt64) (indices : ByteArray) (primType : PrimType) : IO UInt32 :=
+  drawIndexedPrimPackedRaw data decl texture indices primType.val
+
 -- ══════════════════════════════════════════════════════════════════
 -- Calculation functions (return ByteArray of packed floats)
 -- ══════════════════════════════════════════════════════════════════
@@ -515,7 +587,9 @@ opaque calculateRibbon : @&ByteArray → Float → UInt32 → IO ByteArray
     - `vertices`: ByteArray of packed `(x, y)` float pairs for all vertices
     - `vertexCounts`: Array of UInt32 where each element is the vertex count for
       a contour — first contour is the outer boundary, remaining are holes
-    - `r`, `g`, `b`: fill colour (0-255) -/
+    - `r`, `g`, `b`: fill colour (0-255)
+    Draws nothing if `vertexCounts` is empty, contains 0, or asks for more
+    vertices than `vertices` holds. -/
 @[extern "allegro_al_draw_filled_polygon_with_holes"]
 opaque drawFilledPolygonWithHolesRgb : @&ByteArray → @&Array UInt32 → UInt32 → UInt32 → UInt32 → IO Unit
 
@@ -523,10 +597,29 @@ opaque drawFilledPolygonWithHolesRgb : @&ByteArray → @&Array UInt32 → UInt32
     - `vertices`: ByteArray of packed `(x, y)` float pairs
     - `vertexCounts`: Array of UInt32 where each element is a contour's vertex count
       (first = outer boundary, remaining = holes)
-    Returns `Array (UInt32 × UInt32 × UInt32)` of triangle vertex indices. -/
+    Returns `Array (UInt32 × UInt32 × UInt32)` of triangle vertex indices
+    (empty for the counts `drawFilledPolygonWithHolesRgb` rejects). -/
 @[extern "allegro_al_triangulate_polygon"]
 opaque triangulatePolygon : @&ByteArray → @&Array UInt32 → IO (Array (UInt32 × UInt32 × UInt32))
 
+@[extern "allegro_al_draw_filled_polygon_with_holes_packed"]
+private opaque drawFilledPolygonWithHolesPackedRaw : @&ByteArray → @&ByteArray → UInt32 → IO Unit
+
+/-- Packed-count variant of `drawFilledPolygonWithHolesRgb` (using the
+    colour's alpha): `vertexCounts` is a `ByteArray` of `int32` contour sizes
+    (see `packIndices`), used in place when it already ends with a `0`
+    terminator. Draws nothing if the counts ask for more vertices than
+    `vertices` holds. -/
+@[inline] def drawFilledPolygonWithHolesPacked (vertices vertexCounts : ByteArray) (c : Color) : IO Unit :=
+  drawFilledPolygonWithHolesPackedRaw vertices vertexCounts c.pack
+
+/-- Packed variant of `triangulatePolygon`: contour sizes are a `ByteArray`
+    of `int32`, and the result is a `ByteArray` of `int32` triangle indices
+    (three per triangle) that can go straight to `drawIndexedPrimPacked`.
+    Returns an empty array for invalid counts. -/
+@[extern "allegro_al_triangulate_polygon_packed"]
+opaque triangulatePolygonPacked : @&ByteArray → @&ByteArray → IO ByteArray
+
 -- ── Point packing helper ──
 
 /-- Pack an array of `Float` values into a `ByteArray` of packed 32-bit floats
@@ -540,6 +633,12 @@ def packPoints (pts : List (Float × Float)) : ByteArray :=
   let arr := pts.foldl (fun acc (x, y) => acc.push x |>.push y) #[]
   packFloats arr
 
+/-- Pack indices or contour sizes as little-endian `int32` for
+    `drawIndexedPrimPacked`, `drawFilledPolygonWithHolesPacked` and
+    `triangulatePolygonPacked`. Build once and reuse across frames. -/
+def packIndices (idx : Array UInt32) : ByteArray :=
+  idx.foldl Pack.u32 (ByteArray.emptyWithCapacity (idx.size * 4))
+
 
 -- 
 -- Color-accepting overloads
@@ -683,4 +782,356 @@ opaque drawFilledEllipseRgba : Float → Float → Float → Float → UInt32 
 @[inline] def drawFilledRoundedRectangleA (x1 y1 x2 y2 rx ry : Float) (c : Color) : IO Unit :=
   drawFilledRoundedRectangleRgba x1 y1 x2 y2 rx ry c.r c.g c.b c.a
 
+-- ════════════════════════════════════════════════════════════════════
+-- Sprite batches — many textured quads in one al_draw_prim
+-- ════════════════════════════════════════════════════════════════════
+
+/-- Packed per-sprite records for `drawSpriteBatch`.
+    Each record is 40 bytes, little-endian:
+    `sx sy sw sh dx dy scale rotation` as `f32`, then the tint as `u32`
+    (`r | g<<8 | b<<16 | a<<24`), then `FlipFlags` as `u32`. -/
+structure SpriteBatch where
+  /-- Encoded sprite records. -/
+  bytes : ByteArray := .empty
+  deriving Inhabited
+
+namespace SpriteBatch
+
+/-- Bytes per sprite record. -/
+def recordSize : Nat := 40
+
+/-- An empty batch. -/
+def empty : SpriteBatch := {}
+
+/-- An empty batch with room for `n` sprites. -/
+def withCapacity (n : Nat) : SpriteBatch := { bytes := ByteArray.emptyWithCapacity (n * recordSize) }
+
+/-- Number of sprites in the batch. -/
+@[inline] def size (b : SpriteBatch) : Nat := b.bytes.size / recordSize
+
+/-- Append a sprite: the atlas region `(sx, sy, sw, sh)` is drawn with its
+    centre at `(dx, dy)`, uniformly scaled by `scale` and rotated clockwise
+    by `rotation` radians about that centre, multiplied by `tint`. -/
+def add (b : SpriteBatch) (sx sy sw sh dx dy : Float) (scale : Float := 1.0)
+    (rotation : Float := 0.0) (tint : Color := Color.rgb 255 255 255)
+    (flip : FlipFlags := FlipFlags.none) : SpriteBatch :=
+  let d := Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 b.bytes sx) sy) sw) sh
+  let d := Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 d dx) dy) scale) rotation
+  { bytes := Pack.u32 (Pack.u32 d tint.pack) flip.val }
+
+end SpriteBatch
+
+@[extern "allegro_draw_sprite_batch"]
+private opaque drawSpriteBatchRaw : UInt64 → @&ByteArray → IO UInt32
+
+/-- Draw every sprite in `instances` from `atlas` with one `al_draw_prim`
+    call (two textured triangles per sprite). Gives the same result as
+    `drawTintedScaledRotatedBitmapRegion` per sprite with the pivot at the
+    region centre, but crosses the FFI and submits geometry once.
+    A trailing partial record is ignored. Returns the number of sprites drawn. -/
+@[inline] def drawSpriteBatch (atlas : UInt64) (instances : ByteArray) : IO UInt32 :=
+  drawSpriteBatchRaw atlas instances
+
+/-- Draw a `SpriteBatch` from `atlas`. See `drawSpriteBatch`. -/
+@[inline] def SpriteBatch.draw (b : SpriteBatch) (atlas : UInt64) : IO UInt32 :=
+  drawSpriteBatchRaw atlas b.bytes
+
+-- ════════════════════════════════════════════════════════════════════
+-- Shape batches — many untextured shapes in one al_draw_prim
+-- ════════════════════════════════════════════════════════════════════
+
+/-- Packed shape records for `drawShapeBatch`. Each record is a one-byte
+    opcode, `f32` geometry, then the colour as one `u32`
+    (`r | g<<8 | b<<16 | a<<24`); opcodes match `SB_*` in
+    `ffi/allegro_primitives.c`. -/
+structure ShapeBatch where
+  /-- Encoded shape records. -/
+  bytes : ByteArray := .empty
+  /-- Number of shapes recorded. -/
+  count : UInt32 := 0
+  deriving Inhabited
+
+namespace ShapeBatch
+
+/-- An empty batch. -/
+def empty : ShapeBatch := {}
+
+/-- An empty batch whose buffer is pre-sized to `bytes` bytes. -/
+def withCapacity (bytes : Nat) : ShapeBatch := { bytes := ByteArray.emptyWithCapacity bytes }
+
+@[inline] private def f32x4 (b : ByteArray) (p q r s : Float) : ByteArray :=
+  Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 b p) q) r) s
+
+@[inline] private def push (sb : ShapeBatch) (op : UInt8) (geom : ByteArray → ByteArray) (c : Color) : ShapeBatch :=
+  { bytes := Pack.u32 (geom (Pack.u8 sb.bytes op)) c.pack, count := sb.count + 1 }
+
+/-- Add a filled rectangle. -/
+def filledRectangle (sb : ShapeBatch) (x1 y1 x2 y2 : Float) (c : Color) : ShapeBatch :=
+  sb.push 1 (f32x4 · x1 y1 x2 y2) c
+
+/-- Add an outlined rectangle. `thickness ≤ 0` draws a one-pixel outline. -/
+def rectangle (sb : ShapeBatch) (x1 y1 x2 y2 : Float) (c : Color) (thickness : Float := 1.0) : ShapeBatch :=
+  sb.push 2 (fun b => Pack.f32 (f32x4 b x1 y1 x2 y2) thickness) c
+
+/-- Add a filled circle. -/
+def filledCircle (sb : ShapeBatch) (cx cy radius : Float) (c : Color) : ShapeBatch :=
+  sb.push 3 (fun b => Pack.f32 (Pack.f32 (Pack.f32 b cx) cy) radius) c
+
+/-- Add an outlined circle. `thickness ≤ 0` draws a one-pixel outline. -/
+def circle (sb : ShapeBatch) (cx cy radius : Float) (c : Color) (thickness : Float := 1.0) : ShapeBatch :=
+  sb.push 4 (f32x4 · cx cy radius thickness) c
+
+/-- Add a line segment. `thickness ≤ 0` draws a one-pixel line. -/
+def line (sb : ShapeBatch) (x1 y1 x2 y2 : Float) (c : Color) (thickness : Float := 1.0) : ShapeBatch :=
+  sb.push 5 (fun b => Pack.f32 (f32x4 b x1 y1 x2 y2) thickness) c
+
+/-- Add a single pixel at `(x, y)`. -/
+def point (sb : ShapeBatch) (x y : Float) (c : Color) : ShapeBatch :=
+  sb.push 6 (fun b => Pack.f32 (Pack.f32 b x) y) c
+
+end ShapeBatch
+
+@[extern "allegro_draw_shape_batch"]
+private opaque drawShapeBatchRaw : @&ByteArray → IO UInt32
+
+/-- Tessellate every shape in `shapes` into one triangle list and draw it
+    with a single `al_draw_prim`. Circle segment counts and unit-circle
+    tables are cached in the shim by radius, so repeated radii cost no
+    trigonometry. Stops at the first malformed record; returns the number
+    of shapes drawn. -/
+@[inline] def drawShapeBatch (shapes : ByteArray) : IO UInt32 :=
+  drawShapeBatchRaw shapes
+
+/-- Draw a `ShapeBatch`. See `drawShapeBatch`. -/
+@[inline] def ShapeBatch.draw (sb : ShapeBatch) : IO UInt32 :=
+  drawShapeBatchRaw sb.bytes
+
+-- ════════════════════════════════════════════════════════════════════
+-- Vec2Array — packed points passed through unchanged
+-- ════════════════════════════════════════════════════════════════════
+
+/-- A growable array of points stored as packed 32-bit float pairs
+    `[x₁, y₁, x₂, y₂, …]` — exactly the layout the primitives addon reads, so
+    `drawPolyline`, `drawPolygon`, `drawFilledPolygon`, `drawRibbon`,
+    `Vec2Array.calculateRibbon` and `Vec2Array.triangulate` pass it through
+    without conversion. `push` and `set` update the buffer in place when it
+    is uniquely referenced. Coordinates are narrowed to `f32` on write. -/
+structure Vec2Array where
+  /-- Packed little-endian `f32` pairs, 8 bytes per point. -/
+  data : ByteArray := .empty
+  deriving Inhabited
+
+namespace Vec2Array
+
+/-- An empty array. -/
+def empty : Vec2Array := {}
+
+/-- An empty array with room for `n` points. -/
+def withCapacity (n : Nat) : Vec2Array := ⟨ByteArray.emptyWithCapacity (n * 8)⟩
+
+/-- Number of points. -/
+@[inline] def size (a : Vec2Array) : Nat := a.data.size / 8
+
+/-- `true` if there are no points. -/
+@[inline] def isEmpty (a : Vec2Array) : Bool := a.data.size < 8
+
+/-- Append the point `(x, y)`. -/
+@[inline] def pushXY (a : Vec2Array) (x y : Float) : Vec2Array :=
+  ⟨Pack.f32 (Pack.f32 a.data x) y⟩
+
+/-- Append a point. -/
+@[inline] def push (a : Vec2Array) (v : Vec2) : Vec2Array := a.pushXY v.x v.y
+
+/-- Point `i`, or `Vec2.zero` if out of range. -/
+@[inline] def get (a : Vec2Array) (i : Nat) : Vec2 :=
+  ⟨Pack.readF32 a.data (8 * i), Pack.readF32 a.data (8 * i + 4)⟩
+
+/-- Replace point `i` (no-op if out of range). -/
+@[inline] def set (a : Vec2Array) (i : Nat) (v : Vec2) : Vec2Array :=
+  ⟨Pack.setF32 (Pack.setF32 a.data (8 * i) v.x) (8 * i + 4) v.y⟩
+
+/-- Build from an array of points. -/
+def ofArray (pts : Array Vec2) : Vec2Array :=
+  pts.foldl push (withCapacity pts.size)
+
+/-- Build from a list of `(x, y)` pairs. -/
+def ofList (pts : List (Float × Float)) : Vec2Array :=
+  pts.foldl (fun a (x, y) => a.pushXY x y) empty
+
+@[extern "allegro_pack_float_array"]
+private opaque packFloatArray : @& FloatArray → ByteArray
+
+/-- Build from interleaved coordinates `#[x₁, y₁, x₂, y₂, …]` held in a
+    `FloatArray` (unboxed doubles). The `f64 → f32` narrowing runs as one
+    bulk loop in the shim. A trailing odd coordinate is dropped. -/
+def ofFloatArray (xs : FloatArray) : Vec2Array :=
+  let b := packFloatArray xs
+  ⟨if b.size % 8 == 0 then b else b.extract 0 (b.size - 4)⟩
+
+/-- Unpack into an array of points. -/
+def toArray (a : Vec2Array) : Array Vec2 := Id.run do
+  let mut out := Array.mkEmpty a.size
+  for i in [0:a.size] do
+    out := out.push (a.get i)
+  return out
+
+end Vec2Array
+
+/-- Draw a polyline through `pts` with a Color. -/
+@[inline] def drawPolyline (pts : Vec2Array) (c : Color) (join : LineJoin) (cap : LineCap) (thickness miterLimit : Float) : IO Unit :=
+  drawPolylineRgb pts.data c.r c.g c.b join cap thickness miterLimit
+
+/-- Draw an outlined polygon through `pts` with a Color. -/
+@[inline] def drawPolygon (pts : Vec2Array) (c : Color) (join : LineJoin) (thickness miterLimit : Float) : IO Unit :=
+  drawPolygonRgb pts.data c.r c.g c.b join thickness miterLimit
+
+/-- Draw a filled polygon through `pts` with a Color. -/
+@[inline] def drawFilledPolygon (pts : Vec2Array) (c : Color) : IO Unit :=
+  drawFilledPolygonRgb pts.data c.r c.g c.b
+
+/-- Draw a ribbon through `pts` with a Color (`numSegments = 0`: one per point). -/
+@[inline] def drawRibbon (pts : Vec2Array) (c : Color) (thickness : Float) (numSegments : UInt32 := 0) : IO Unit :=
+  drawRibbonRgb pts.data c.r c.g c.b thickness numSegments
+
+namespace Vec2Array
+
+/-- `calculateRibbon` on packed points; the result is again a `Vec2Array`. -/
+@[inline] def calculateRibbon (pts : Vec2Array) (thickness : Float) (numSegments : UInt32) : IO Vec2Array := do
+  return ⟨← Allegro.calculateRibbon pts.data thickness numSegments⟩
+
+/-- Triangulate the polygon in `pts`; `vertexCounts` are packed `int32`
+    contour sizes (see `packIndices`), defaulting to one contour of every
+    point. Returns packed `int32` triangle indices, as
+    `triangulatePolygonPacked`. -/
+@[inline] def triangulate (pts : Vec2Array)
+    (vertexCounts : ByteArray := packIndices #[pts.size.toUInt32]) : IO ByteArray :=
+  triangulatePolygonPacked pts.data vertexCounts
+
+end Vec2Array
+
+-- ════════════════════════════════════════════════════════════════════
+-- Typed vertex layouts
+-- ════════════════════════════════════════════════════════════════════
+
+/-- A value that can be stored in one vertex attribute: its Allegro storage
+    format, byte width, and a packer. -/
+class VertexField (β : Type) where
+  /-- Allegro storage format for the attribute. -/
+  storage : PrimStorage
+  /-- Bytes written by `write`. -/
+  size : UInt32
+  /-- Append the value (little-endian). -/
+  write : ByteArray → β → ByteArray
+
+instance : VertexField Float where
+  storage := PrimStorage.float1
+  size := 4
+  write := Pack.f32
+
+instance : VertexField Vec2 where
+  storage := PrimStorage.float2
+  size := 8
+  write b v := Pack.f32 (Pack.f32 b v.x) v.y
+
+/-- Colours are stored as four floats — the layout Allegro uses for
+    `PrimAttr.color` regardless of the declared storage. -/
+instance : VertexField ColorF where
+  storage := PrimStorage.float4
+  size := 16
+  write b c := Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 b c.r) c.g) c.b) c.a
+
+/-- 0–255 colours are normalised to floats on write. -/
+instance : VertexField Color where
+  storage := PrimStorage.float4
+  size := 16
+  write b c :=
+    let f (x : UInt32) := x.toFloat / 255.0
+    Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 b (f c.r)) (f c.g)) (f c.b)) (f c.a)
+
+/-- Vertex layout of a Lean structure: the `ALLEGRO_VERTEX_ELEMENT` list,
+    stride, and a writer that appends one vertex. Build instances with
+    `VertexLayout.empty` and `VertexLayout.field`, one call per attribute:
+    ```
+    structure TexVertex where
+      pos : Vec2
+      uv  : Vec2
+      col : ColorF
+
+    instance : VertexLayout TexVertex :=
+      VertexLayout.empty
+        |>.field PrimAttr.position (·.pos)
+        |>.field PrimAttr.texCoordPixel (·.uv)
+        |>.field PrimAttr.color (·.col)
+    ```
+    Offsets and stride are computed from the `VertexField` sizes when the
+    instance is elaborated, and the writer is a chain of the fields'
+    `@[inline]` packers. Code taking `[VertexLayout α]` is specialised per
+    instance by the compiler, so appending a vertex makes no per-field
+    dynamic calls. -/
+class VertexLayout (α : Type) where
+  /-- `(attribute, storage, offset)` for `createVertexDecl`. -/
+  elements : Array (PrimAttr × PrimStorage × UInt32)
+  /-- Bytes per vertex. -/
+  stride : UInt32
+  /-- Append one vertex. -/
+  write : ByteArray → α → ByteArray
+
+namespace VertexLayout
+
+/-- A layout with no attributes. -/
+@[inline] def empty {α : Type} : VertexLayout α :=
+  { elements := #[], stride := 0, write := fun b _ => b }
+
+/-- Add an attribute read from each vertex with `get`, placed after the
+    existing ones. -/
+@[inline] def field {α β : Type} [VertexField β] (l : VertexLayout α) (attr : PrimAttr) (get : α → β) : VertexLayout α :=
+  { elements := l.elements.push (attr, VertexField.storage (β := β), l.stride)
+    stride := l.stride + VertexField.size (β := β)
+    write := fun b v => VertexField.write (l.write b v) (get v) }
+
+/-- Create the `ALLEGRO_VERTEX_DECL` for `α`. Call once and keep the handle;
+    destroy it with `destroyVertexDecl`. -/
+def createDecl (α : Type) [VertexLayout α] : IO VertexDecl :=
+  createVertexDecl (VertexLayout.elements (α := α)) (VertexLayout.stride (α := α))
+
+end VertexLayout
+
+/-- Vertices of one layout accumulated into a `ByteArray`, with the layout's
+    declaration. Fill it with `push`, draw it with `draw`, and `clear` it
+    for the next frame (which keeps the capacity of the last frame). -/
+structure VertexWriter (α : Type) where
+  /-- Declaration from `VertexLayout.createDecl`. -/
+  decl : VertexDecl
+  /-- Packed vertices. -/
+  bytes : ByteArray := .empty
+  /-- Vertices written. -/
+  count : UInt32 := 0
+
+namespace VertexWriter
+
+/-- A writer for `α` using an already created declaration. -/
+def new {α : Type} (decl : VertexDecl) (capacity : Nat := 0) [VertexLayout α] : VertexWriter α :=
+  { decl, bytes := ByteArray.emptyWithCapacity (capacity * (VertexLayout.stride (α := α)).toNat) }
+
+/-- Create the declaration for `α` and an empty writer. -/
+def create (α : Type) [VertexLayout α] (capacity : Nat := 0) : IO (VertexWriter α) := do
+  return VertexWriter.new (← VertexLayout.createDecl α) capacity
+
+/-- Append one vertex. -/
+@[specialize] def push {α : Type} [VertexLayout α] (w : VertexWriter α) (v : α) : VertexWriter α :=
+  { w with bytes := VertexLayout.write w.bytes v, count := w.count + 1 }
+
+/-- Drop all vertices, pre-sizing the buffer to the current size. -/
+def clear {α : Type} (w : VertexWriter α) : VertexWriter α :=
+  { w with bytes := ByteArray.emptyWithCapacity w.bytes.size, count := 0 }
+
+/-- Draw all vertices with `drawPrimBA`. -/
+@[inline] def draw {α : Type} (w : VertexWriter α) (texture : UInt64) (primType : PrimType) : IO UInt32 :=
+  drawPrimBA w.bytes w.decl texture 0 w.count primType
+
+/-- Destroy the declaration. -/
+@[inline] def destroy {α : Type} (w : VertexWriter α) : IO Unit := destroyVertexDecl w.decl
+
+end VertexWriter
+
 end Allegro
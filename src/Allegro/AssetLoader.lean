@@ -0,0 +1,320 @@
+import Allegro.Core
+import Allegro.Addons
+import Std.Data.HashMap
+
+/-!
+# Asynchronous asset loading
+
+An `AssetLoader` decodes bitmaps, samples, TTF fonts and audio streams on
+dedicated worker tasks so level transitions do not stall the game loop.
+
+* `load` queues a file and returns an id at once. Queued requests start in
+  priority order (higher first, FIFO among equals) on up to `maxWorkers`
+  workers, which are started on demand and exit when the queue is empty.
+* When a load finishes, the loader emits a user event on `source`
+  (`data1` = id, `data2` = `AssetStatus.code`). Register `source` with the
+  game's event queue and call `take` for the id (`completedStatus?` reports
+  whether it failed), or poll `takeFinished`
+  once per frame (e.g. from `runGameLoop`'s tick).
+* `cancel` drops a queued request, discards a finished one, or discards
+  the result of one that is still loading.
+* `progress` counts finished versus outstanding requests for a loading
+  screen.
+
+Bitmaps are decoded as `ALLEGRO_MEMORY_BITMAP` on the worker, which has no
+display (the worker thread's new-bitmap flags are restored after each load),
+and converted with `convertBitmap` by `take` / `takeFinished` on the calling
+thread — call those from the display thread so the result becomes a video
+bitmap. The other asset kinds need no conversion. The image, font /
+TTF and audio / acodec addons must be initialised before loading.
+
+## Example
+```
+let loader ← AssetLoader.create
+registerEventSource queue loader.source
+let bg ← loader.load "data/level2.png" (priority := 10)
+let music ← loader.load "data/level2.ogg" (.audioStream 4 2048)
+-- in the event loop:
+if let some id := loader.completedId? ev then
+  if let some h ← loader.take id then ...
+```
+-/
+namespace Allegro
+
+/-- What `AssetLoader.load` decodes a file as. -/
+inductive AssetKind where
+  /-- `loadBitmap`; decoded as a memory bitmap, converted on `take`. -/
+  | bitmap
+  /-- `loadSample`. -/
+  | sample
+  /-- `loadTtfFont path size flags`. -/
+  | ttfFont (size : Int32) (flags : UInt32 := 0)
+  /-- `loadAudioStream path bufferCount samples`. -/
+  | audioStream (bufferCount : UInt32 := 4) (samples : UInt32 := 2048)
+  deriving BEq, Repr, Inhabited
+
+/-- State of a request. Ids that were taken or cancelled are forgotten. -/
+inductive AssetStatus where
+  /-- Waiting for a free worker. -/
+  | queued
+  /-- Being decoded by a worker. -/
+  | loading
+  /-- Loaded; waiting for `take`. -/
+  | ready
+  /-- The loader returned 0 (missing file, unsupported format, addon not
+      initialised …); `take` returns `some 0`. -/
+  | failed
+  deriving BEq, Repr, Inhabited
+
+/-- Value of `data2` in completion events. -/
+def AssetStatus.code : AssetStatus → UInt64
+  | .queued => 0
+  | .loading => 1
+  | .ready => 2
+  | .failed => 3
+
+/-- Inverse of `AssetStatus.code`, e.g. for `eventGetUserData2` on a raw
+    completion `Event`. -/
+def AssetStatus.ofCode? : UInt64 → Option AssetStatus
+  | 0 => some .queued
+  | 1 => some .loading
+  | 2 => some .ready
+  | 3 => some .failed
+  | _ => none
+
+/-- Request counts for a loading screen. `finished` and `total` cover
+    requests since the loader was created or `resetProgress` was called,
+    excluding cancelled ones. -/
+structure AssetProgress where
+  /-- Requests waiting for a worker. -/
+  queued   : Nat
+  /-- Requests being decoded right now. -/
+  loading  : Nat
+  /-- Requests that completed (ready or failed), taken or not. -/
+  finished : Nat
+  /-- Requests issued, finished or not, minus cancelled ones. -/
+  total    : Nat
+  deriving Repr
+
+/-- Finished fraction in `[0, 1]` (1 when nothing was requested). -/
+def AssetProgress.fraction (p : AssetProgress) : Float :=
+  if p.total == 0 then 1.0 else p.finished.toFloat / p.total.toFloat
+
+private structure AssetEntry where
+  path       : String
+  kind       : AssetKind
+  priority   : Int
+  seq        : Nat
+  status     : AssetStatus
+  handle     : UInt64 := 0
+  /-- Cancelled while loading: the worker destroys the result. -/
+  dropResult : Bool := false
+  deriving Inhabited
+
+private structure LoaderState where
+  entries   : Std.HashMap UInt64 AssetEntry := {}
+  nextId    : UInt64 := 1
+  nextSeq   : Nat := 0
+  workers   : Nat := 0
+  submitted : Nat := 0
+  finished  : Nat := 0
+  cancelled : Nat := 0
+  closed    : Bool := false
+
+/-- Background loader; see the module documentation. -/
+structure AssetLoader where
+  /-- User event source announcing finished loads. -/
+  source     : EventSource
+  /-- Upper bound on concurrent worker tasks. -/
+  maxWorkers : Nat
+  state      : IO.Ref LoaderState
+
+namespace AssetLoader
+
+/-- Create a loader with at most `maxWorkers` workers (`0` = one less than
+    the CPU count, at least one). -/
+def create (maxWorkers : Nat := 0) : IO AssetLoader := do
+  let source ← initUserEventSource
+  let n := if maxWorkers == 0 then max 1 ((← getCpuCount).toNat - 1) else maxWorkers
+  return { source, maxWorkers := n, state := ← IO.mkRef {} }
+
+private def loadAsset (path : String) : AssetKind → IO UInt64
+  | .bitmap => do
+    -- New-bitmap flags are per thread and this worker has no display; the
+    -- thread's flags are restored so later work on it is unaffected.
+    let state ← createState
+    storeState state StateFlags.newBitmapParameters
+    try
+      setNewBitmapFlags BitmapFlags.memory
+      loadBitmap path
+    finally
+      restoreState state
+      destroyState state
+  | .sample => loadSample path
+  | .ttfFont size flags => loadTtfFont path size flags
+  | .audioStream n samples => loadAudioStream path n samples
+
+private def destroyAsset (kind : AssetKind) (h : UInt64) : IO Unit := do
+  if h == 0 then return
+  match kind with
+  | .bitmap => destroyBitmap h
+  | .sample => destroySample h
+  | .ttfFont .. => destroyFont h
+  | .audioStream .. => destroyAudioStream h
+
+/-- Highest-priority queued request, oldest first among equals. -/
+private def LoaderState.next? (s : LoaderState) : Option UInt64 :=
+  let best := s.entries.fold (init := (none : Option (Int × Nat × UInt64))) fun best id e =>
+    if e.status != .queued then best else
+    match best with
+    | some (p, q, _) => if e.priority > p || (e.priority == p && e.seq < q) then some (e.priority, e.seq, id) else best
+    | none => some (e.priority, e.seq, id)
+  best.map (·.2.2)
+
+private partial def workerLoop (l : AssetLoader) : IO Unit := do
+  let job ← l.state.modifyGet fun s =>
+    match s.next? with
+    | some id =>
+      let e := s.entries[id]!
+      (some (id, e.path, e.kind), { s with entries := s.entries.insert id { e with status := .loading } })
+    | none => (none, { s with workers := s.workers - 1 })
+  let some (id, path, kind) := job | return
+  let h ← try loadAsset path kind catch _ => pure 0
+  let status? ← l.state.modifyGet fun s =>
+    match s.entries[id]? with
+    | some e =>
+      if e.dropResult then (none, { s with entries := s.entries.erase id })
+      else
+        let st := if h != 0 then AssetStatus.ready else .failed
+        (some st, { s with entries := s.entries.insert id { e with status := st, handle := h },
+                           finished := s.finished + 1 })
+    | none => (none, s)
+  match status? with
+  | some st => discard <| emitUserEvent l.source id st.code 0 0
+  | none => destroyAsset kind h
+  workerLoop l
+
+/-- Queue `path` for loading and return its id (0 after `destroy`).
+    Higher `priority` starts first. -/
+def load (l : AssetLoader) (path : String) (kind : AssetKind := .bitmap) (priority : Int := 0) : IO UInt64 := do
+  let (id, spawn) ← l.state.modifyGet fun s =>
+    if s.closed then ((0, false), s) else
+    let id := s.nextId
+    let spawn := s.workers < l.maxWorkers
+    ((id, spawn), { s with
+      entries := s.entries.insert id { path, kind, priority, seq := s.nextSeq, status := .queued },
+      nextId := id + 1, nextSeq := s.nextSeq + 1, submitted := s.submitted + 1,
+      workers := if spawn then s.workers + 1 else s.workers })
+  if spawn then
+    let _ ← IO.asTask (workerLoop l) Task.Priority.dedicated
+  return id
+
+/-- Current state of `id`, or `none` if it was taken, cancelled or never
+    issued. -/
+def status (l : AssetLoader) (id : UInt64) : IO (Option AssetStatus) := do
+  let s ← l.state.get
+  return match s.entries[id]? with
+    | some e => if e.dropResult then none else some e.status
+    | none => none
+
+/-- Completed request id carried by `ev`, if it came from this loader. -/
+def completedId? (l : AssetLoader) (ev : EventData) : Option UInt64 :=
+  if ev.source == l.source then some ev.u64v else none
+
+/-- Outcome of the request completed by `ev` (`.ready` or `.failed`), if it
+    came from this loader and the id was not taken or cancelled since.
+    `EventData` carries only `data1`; this reads the loader's record instead,
+    which matches `data2` until the id is forgotten. With a raw `Event`, use
+    `AssetStatus.ofCode? (← eventGetUserData2 ev)`. -/
+def completedStatus? (l : AssetLoader) (ev : EventData) : IO (Option AssetStatus) :=
+  match l.completedId? ev with
+  | some id => l.status id
+  | none => pure none
+
+/-- Hand over a finished asset and forget `id`: `some handle` once it is
+    ready (bitmaps converted with `convertBitmap` first), `some 0` if it
+    failed, `none` while it is queued or loading, or if `id` is unknown.
+    The caller owns the handle. Call from the display thread. -/
+def take (l : AssetLoader) (id : UInt64) : IO (Option UInt64) := do
+  let r ← l.state.modifyGet fun s =>
+    match s.entries[id]? with
+    | some e =>
+      if e.status == .ready || e.status == .failed then
+        (some (e.handle, e.kind), { s with entries := s.entries.erase id })
+      else (none, s)
+    | none => (none, s)
+  let some (h, kind) := r | return none
+  if h != 0 && kind == .bitmap then convertBitmap h
+  return some h
+
+/-- `take` every finished request, returning `(id, handle)` pairs (handle
+    0 for failures). -/
+def takeFinished (l : AssetLoader) : IO (Array (UInt64 × UInt64)) := do
+  let ids := (← l.state.get).entries.fold (init := #[]) fun acc id e =>
+    if e.status == .ready || e.status == .failed then acc.push id else acc
+  let mut out := #[]
+  for id in ids do
+    if let some h ← l.take id then out := out.push (id, h)
+  return out
+
+/-- Cancel `id`: a queued request is dropped, a loading one is discarded
+    when it finishes, a ready one is destroyed. Returns `false` if `id` is
+    unknown. No completion event is sent for cancelled requests. -/
+def cancel (l : AssetLoader) (id : UInt64) : IO Bool := do
+  let r ← l.state.modifyGet fun s =>
+    match s.entries[id]? with
+    | none => (none, s)
+    | some e =>
+      if e.dropResult then (none, s) else
+      match e.status with
+      | .queued => (some (0, e.kind), { s with entries := s.entries.erase id, cancelled := s.cancelled + 1 })
+      | .loading => (some (0, e.kind), { s with entries := s.entries.insert id { e with dropResult := true },
+                                                cancelled := s.cancelled + 1 })
+      | _ => (some (e.handle, e.kind), { s with entries := s.entries.erase id })
+  let some (h, kind) := r | return false
+  destroyAsset kind h
+  return true
+
+/-- Counts for a loading screen. -/
+def progress (l : AssetLoader) : IO AssetProgress := do
+  let s ← l.state.get
+  let (queued, loading) := s.entries.fold (init := (0, 0)) fun (q, ld) _ e =>
+    match e.status with
+    | .queued => (q + 1, ld)
+    | .loading => (q, if e.dropResult then ld else ld + 1)
+    | _ => (q, ld)
+  return { queued, loading, finished := s.finished, total := s.submitted - s.cancelled }
+
+/-- Start a new progress period (e.g. per level): finished and cancelled
+    requests stop counting towards `progress`. -/
+def resetProgress (l : AssetLoader) : IO Unit :=
+  l.state.modify fun s =>
+    { s with submitted := s.submitted - s.finished - s.cancelled, finished := 0, cancelled := 0 }
+
+/-- Block until nothing is queued or loading (polls every `pollMs`). -/
+def waitIdle (l : AssetLoader) (pollMs : UInt32 := 1) : IO Unit := do
+  repeat
+    let p ← progress l
+    if p.queued + p.loading == 0 then break
+    IO.sleep pollMs
+
+/-- Cancel queued requests, wait for running loads, destroy results that
+    were never taken and the event source. -/
+def destroy (l : AssetLoader) : IO Unit := do
+  l.state.modify fun s =>
+    { s with closed := true,
+             entries := s.entries.filterMap fun _ e =>
+               match e.status with
+               | .queued => none
+               | .loading => some { e with dropResult := true }
+               | _ => some e }
+  while (← l.state.get).workers > 0 do
+    IO.sleep 1
+  for (_, e) in (← l.state.get).entries.toList do
+    destroyAsset e.kind e.handle
+  l.state.modify fun s => { s with entries := {} }
+  destroyUserEventSource l.source
+
+end AssetLoader
+
+end Allegro
@@ -0,0 +1,334 @@
+import Allegro.Core
+
+/-!
+# Texture atlases
+
+`buildAtlas` copies many small bitmaps into a few large pages and hands back
+a sub-bitmap of a page for each one. Drawing sub-bitmaps of the same page
+does not switch textures, so a frame's sprites batch under
+`al_hold_bitmap_drawing` (and `DrawList` / `SpriteBatch` runs) instead of
+flushing on every sprite.
+
+Placement is computed in pure Lean by `packAtlas`, a MaxRects packer
+(best-short-side fit, largest sprites first) that opens a new page whenever
+a sprite fits none of the open ones. Each sprite gets `extrude` pixels of its
+own edge repeated around it — so linear filtering and sub-pixel positions
+never sample a neighbour — and `padding` transparent pixels between
+neighbours.
+
+Inputs that are already sub-bitmaps (for example cut from a sprite sheet) are
+retargeted in place with `reparentBitmap`, so code holding those handles
+keeps working and starts batching. Allegro can only reparent sub-bitmaps;
+for plain bitmaps use the handle in `Atlas.sprites` instead.
+
+## Example
+```
+let atlas ← buildAtlas sprites { pageWidth := 1024, pageHeight := 1024 }
+let r := atlas.report
+IO.println s!"{r.pageCount} pages, {r.switchesBefore} → {r.switchesAfter} texture switches"
+-- draw with atlas.sprites[i]! in place of sprites[i]!
+atlas.destroy
+```
+
+Pages are created with the current new-bitmap flags and format, so they are
+video bitmaps by default; `buildAtlas` draws into them and must run on the
+display thread.
+-/
+namespace Allegro
+
+/-- Page size and spacing for `packAtlas` / `buildAtlas`. -/
+structure AtlasConfig where
+  /-- Page width in pixels. -/
+  pageWidth  : UInt32 := 2048
+  /-- Page height in pixels. -/
+  pageHeight : UInt32 := 2048
+  /-- Transparent pixels between neighbouring (extruded) sprites. -/
+  padding    : UInt32 := 2
+  /-- Edge pixels repeated around each sprite. -/
+  extrude    : UInt32 := 1
+  deriving Repr
+
+/-- Where one sprite was placed: page index and the sprite's own rectangle
+    on that page (padding and extrusion excluded). -/
+structure AtlasSlot where
+  /-- Index into `AtlasLayout` pages (and `Atlas.pages`). -/
+  page : Nat
+  /-- Left edge of the sprite on its page. -/
+  x    : UInt32
+  /-- Top edge of the sprite on its page. -/
+  y    : UInt32
+  /-- Sprite width (the input's own width). -/
+  w    : UInt32
+  /-- Sprite height (the input's own height). -/
+  h    : UInt32
+  deriving BEq, Repr, Inhabited
+
+/-- Result of `packAtlas`. -/
+structure AtlasLayout where
+  /-- One entry per input, in input order; `none` if the sprite (with its
+      extrusion) is larger than a page. -/
+  slots     : Array (Option AtlasSlot)
+  /-- Number of pages used. -/
+  pageCount : Nat
+  deriving Repr, Inhabited
+
+-- ── MaxRects packer ──
+
+/-- Rectangle in page pixels. -/
+private structure PackRect where
+  x : Nat
+  y : Nat
+  w : Nat
+  h : Nat
+  deriving BEq, Inhabited
+
+private def PackRect.intersects (a b : PackRect) : Bool :=
+  a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h
+
+/-- `a` contains `b`. -/
+private def PackRect.contains (a b : PackRect) : Bool :=
+  b.x ≥ a.x && b.y ≥ a.y && b.x + b.w ≤ a.x + a.w && b.y + b.h ≤ a.y + a.h
+
+/-- The parts of free rectangle `f` not covered by `n` (up to four,
+    overlapping each other). -/
+private def splitFree (f n : PackRect) : Array PackRect := Id.run do
+  if !f.intersects n then return #[f]
+  let mut out := #[]
+  if n.x > f.x then out := out.push { f with w := n.x - f.x }
+  if n.x + n.w < f.x + f.w then out := out.push { f with x := n.x + n.w, w := f.x + f.w - (n.x + n.w) }
+  if n.y > f.y then out := out.push { f with h := n.y - f.y }
+  if n.y + n.h < f.y + f.h then out := out.push { f with y := n.y + n.h, h := f.y + f.h - (n.y + n.h) }
+  return out
+
+/-- Drop free rectangles contained in another one (keeping one copy of
+    duplicates). -/
+private def pruneFree (fs : Array PackRect) : Array PackRect := Id.run do
+  let mut out := #[]
+  for i in [0:fs.size] do
+    let a := fs[i]!
+    let mut covered := false
+    for j in [0:fs.size] do
+      if i != j && fs[j]!.contains a && (a != fs[j]! || j < i) then
+        covered := true
+        break
+    if !covered then out := out.push a
+  return out
+
+/-- Best-short-side-fit position for a `w × h` block, with its score. -/
+private def bestFit (free : Array PackRect) (w h : Nat) : Option (PackRect × Nat × Nat) := Id.run do
+  let mut best : Option (PackRect × Nat × Nat) := none
+  for f in free do
+    if f.w ≥ w && f.h ≥ h then
+      let dw := f.w - w
+      let dh := f.h - h
+      let score := (min dw dh, max dw dh)
+      match best with
+      | some (_, s, l) => if score.1 < s || (score.1 == s && score.2 < l) then best := some ({ f with w := w, h := h }, score)
+      | none => best := some ({ f with w := w, h := h }, score)
+  return best
+
+/-- Place blocks in the given order: the best-scoring free rectangle over
+    all open pages (ties go to the earliest page), else a new page. -/
+private def packBlocks (pw ph : Nat) (blocks : Array (Nat × Nat × Nat)) :
+    Array (Nat × Option (Nat × PackRect)) × Nat := Id.run do
+  let mut pages : Array (Array PackRect) := #[]
+  let mut out := #[]
+  for (i, w, h) in blocks do
+    if w > pw || h > ph then
+      out := out.push (i, none)
+      continue
+    let mut placed : Option (Nat × PackRect) := none
+    let mut best : Nat × Nat := (0, 0)
+    for p in [0:pages.size] do
+      if let some (r, score) := bestFit pages[p]! w h then
+        if placed.isNone || score.1 < best.1 || (score.1 == best.1 && score.2 < best.2) then
+          placed := some (p, r)
+          best := score
+    if placed.isNone then
+      pages := pages.push #[{ x := 0, y := 0, w := pw, h := ph }]
+      placed := some (pages.size - 1, { x := 0, y := 0, w := w, h := h })
+    if let some (p, r) := placed then
+      pages := pages.set! p (pruneFree (pages[p]!.flatMap (splitFree · r)))
+    out := out.push (i, placed)
+  return (out, pages.size)
+
+/-- Lay out sprites of the given sizes on `cfg`-sized pages. Pure; the same
+    sizes always give the same layout. -/
+def packAtlas (cfg : AtlasConfig) (sizes : Array (UInt32 × UInt32)) : AtlasLayout := Id.run do
+  let e := cfg.extrude.toNat
+  let pad := cfg.padding.toNat
+  -- Each block is the sprite plus extrusion on all sides and padding on the
+  -- right and bottom; the page gets the same padding on its far edges.
+  let blocks := (sizes.mapIdx fun i (w, h) => (i, w.toNat + 2 * e + pad, h.toNat + 2 * e + pad))
+    |>.qsort fun (_, aw, ah) (_, bw, bh) => max aw ah > max bw bh || (max aw ah == max bw bh && aw * ah > bw * bh)
+  let (placed, pageCount) := packBlocks (cfg.pageWidth.toNat + pad) (cfg.pageHeight.toNat + pad) blocks
+  let mut slots : Array (Option AtlasSlot) := Array.replicate sizes.size none
+  for (i, p) in placed do
+    if let some (page, r) := p then
+      let (w, h) := sizes[i]!
+      slots := slots.set! i (some { page, x := (r.x + e).toUInt32, y := (r.y + e).toUInt32, w, h })
+  return { slots, pageCount }
+
+/-- Texture switches when drawing the inputs in `order` (indices into the
+    inputs; repeats allowed): first without an atlas, where every input is
+    its own texture, then with `layout`, where sprites on the same page share
+    one. Unpacked inputs stay separate textures. Each switch ends an
+    `al_hold_bitmap_drawing` batch, so these are the draw-call counts. -/
+def AtlasLayout.textureSwitches (l : AtlasLayout) (order : Array Nat) : Nat × Nat := Id.run do
+  let mut before := 0
+  let mut after := 0
+  let mut prev : Option Nat := none
+  let mut prevTex : Option (Nat ⊕ Nat) := none
+  for i in order do
+    let tex : Nat ⊕ Nat := match l.slots.getD i none with
+      | some s => .inl s.page
+      | none => .inr i
+    if prev != some i then before := before + 1
+    if prevTex != some tex then after := after + 1
+    prev := some i
+    prevTex := some tex
+  return (before, after)
+
+/-- Summary of an atlas layout. -/
+structure AtlasReport where
+  /-- Pages used. -/
+  pageCount      : Nat
+  /-- Per page, the fraction of its area covered by sprite pixels
+      (padding and extrusion excluded). -/
+  occupancy      : Array Float
+  /-- Inputs that did not fit on a page. -/
+  unpacked       : Nat
+  /-- Texture switches drawing every input once, in input order, without
+      the atlas. -/
+  switchesBefore : Nat
+  /-- The same with the atlas. -/
+  switchesAfter  : Nat
+  deriving Repr
+
+/-- Occupancy and texture-switch summary for `layout`. -/
+def AtlasLayout.report (l : AtlasLayout) (cfg : AtlasConfig) : AtlasReport := Id.run do
+  let mut used := Array.replicate l.pageCount 0
+  let mut unpacked := 0
+  for s in l.slots do
+    match s with
+    | some s => used := used.modify s.page (· + s.w.toNat * s.h.toNat)
+    | none => unpacked := unpacked + 1
+  let area := (cfg.pageWidth.toNat * cfg.pageHeight.toNat).toFloat
+  let (before, after) := l.textureSwitches (Array.range l.slots.size)
+  return { pageCount := l.pageCount, occupancy := used.map (·.toFloat / area), unpacked,
+           switchesBefore := before, switchesAfter := after }
+
+-- ── Building pages ──
+
+/-- Pages and per-input sprites produced by `buildAtlas`. -/
+structure Atlas where
+  /-- Page bitmaps, indexed by `AtlasSlot.page`. -/
+  pages    : Array Bitmap
+  /-- Per input: a sub-bitmap of its page, the input itself if it was
+      reparented, or 0 if it was not packed. -/
+  sprites  : Array Bitmap
+  /-- Per input: whether `sprites[i]` was created by `buildAtlas` (and is
+      destroyed by `Atlas.destroy`). -/
+  owned    : Array Bool
+  /-- The packing the pages were built from. -/
+  layout   : AtlasLayout
+  /-- The configuration passed to `buildAtlas`. -/
+  config   : AtlasConfig
+
+/-- Copy `b` (`w × h`) to `(x, y)` on the target bitmap and repeat its edge
+    pixels `e` times outwards. The blender must be a plain copy. -/
+private def copyExtruded (b : Bitmap) (x y w h e : Float) : IO Unit := do
+  drawBitmap b x y FlipFlags.none
+  let mut k := 1.0
+  while k ≤ e do
+    drawBitmapRegion b 0 0 1 h (x - k) y FlipFlags.none
+    drawBitmapRegion b (w - 1) 0 1 h (x + w - 1 + k) y FlipFlags.none
+    drawBitmapRegion b 0 0 w 1 x (y - k) FlipFlags.none
+    drawBitmapRegion b 0 (h - 1) w 1 x (y + h - 1 + k) FlipFlags.none
+    let mut j := 1.0
+    while j ≤ e do
+      drawBitmapRegion b 0 0 1 1 (x - k) (y - j) FlipFlags.none
+      drawBitmapRegion b (w - 1) 0 1 1 (x + w - 1 + k) (y - j) FlipFlags.none
+      drawBitmapRegion b 0 (h - 1) 1 1 (x - k) (y + h - 1 + j) FlipFlags.none
+      drawBitmapRegion b (w - 1) (h - 1) 1 1 (x + w - 1 + k) (y + h - 1 + j) FlipFlags.none
+      j := j + 1.0
+    k := k + 1.0
+
+/-- Pack `bitmaps` into atlas pages (see `packAtlas`), copy their pixels
+    and edge extrusion, and return a sprite handle per input.
+
+    With `retarget` (default), inputs that are sub-bitmaps are moved onto
+    the page with `reparentBitmap` and returned as themselves; other inputs
+    get a new sub-bitmap. The input bitmaps are otherwise untouched and may
+    be destroyed afterwards. If a page cannot be created, the sprites meant
+    for it are 0. If drawing throws, the pages created so far are destroyed
+    before the error is rethrown. Restores the target bitmap and blender. -/
+def buildAtlas (bitmaps : Array Bitmap) (cfg : AtlasConfig := {}) (retarget : Bool := true) : IO Atlas := do
+  let mut sizes : Array (UInt32 × UInt32) := Array.mkEmpty bitmaps.size
+  for b in bitmaps do
+    sizes := sizes.push (← getBitmapWidth b, ← getBitmapHeight b)
+  let layout := packAtlas cfg sizes
+  let e := cfg.extrude.toFloat
+  let state ← createState
+  storeState state (StateFlags.targetBitmap ||| StateFlags.blender)
+  -- A ref rather than a `let mut`: the `catch` handler must see the pages
+  -- created before the throw.
+  let created ← IO.mkRef (#[] : Array Bitmap)
+  try
+    for p in [0:layout.pageCount] do
+      let page ← createBitmap cfg.pageWidth cfg.pageHeight
+      created.modify (·.push page)
+      if page == 0 then continue
+      setTargetBitmap page
+      setBlender BlendOp.add BlendFactor.one BlendFactor.zero
+      clearToColorRgba 0 0 0 0
+      for i in [0:bitmaps.size] do
+        if let some s := layout.slots[i]! then
+          if s.page == p then
+            copyExtruded bitmaps[i]! s.x.toFloat s.y.toFloat s.w.toFloat s.h.toFloat e
+  catch err =>
+    restoreState state
+    for page in (← created.get) do
+      if page != 0 then destroyBitmap page
+    throw err
+  finally
+    restoreState state
+    destroyState state
+  let pages ← created.get
+  let mut sprites : Array Bitmap := Array.mkEmpty bitmaps.size
+  let mut owned : Array Bool := Array.mkEmpty bitmaps.size
+  for i in [0:bitmaps.size] do
+    let b := bitmaps[i]!
+    match layout.slots[i]! with
+    | some s =>
+      let page := pages[s.page]!
+      if page == 0 then
+        sprites := sprites.push 0
+        owned := owned.push false
+      else if retarget && (← isSubBitmap b) != 0 then
+        reparentBitmap b page (Int32.ofNat s.x.toNat) (Int32.ofNat s.y.toNat) (Int32.ofNat s.w.toNat) (Int32.ofNat s.h.toNat)
+        sprites := sprites.push b
+        owned := owned.push false
+      else
+        let sub ← createSubBitmap page (Int32.ofNat s.x.toNat) (Int32.ofNat s.y.toNat) (Int32.ofNat s.w.toNat) (Int32.ofNat s.h.toNat)
+        sprites := sprites.push sub
+        owned := owned.push (sub != 0)
+    | none =>
+      sprites := sprites.push 0
+      owned := owned.push false
+  return { pages, sprites, owned, layout, config := cfg }
+
+/-- Occupancy and texture-switch summary (see `AtlasLayout.report`). -/
+@[inline] def Atlas.report (a : Atlas) : AtlasReport :=
+  a.layout.report a.config
+
+/-- Destroy the sub-bitmaps created by `buildAtlas`, then the pages.
+    Reparented inputs still point into the pages: destroy them first or
+    stop drawing them. -/
+def Atlas.destroy (a : Atlas) : IO Unit := do
+  for i in [0:a.sprites.size] do
+    if a.owned[i]! then destroyBitmap a.sprites[i]!
+  for p in a.pages do
+    if p != 0 then destroyBitmap p
+
+end Allegro
@@ -0,0 +1,206 @@
+import Allegro.Core
+import Allegro.Addons
+import Std.Data.HashMap
+
+/-!
+# Decoded-bitmap cache
+
+`BitmapCache.acquire` returns the same decoded bitmap for every request of
+the same file, so scenes that share PNGs decode each one once.
+
+* Keys are canonical paths (`IO.FS.realPath`: absolute, `.`/`..` and
+  symlinks resolved), so `"data/a.png"` and `"./data/../data/a.png"` share
+  an entry.
+* Every `acquire` re-checks the file's modification time and size with
+  `getFsEntryMtime` / `getFsEntrySize`; a changed file is decoded again.
+* Handles are reference counted: pair each successful `acquire` with a
+  `release`. Bitmaps with no references stay cached and are destroyed
+  least-recently-used first once the cached bytes (width × height × pixel
+  size) exceed the budget. Referenced bitmaps are never destroyed, so the
+  total may exceed the budget while they are in use.
+* `stats` reports hits, misses, reloads and evictions.
+
+`bitmapCache` is a process-wide instance (256 MiB budget) used by
+`loadBitmapCached` / `releaseCachedBitmap`; separate caches can be made
+with `BitmapCache.create`. Bitmaps are loaded with the calling thread's
+new-bitmap flags, so use a cache from the display thread.
+
+## Example
+```
+let tiles ← loadBitmapCached "data/tiles.png"
+-- … another scene asks for the same file: no decode
+let again ← loadBitmapCached "./data/tiles.png"
+releaseCachedBitmap again
+releaseCachedBitmap tiles
+```
+-/
+namespace Allegro
+
+/-- Counters and sizes reported by `BitmapCache.stats`. -/
+structure BitmapCacheStats where
+  /-- `acquire` calls served from the cache. -/
+  hits      : Nat
+  /-- `acquire` calls that had to decode (including failures). -/
+  misses    : Nat
+  /-- Misses caused by a file whose mtime or size changed. -/
+  reloads   : Nat
+  /-- Unreferenced bitmaps destroyed to stay within the budget. -/
+  evictions : Nat
+  /-- Cached files. -/
+  entries   : Nat
+  /-- Cached bytes (width × height × pixel size). -/
+  bytes     : Nat
+  /-- Byte budget. -/
+  budget    : Nat
+  deriving Repr
+
+private structure CacheEntry where
+  bitmap  : Bitmap
+  bytes   : Nat
+  mtime   : UInt64
+  size    : UInt64
+  refs    : Nat
+  lastUse : Nat
+  deriving Inhabited
+
+private structure CacheState where
+  entries   : Std.HashMap String CacheEntry := {}
+  /-- Handle → key, for `release`. -/
+  keys      : Std.HashMap UInt64 String := {}
+  /-- Referenced bitmaps whose file changed: destroyed on their last
+      `release`. -/
+  stale     : Std.HashMap UInt64 Nat := {}
+  bytes     : Nat := 0
+  budget    : Nat
+  clock     : Nat := 0
+  hits      : Nat := 0
+  misses    : Nat := 0
+  reloads   : Nat := 0
+  evictions : Nat := 0
+
+/-- A reference-counted, LRU-bounded cache of decoded bitmaps. -/
+structure BitmapCache where
+  state : IO.Ref CacheState
+  deriving Nonempty
+
+namespace BitmapCache
+
+/-- Create an empty cache holding at most `budget` bytes of unreferenced
+    bitmaps. -/
+def create (budget : Nat := 256 * 1024 * 1024) : IO BitmapCache :=
+  return { state := ← IO.mkRef { budget } }
+
+/-- Canonical key for `path`; the path itself if it cannot be resolved. -/
+private def canonicalKey (path : String) : IO String := do
+  try return (← IO.FS.realPath path).toString
+  catch _ => return path
+
+/-- `(mtime, size)` of `path`, or `none` if it does not exist. -/
+private def fileStamp (path : String) : IO (Option (UInt64 × UInt64)) := do
+  let some e ← createFsEntry? path | return none
+  try
+    if (← fsEntryExists e) == 0 then return none
+    return some (← getFsEntryMtime e, ← getFsEntrySize e)
+  finally
+    destroyFsEntry e
+
+/-- Destroy least-recently-used unreferenced bitmaps until the cached bytes
+    fit the budget. -/
+private def evict (c : BitmapCache) : IO Unit := do
+  repeat
+    let s ← c.state.get
+    if s.bytes ≤ s.budget then break
+    let victim := s.entries.fold (init := (none : Option (String × Nat))) fun best k e =>
+      if e.refs != 0 then best else
+      match best with
+      | some (_, t) => if e.lastUse < t then some (k, e.lastUse) else best
+      | none => some (k, e.lastUse)
+    let some (key, _) := victim | break
+    let e := s.entries[key]!
+    c.state.set { s with entries := s.entries.erase key, keys := s.keys.erase e.bitmap,
+                         bytes := s.bytes - e.bytes, evictions := s.evictions + 1 }
+    destroyBitmap e.bitmap
+
+/-- Bitmap for `path`, decoded only if it is not cached or the file changed.
+    Adds a reference; returns 0 (and adds none) if the file cannot be
+    loaded. -/
+def acquire (c : BitmapCache) (path : String) : IO Bitmap := do
+  let key ← canonicalKey path
+  let some (mtime, size) ← fileStamp key
+    | do c.state.modify fun s => { s with misses := s.misses + 1 }
+         return 0
+  let s ← c.state.get
+  let clock := s.clock + 1
+  let mut reload := false
+  if let some e := s.entries[key]? then
+    if e.mtime == mtime && e.size == size then
+      c.state.set { s with clock, hits := s.hits + 1,
+                           entries := s.entries.insert key { e with refs := e.refs + 1, lastUse := clock } }
+      return e.bitmap
+    -- The file changed: drop the old bitmap now, or when its last user
+    -- releases it.
+    reload := true
+    c.state.set { s with entries := s.entries.erase key, bytes := s.bytes - e.bytes,
+                         keys := s.keys.erase e.bitmap,
+                         stale := if e.refs > 0 then s.stale.insert e.bitmap e.refs else s.stale }
+    if e.refs == 0 then destroyBitmap e.bitmap
+  let bmp ← loadBitmap key
+  c.state.modify fun s => { s with misses := s.misses + 1, reloads := if reload then s.reloads + 1 else s.reloads }
+  if bmp == 0 then return 0
+  let bytes := (← getBitmapWidth bmp).toNat * (← getBitmapHeight bmp).toNat * (← getBitmapFormat bmp).size.toNat
+  c.state.modify fun s =>
+    { s with clock, bytes := s.bytes + bytes, keys := s.keys.insert bmp key,
+             entries := s.entries.insert key { bitmap := bmp, bytes, mtime, size, refs := 1, lastUse := clock } }
+  evict c
+  return bmp
+
+/-- Drop one reference to a bitmap returned by `acquire`. Unreferenced
+    bitmaps stay cached until evicted. Unknown handles are ignored. -/
+def release (c : BitmapCache) (bmp : Bitmap) : IO Unit := do
+  let s ← c.state.get
+  if let some key := s.keys[bmp]? then
+    if let some e := s.entries[key]? then
+      c.state.set { s with entries := s.entries.insert key { e with refs := e.refs - 1 } }
+      if e.refs ≤ 1 then evict c
+  else if let some n := s.stale[bmp]? then
+    if n ≤ 1 then
+      c.state.set { s with stale := s.stale.erase bmp }
+      destroyBitmap bmp
+    else
+      c.state.set { s with stale := s.stale.insert bmp (n - 1) }
+
+/-- Change the byte budget, evicting as needed. -/
+def setBudget (c : BitmapCache) (budget : Nat) : IO Unit := do
+  c.state.modify fun s => { s with budget }
+  evict c
+
+/-- Destroy every unreferenced bitmap. -/
+def trim (c : BitmapCache) : IO Unit := do
+  let budget := (← c.state.get).budget
+  setBudget c 0
+  c.state.modify fun s => { s with budget }
+
+/-- Current counters and sizes. -/
+def stats (c : BitmapCache) : IO BitmapCacheStats := do
+  let s ← c.state.get
+  return { hits := s.hits, misses := s.misses, reloads := s.reloads, evictions := s.evictions,
+           entries := s.entries.size, bytes := s.bytes, budget := s.budget }
+
+/-- Zero the hit / miss / reload / eviction counters. -/
+def resetStats (c : BitmapCache) : IO Unit :=
+  c.state.modify fun s => { s with hits := 0, misses := 0, reloads := 0, evictions := 0 }
+
+end BitmapCache
+
+/-- Process-wide bitmap cache (256 MiB budget). -/
+initialize bitmapCache : BitmapCache ← BitmapCache.create
+
+/-- `bitmapCache.acquire`: load `path` through the process-wide cache. -/
+@[inline] def loadBitmapCached (path : String) : IO Bitmap :=
+  bitmapCache.acquire path
+
+/-- `bitmapCache.release`. -/
+@[inline] def releaseCachedBitmap (bmp : Bitmap) : IO Unit :=
+  bitmapCache.release bmp
+
+end Allegro
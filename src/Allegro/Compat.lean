@@ -116,6 +116,11 @@ namespace Bitmap
 @[inline] def lockRegion          (b : Bitmap) (x y w h : Int32) (fmt : PixelFormat) (fl : LockMode) := lockBitmapRegion b x y w h fmt fl
 @[inline] def unlock              (b : Bitmap) := unlockBitmap b
 @[inline] def getPixelRgba        (b : Bitmap) (x y : Int32) := Allegro.getPixelRgba b x y
+@[inline] def getPixelColor       (b : Bitmap) (x y : Int32) := Allegro.getPixelColor b x y
+@[inline] def readRegion          (b : Bitmap) (x y : Int32) (w h : UInt32) (fmt : PixelFormat) := Allegro.readRegion b x y w h fmt
+@[inline] def writeRegion         (b : Bitmap) (x y : Int32) (w h : UInt32) (fmt : PixelFormat) (bytes : ByteArray) := Allegro.writeRegion b x y w h fmt bytes
+@[inline] def fillRegion          (b : Bitmap) (x y : Int32) (w h : UInt32) (c : Color) := Allegro.fillRegion b x y w h c
+@[inline] def blitFrom            (b : Bitmap) (dx dy : Int32) (src : ByteArray) (fmt : PixelFormat) (srcWidth sx sy w h : UInt32) := Allegro.blitToBitmap b dx dy src fmt srcWidth sx sy w h
 @[inline] def draw                (b : Bitmap) (dx dy : Float) (fl : FlipFlags) := drawBitmap b dx dy fl
 @[inline] def drawScaled          (b : Bitmap) (sx sy sw sh dx dy dw dh : Float) (fl : FlipFlags) := drawScaledBitmap b sx sy sw sh dx dy dw dh fl
 @[inline] def drawRegion          (b : Bitmap) (sx sy sw sh dx dy : Float) (fl : FlipFlags) := drawBitmapRegion b sx sy sw sh dx dy fl
@@ -180,6 +185,11 @@ namespace EventQueue
 @[inline] def waitForTimedData  (q : EventQueue) (secs : Float) := waitForEventTimedData q secs
 @[inline] def getNextData       (q : EventQueue) := getNextEventData q
 @[inline] def peekNextData      (q : EventQueue) := peekNextEventData q
+@[inline] def drainData         (q : EventQueue) (max : UInt32) := drainEventData q max
+@[inline] def setDropType       (q : EventQueue) (ty : EventType) (drop : UInt32) := setEventQueueDropType q ty drop
+@[inline] def setCoalesce       (q : EventQueue) (rules : EventCoalesce) := setEventQueueCoalesce q rules
+@[inline] def clearFilter       (q : EventQueue) := clearEventQueueFilter q
+@[inline] def filterStats       (q : EventQueue) := getEventQueueFilterStats q
 @[inline] def isSourceRegistered (q : EventQueue) (src : EventSource) := isEventSourceRegistered q src
 @[inline] def waitForUntilData   (q : EventQueue) (t : Timeout) := waitForEventUntilData q t
 
@@ -526,12 +536,14 @@ namespace Font
 @[inline] def ranges               (f : Font) (maxRanges : Int32) := getFontRanges f maxRanges
 @[inline] def ustrWidth            (f : Font) (u : UInt64) := getUstrWidth f u
 @[inline] def textDimensions       (f : Font) (text : String) := getTextDimensions f text
+@[inline] def textBounds           (f : Font) (text : String) := getTextBounds f text
 @[inline] def setFallback          (f : Font) (fallback : Font) := setFallbackFont f fallback
 @[inline] def fallback             (f : Font) := getFallbackFont f
 @[inline] def fallback?            (f : Font) := getFallbackFont? f
 @[inline] def doMultiline          (f : Font) (maxW : Float) (text : String) := doMultilineText f maxW text
 @[inline] def doMultilineUstr      (f : Font) (maxW : Float) (u : UInt64) := Allegro.doMultilineUstr f maxW u
 @[inline] def glyph                (f : Font) (cp : UInt32) := getGlyph f cp
+@[inline] def glyphInfo            (f : Font) (cp : UInt32) := getGlyphInfo f cp
 
 -- Color-accepting overloads
 @[inline] def drawText             (f : Font) (c : Color) (x y : Float) (fl : TextAlign) (text : String) := Allegro.drawText f c x y fl text
@@ -795,6 +807,17 @@ namespace VertexBuffer
 
 end VertexBuffer
 
+-- ════════════════════════════════════════════════════════════════════════════
+-- StreamingVertexBuffer
+-- ════════════════════════════════════════════════════════════════════════════
+
+namespace StreamingVertexBuffer
+
+@[inline] def destroy (s : StreamingVertexBuffer) := destroyStreamingVertexBuffer s
+@[inline] def append  (s : StreamingVertexBuffer) (vertices : ByteArray) := streamingVertexBufferAppend s vertices
+
+end StreamingVertexBuffer
+
 -- ════════════════════════════════════════════════════════════════════════════
 -- IndexBuffer
 -- ════════════════════════════════════════════════════════════════════════════
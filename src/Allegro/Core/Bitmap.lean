@@ -101,41 +101,51 @@ def abgrF32 : PixelFormat := ⟨24⟩
 end PixelFormat
 
 -- ── Pixel format queries ──
+-- These are table lookups with no dependence on Allegro state, so they are
+-- bound as pure functions; the `get…` IO forms are kept for existing callers.
 
 @[extern "allegro_al_get_pixel_size"]
-private opaque getPixelSizeRaw : UInt32 → IO UInt32
-
-/-- Bytes per pixel for the given format. -/
-@[inline] def getPixelSize (fmt : PixelFormat) : IO UInt32 :=
-  getPixelSizeRaw fmt.val
+private opaque pixelSizeRaw : UInt32 → UInt32
 
 @[extern "allegro_al_get_pixel_format_bits"]
-private opaque getPixelFormatBitsRaw : UInt32 → IO UInt32
-
-/-- Bits per pixel for the given format. -/
-@[inline] def getPixelFormatBits (fmt : PixelFormat) : IO UInt32 :=
-  getPixelFormatBitsRaw fmt.val
+private opaque pixelFormatBitsRaw : UInt32 → UInt32
 
 @[extern "allegro_al_get_pixel_block_size"]
-private opaque getPixelBlockSizeRaw : UInt32 → IO UInt32
-
-/-- Block size in bytes for compressed formats (1 for uncompressed). -/
-@[inline] def getPixelBlockSize (fmt : PixelFormat) : IO UInt32 :=
-  getPixelBlockSizeRaw fmt.val
+private opaque pixelBlockSizeRaw : UInt32 → UInt32
 
 @[extern "allegro_al_get_pixel_block_width"]
-private opaque getPixelBlockWidthRaw : UInt32 → IO UInt32
+private opaque pixelBlockWidthRaw : UInt32 → UInt32
+
+@[extern "allegro_al_get_pixel_block_height"]
+private opaque pixelBlockHeightRaw : UInt32 → UInt32
 
+namespace PixelFormat
+/-- Bytes per pixel for the format. -/
+@[inline] def size (fmt : PixelFormat) : UInt32 := pixelSizeRaw fmt.val
+/-- Bits per pixel for the format. -/
+@[inline] def bits (fmt : PixelFormat) : UInt32 := pixelFormatBitsRaw fmt.val
+/-- Block size in bytes for compressed formats (1 for uncompressed). -/
+@[inline] def blockSize (fmt : PixelFormat) : UInt32 := pixelBlockSizeRaw fmt.val
 /-- Block width for compressed formats (1 for uncompressed). -/
-@[inline] def getPixelBlockWidth (fmt : PixelFormat) : IO UInt32 :=
-  getPixelBlockWidthRaw fmt.val
+@[inline] def blockWidth (fmt : PixelFormat) : UInt32 := pixelBlockWidthRaw fmt.val
+/-- Block height for compressed formats (1 for uncompressed). -/
+@[inline] def blockHeight (fmt : PixelFormat) : UInt32 := pixelBlockHeightRaw fmt.val
+end PixelFormat
 
-@[extern "allegro_al_get_pixel_block_height"]
-private opaque getPixelBlockHeightRaw : UInt32 → IO UInt32
+/-- Bytes per pixel for the given format. -/
+@[inline] def getPixelSize (fmt : PixelFormat) : IO UInt32 := pure fmt.size
+
+/-- Bits per pixel for the given format. -/
+@[inline] def getPixelFormatBits (fmt : PixelFormat) : IO UInt32 := pure fmt.bits
+
+/-- Block size in bytes for compressed formats (1 for uncompressed). -/
+@[inline] def getPixelBlockSize (fmt : PixelFormat) : IO UInt32 := pure fmt.blockSize
+
+/-- Block width for compressed formats (1 for uncompressed). -/
+@[inline] def getPixelBlockWidth (fmt : PixelFormat) : IO UInt32 := pure fmt.blockWidth
 
 /-- Block height for compressed formats (1 for uncompressed). -/
-@[inline] def getPixelBlockHeight (fmt : PixelFormat) : IO UInt32 :=
-  getPixelBlockHeightRaw fmt.val
+@[inline] def getPixelBlockHeight (fmt : PixelFormat) : IO UInt32 := pure fmt.blockHeight
 
 -- ── Bitmap flag constants ──
 
@@ -333,7 +343,10 @@ private opaque lockBitmapRegionRaw : UInt64 → Int32 → Int32 → Int32 → In
 @[extern "allegro_al_unlock_bitmap"]
 opaque unlockBitmap : UInt64 → IO Unit
 
-@[extern "allegro_al_locked_region_get_format"]
+-- LockedRegion field reads are `extern c inline` (struct mirror of
+-- ALLEGRO_LOCKED_REGION, checked by `_Static_assert` in `ffi/allegro_bitmap.c`).
+
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { void *data; int format; int pitch; int pixel_size; } *)(uintptr_t)#1)->format))"]
 private opaque lockedRegionGetFormatRaw : LockedRegion → IO UInt32
 
 /-- Get the pixel format of a locked region. -/
@@ -342,17 +355,112 @@ private opaque lockedRegionGetFormatRaw : LockedRegion → IO UInt32
   return ⟨v⟩
 
 /-- Get the pitch (bytes per row, may be negative) of a locked region. -/
-@[extern "allegro_al_locked_region_get_pitch"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { void *data; int format; int pitch; int pixel_size; } *)(uintptr_t)#1)->pitch))"]
 opaque lockedRegionGetPitch : LockedRegion → IO UInt32
 
 /-- Get the pixel size in bytes of a locked region. -/
-@[extern "allegro_al_locked_region_get_pixel_size"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { void *data; int format; int pitch; int pixel_size; } *)(uintptr_t)#1)->pixel_size))"]
 opaque lockedRegionGetPixelSize : LockedRegion → IO UInt32
 
 /-- Get the raw data pointer of a locked region (as UInt64). -/
-@[extern "allegro_al_locked_region_get_data"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint64(#1 == 0 ? 0u : (uint64_t)(uintptr_t)((const struct { void *data; int format; int pitch; int pixel_size; } *)(uintptr_t)#1)->data))"]
 opaque lockedRegionGetData : LockedRegion → IO UInt64
 
+-- ── Bulk region transfer ──
+
+@[extern "allegro_read_bitmap_region"]
+private opaque readRegionRaw : UInt64 → Int32 → Int32 → UInt32 → UInt32 → UInt32 → IO ByteArray
+
+/-- Copy the `w × h` rectangle at `(x, y)` out of `bmp` in pixel format
+    `fmt`, as tightly packed rows (`w * fmt.size` bytes each, top row first).
+    Locks read-only, copies row by row honouring the (possibly negative)
+    pitch, and unlocks, all in one call. Returns an empty array if the
+    rectangle is outside the bitmap, the format is compressed, or the
+    bitmap is already locked. With an `any…` format the bitmap's own format
+    is used (see `getBitmapFormat`). If both `fmt` and the bitmap's format
+    satisfy `PixelFormat.hasKernel`, the conversion runs in the shim's
+    vectorised kernels rather than Allegro's generic converter. -/
+@[inline] def readRegion (bmp : UInt64) (x y : Int32) (w h : UInt32) (fmt : PixelFormat) : IO ByteArray :=
+  readRegionRaw bmp x y w h fmt.val
+
+@[extern "allegro_write_bitmap_region"]
+private opaque writeRegionRaw : UInt64 → Int32 → Int32 → UInt32 → UInt32 → UInt32 → @&ByteArray → IO UInt32
+
+/-- Copy tightly packed rows in pixel format `fmt` (layout as `readRegion`)
+    into the `w × h` rectangle at `(x, y)` of `bmp`, locking write-only.
+    Returns 1 on success, 0 if `bytes` is too short or the rectangle cannot
+    be locked. -/
+@[inline] def writeRegion (bmp : UInt64) (x y : Int32) (w h : UInt32) (fmt : PixelFormat) (bytes : ByteArray) : IO UInt32 :=
+  writeRegionRaw bmp x y w h fmt.val bytes
+
+-- ── Pixel conversion kernels ──
+-- SSE2 / AVX2 (scalar fallback) conversion, fill and copy-rect between
+-- ARGB_8888, RGBA_8888, ABGR_8888, RGB_565 and ABGR_F32. Pixel buffers are
+-- tightly packed rows, as produced by `readRegion`. The `ByteArray` forms
+-- read no Allegro state, so they are pure; they update the buffer in place
+-- when it is not shared.
+
+@[extern "allegro_pixel_format_has_kernel"]
+private opaque pixelFormatHasKernelRaw : UInt32 → UInt32
+
+/-- Whether the shim's conversion kernels handle this format (`argb8888`,
+    `rgba8888`, `abgr8888`, `rgb565`, `abgrF32`). -/
+@[inline] def PixelFormat.hasKernel (fmt : PixelFormat) : Bool :=
+  pixelFormatHasKernelRaw fmt.val != 0
+
+@[extern "allegro_convert_pixels"]
+private opaque convertPixelsRaw : @&ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → ByteArray
+
+/-- Convert `w × h` pixels from `srcFmt` to `dstFmt`. 565 channels widen as
+    Allegro does (`v * 255 / 31`); float channels are clamped to 0–1 and
+    rounded to nearest when narrowed. Returns an empty array if either
+    format lacks a kernel or `src` is shorter than `w * h` pixels. -/
+@[inline] def convertPixels (src : ByteArray) (srcFmt dstFmt : PixelFormat) (w h : UInt32) : ByteArray :=
+  convertPixelsRaw src srcFmt.val dstFmt.val w h
+
+@[extern "allegro_blit_pixels"]
+private opaque blitPixelsRaw : ByteArray → UInt32 → UInt32 → UInt32 → UInt32 →
+  @&ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → ByteArray
+
+/-- Copy the `w × h` rectangle at `(sx, sy)` of `src` (`srcWidth` pixels per
+    row, format `srcFmt`) to `(dx, dy)` of `dst` (`dstWidth` pixels per row,
+    format `dstFmt`), converting on the way. Row counts follow from the
+    buffer sizes. `dst` is returned unchanged if either rectangle does not
+    fit or a format lacks a kernel. -/
+@[inline] def blitPixels (dst : ByteArray) (dstFmt : PixelFormat) (dstWidth dx dy : UInt32)
+    (src : ByteArray) (srcFmt : PixelFormat) (srcWidth sx sy w h : UInt32) : ByteArray :=
+  blitPixelsRaw dst dstFmt.val dstWidth dx dy src srcFmt.val srcWidth sx sy w h
+
+@[extern "allegro_fill_pixels"]
+private opaque fillPixelsRaw : ByteArray → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → UInt32 → ByteArray
+
+/-- Fill the `w × h` rectangle at `(x, y)` of a `width`-pixel-wide buffer in
+    format `fmt` with `c`. `buf` is returned unchanged if the rectangle does
+    not fit or the format lacks a kernel. -/
+@[inline] def fillPixels (buf : ByteArray) (fmt : PixelFormat) (width x y w h : UInt32) (c : Color) : ByteArray :=
+  fillPixelsRaw buf fmt.val width x y w h c.pack
+
+@[extern "allegro_fill_bitmap_region"]
+private opaque fillRegionRaw : UInt64 → Int32 → Int32 → UInt32 → UInt32 → UInt32 → IO UInt32
+
+/-- Overwrite the `w × h` rectangle at `(x, y)` of `bmp` with `c` through a
+    write-only lock (no blending, unlike `drawFilledRectangle`). Returns 1
+    on success, 0 if the rectangle cannot be locked. -/
+@[inline] def fillRegion (bmp : UInt64) (x y : Int32) (w h : UInt32) (c : Color) : IO UInt32 :=
+  fillRegionRaw bmp x y w h c.pack
+
+@[extern "allegro_blit_pixels_to_bitmap"]
+private opaque blitToBitmapRaw : UInt64 → Int32 → Int32 → @&ByteArray → UInt32 → UInt32 →
+  UInt32 → UInt32 → UInt32 → UInt32 → IO UInt32
+
+/-- Copy the `w × h` rectangle at `(sx, sy)` of `src` (`srcWidth` pixels per
+    row, format `srcFmt`, which must satisfy `hasKernel`) into `bmp` at
+    `(dx, dy)`, converting to the bitmap's format in the shim. Returns 1 on
+    success, 0 if either rectangle is out of range or the lock fails. -/
+@[inline] def blitToBitmap (bmp : UInt64) (dx dy : Int32) (src : ByteArray) (srcFmt : PixelFormat)
+    (srcWidth sx sy w h : UInt32) : IO UInt32 :=
+  blitToBitmapRaw bmp dx dy src srcFmt.val srcWidth sx sy w h
+
 -- ── Pixel get / put ──
 
 /-- Clear the target bitmap to an RGB colour. -/
@@ -363,9 +471,13 @@ opaque clearToColorRgb : UInt32 → UInt32 → UInt32 → IO Unit
 @[extern "allegro_al_draw_pixel_rgb"]
 opaque drawPixelRgb : Float → Float → UInt32 → UInt32 → UInt32 → IO Unit
 
-/-- Get all four pixel components (r, g, b, a) in one call. -/
+/-- Get all four pixel components (0–255) as one `Color`. -/
 @[extern "allegro_al_get_pixel_rgba"]
-opaque getPixelRgba : UInt64 → Int32 → Int32 → IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque getPixelColor : UInt64 → Int32 → Int32 → IO Color
+
+/-- Get all four pixel components (r, g, b, a) in one call. -/
+@[inline] def getPixelRgba (bmp : UInt64) (x y : Int32) : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← getPixelColor bmp x y).toTuple
 
 /-- Write a pixel (RGB, alpha=255) at the given coords on the target bitmap. -/
 @[extern "allegro_al_put_pixel"]
@@ -522,9 +634,14 @@ opaque convertMaskToAlpha : UInt64 → UInt32 → UInt32 → UInt32 → IO Unit
 
 -- ── Per-bitmap blender ──
 
+/-- Get the per-bitmap (separate) blender state in one call. -/
+@[extern "allegro_al_get_separate_bitmap_blender"]
+opaque getBitmapBlenderState : IO BlenderState
+
 /-- Get the per-bitmap blender as `(op, src, dst)`. -/
-@[extern "allegro_al_get_bitmap_blender"]
-opaque getBitmapBlender : IO (BlendOp × BlendFactor × BlendFactor)
+@[inline] def getBitmapBlender : IO (BlendOp × BlendFactor × BlendFactor) := do
+  let s ← getBitmapBlenderState
+  return (s.op, s.src, s.dst)
 
 /-- Set the per-bitmap blender.
     `setBitmapBlender op src dst` -/
@@ -532,17 +649,22 @@ opaque getBitmapBlender : IO (BlendOp × BlendFactor × BlendFactor)
 opaque setBitmapBlender : BlendOp → BlendFactor → BlendFactor → IO Unit
 
 /-- Get the per-bitmap separate blender as `(op, src, dst, alphaOp, alphaSrc, alphaDst)`. -/
-@[extern "allegro_al_get_separate_bitmap_blender"]
-opaque getSeparateBitmapBlender : IO (BlendOp × BlendFactor × BlendFactor × BlendOp × BlendFactor × BlendFactor)
+@[inline] def getSeparateBitmapBlender : IO (BlendOp × BlendFactor × BlendFactor × BlendOp × BlendFactor × BlendFactor) := do
+  let s ← getBitmapBlenderState
+  return (s.op, s.src, s.dst, s.alphaOp, s.alphaSrc, s.alphaDst)
 
 /-- Set the per-bitmap separate blender.
     `setSeparateBitmapBlender op src dst alphaOp alphaSrc alphaDst` -/
 @[extern "allegro_al_set_separate_bitmap_blender"]
 opaque setSeparateBitmapBlender : BlendOp → BlendFactor → BlendFactor → BlendOp → BlendFactor → BlendFactor → IO Unit
 
-/-- Get the per-bitmap blend colour as `(r, g, b, a)` with components in 0.0…1.0. -/
+/-- Get the per-bitmap blend colour with components in 0.0…1.0. -/
 @[extern "allegro_al_get_bitmap_blend_color"]
-opaque getBitmapBlendColor : IO (Float × Float × Float × Float)
+opaque getBitmapBlendColorF : IO ColorF
+
+/-- Get the per-bitmap blend colour as `(r, g, b, a)` with components in 0.0…1.0. -/
+@[inline] def getBitmapBlendColor : IO (Float × Float × Float × Float) :=
+  return (← getBitmapBlendColorF).toTuple
 
 /-- Set the per-bitmap blend colour.
     `setBitmapBlendColor r g b a` where each component is in 0.0…1.0. -/
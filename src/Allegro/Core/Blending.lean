@@ -1,3 +1,5 @@
+import Allegro.Core.System
+
 /-!
 Blending mode control for Allegro 5.
 
@@ -131,29 +133,50 @@ private opaque drawTintedBitmapRgbaRaw : UInt64 → UInt32 → UInt32 → UInt32
   drawTintedBitmapRgbaRaw bmp r g b a dx dy flags.val
 
 -- ════════════════════════════════════════════════════════════════════
--- Tuple-returning queries  (single FFI call → full result)
+-- Record-returning queries  (single FFI call → one scalar-packed object)
 -- ════════════════════════════════════════════════════════════════════
 
-/-- Get the current blender as `(op, src, dest)` in one call. -/
-@[extern "allegro_al_get_blender"]
-private opaque getBlenderRaw : IO (UInt32 × UInt32 × UInt32)
+/-- Full blender state, colour and alpha halves.
+
+    Scalar layout (see `io_ok_blender_state`): `op`@0 `src`@4 `dst`@8
+    `alphaOp`@12 `alphaSrc`@16 `alphaDst`@20 (24 bytes). -/
+structure BlenderState where
+  /-- Colour blend operation. -/
+  op       : BlendOp
+  /-- Colour source factor. -/
+  src      : BlendFactor
+  /-- Colour destination factor. -/
+  dst      : BlendFactor
+  /-- Alpha blend operation. -/
+  alphaOp  : BlendOp
+  /-- Alpha source factor. -/
+  alphaSrc : BlendFactor
+  /-- Alpha destination factor. -/
+  alphaDst : BlendFactor
+  deriving BEq, Repr
+
+/-- Get the current (separate) blender state in one call. -/
+@[extern "allegro_al_get_separate_blender"]
+opaque getBlenderState : IO BlenderState
 
+/-- Get the current blender as `(op, src, dest)` in one call. -/
 @[inline] def getBlender : IO (BlendOp × BlendFactor × BlendFactor) := do
-  let (op, src, dst) ← getBlenderRaw
-  return (⟨op⟩, ⟨src⟩, ⟨dst⟩)
+  let s ← getBlenderState
+  return (s.op, s.src, s.dst)
 
 /-- Get the current separate blender as `(op, src, dst, alphaOp, alphaSrc, alphaDst)`. -/
-@[extern "allegro_al_get_separate_blender"]
-private opaque getSeparateBlenderRaw : IO (UInt32 × UInt32 × UInt32 × UInt32 × UInt32 × UInt32)
-
 @[inline] def getSeparateBlender : IO (BlendOp × BlendFactor × BlendFactor × BlendOp × BlendFactor × BlendFactor) := do
-  let (op, src, dst, aop, asrc, adst) ← getSeparateBlenderRaw
-  return (⟨op⟩, ⟨src⟩, ⟨dst⟩, ⟨aop⟩, ⟨asrc⟩, ⟨adst⟩)
+  let s ← getBlenderState
+  return (s.op, s.src, s.dst, s.alphaOp, s.alphaSrc, s.alphaDst)
 
-/-- Get the current blend colour as `(r, g, b, a)` with components in 0.0…1.0.
+/-- Get the current blend colour with components in 0.0…1.0.
     This is the constant colour used by `blendConstColor` / `blendInverseConstColor`. -/
 @[extern "allegro_al_get_blend_color"]
-opaque getBlendColor : IO (Float × Float × Float × Float)
+opaque getBlendColorF : IO ColorF
+
+/-- Get the current blend colour as `(r, g, b, a)` with components in 0.0…1.0. -/
+@[inline] def getBlendColor : IO (Float × Float × Float × Float) :=
+  return (← getBlendColorF).toTuple
 
 /-- Set the blend colour (constant colour blending).
     `setBlendColor r g b a` where each component is in 0.0…1.0. -/
@@ -456,16 +456,20 @@ opaque waitForVsync : IO UInt32
 opaque backupDirtyBitmaps : Display → IO Unit
 
 -- ════════════════════════════════════════════════════════════════════
--- Tuple-returning queries  (single FFI call → full result)
+-- Tuple- and record-returning queries  (single FFI call → full result)
 -- ════════════════════════════════════════════════════════════════════
 
 /-- Get the window position as `(x, y)` in one call. -/
 @[extern "allegro_al_get_window_position"]
 opaque getWindowPosition : Display → IO (Int32 × Int32)
 
-/-- Get the clipping rectangle as `(x, y, w, h)` in one call. -/
+/-- Get the clipping rectangle of the target bitmap as one `Rect`. -/
 @[extern "allegro_al_get_clipping_rectangle"]
-opaque getClippingRectangle : IO (UInt32 × UInt32 × UInt32 × UInt32)
+opaque getClippingRect : IO Rect
+
+/-- Get the clipping rectangle as `(x, y, w, h)` in one call. -/
+@[inline] def getClippingRectangle : IO (UInt32 × UInt32 × UInt32 × UInt32) :=
+  return (← getClippingRect).toTuple
 
 /-- Get window border/decoration sizes as `(left, top, right, bottom)`. -/
 @[extern "allegro_al_get_window_borders"]
@@ -475,9 +479,36 @@ opaque getWindowBorders : Display → IO (UInt32 × UInt32 × UInt32 × UInt32)
 @[extern "allegro_al_get_window_constraints"]
 opaque getWindowConstraints : Display → IO (UInt32 × UInt32 × UInt32 × UInt32)
 
-/-- Get monitor `adapter`'s desktop area as `(x1, y1, x2, y2)` in one call. -/
+/-- A monitor's desktop area in virtual-screen coordinates (`x2` / `y2` exclusive).
+
+    Scalar layout: `x1`@0 `y1`@4 `x2`@8 `y2`@12 (16 bytes). -/
+structure MonitorInfo where
+  /-- Left edge. -/
+  x1 : Int32
+  /-- Top edge. -/
+  y1 : Int32
+  /-- Right edge. -/
+  x2 : Int32
+  /-- Bottom edge. -/
+  y2 : Int32
+  deriving BEq, Repr, Inhabited
+
+namespace MonitorInfo
+/-- Width of the monitor's desktop area. -/
+@[inline] def width (m : MonitorInfo) : Int32 := m.x2 - m.x1
+/-- Height of the monitor's desktop area. -/
+@[inline] def height (m : MonitorInfo) : Int32 := m.y2 - m.y1
+end MonitorInfo
+
+/-- Get monitor `adapter`'s desktop area as one `MonitorInfo`.
+    All fields are 0 if the adapter index is invalid. -/
 @[extern "allegro_al_get_monitor_info"]
-opaque getMonitorInfo : UInt32 → IO (Int32 × Int32 × Int32 × Int32)
+opaque getMonitor : UInt32 → IO MonitorInfo
+
+/-- Get monitor `adapter`'s desktop area as `(x1, y1, x2, y2)` in one call. -/
+@[inline] def getMonitorInfo (adapter : UInt32) : IO (Int32 × Int32 × Int32 × Int32) := do
+  let m ← getMonitor adapter
+  return (m.x1, m.y1, m.x2, m.y2)
 
 /-- Get fullscreen display mode at `index` as `(width, height, format, refreshRate)`. -/
 @[extern "allegro_al_get_display_mode"]
@@ -191,9 +191,15 @@ def displayDisconnected : EventType := ⟨61⟩
 end EventType
 
 -- ── General event fields ──
+-- The hottest accessors (type, keycode/unichar, mouse x/y/dx/dy/button) are
+-- `extern c inline`: the field read is pasted into the caller's generated C
+-- through a struct that mirrors Allegro's public event layout, so no call
+-- into the shim is made. The mirrors are `_Static_assert`ed against the real
+-- structs in `ffi/allegro_event.c`, which still exports the out-of-line
+-- `allegro_al_event_get_*` symbols.
 
 /-- Get the type code of an event. -/
-@[extern "allegro_al_event_get_type"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; } *)(uintptr_t)#1)->type))"]
 private opaque eventGetTypeRaw : Event → IO UInt32
 
 @[inline] def eventGetType (ev : Event) : IO EventType := do
@@ -211,7 +217,7 @@ opaque eventGetSource : Event → IO UInt64
 -- ── Keyboard event fields ──
 
 /-- Get the keycode from a keyboard event. -/
-@[extern "allegro_al_event_get_keyboard_keycode"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int keycode; int unichar; } *)(uintptr_t)#1)->keycode))"]
 private opaque eventGetKeyboardKeycodeRaw : Event → IO UInt32
 
 /-- Get the keyboard keycode from a KEY_DOWN / KEY_UP / KEY_CHAR event. -/
@@ -220,7 +226,7 @@ private opaque eventGetKeyboardKeycodeRaw : Event → IO UInt32
   return ⟨v⟩
 
 /-- Get the Unicode character from a KEY_CHAR event. -/
-@[extern "allegro_al_event_get_keyboard_unichar"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int keycode; int unichar; } *)(uintptr_t)#1)->unichar))"]
 opaque eventGetKeyboardUnichar : Event → IO UInt32
 
 /-- Get the modifier flags from a keyboard event. -/
@@ -234,11 +240,11 @@ opaque eventGetKeyboardRepeat : Event → IO UInt32
 -- ── Mouse event fields ──
 
 /-- Get the mouse X position from a mouse event. -/
-@[extern "allegro_al_event_get_mouse_x"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->x))"]
 opaque eventGetMouseX : Event → IO UInt32
 
 /-- Get the mouse Y position from a mouse event. -/
-@[extern "allegro_al_event_get_mouse_y"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->y))"]
 opaque eventGetMouseY : Event → IO UInt32
 
 /-- Get the mouse Z axis (vertical scroll wheel) from a mouse event. -/
@@ -250,11 +256,11 @@ opaque eventGetMouseZ : Event → IO UInt32
 opaque eventGetMouseW : Event → IO UInt32
 
 /-- Get the mouse X movement delta from a mouse event. -/
-@[extern "allegro_al_event_get_mouse_dx"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->dx))"]
 opaque eventGetMouseDx : Event → IO UInt32
 
 /-- Get the mouse Y movement delta from a mouse event. -/
-@[extern "allegro_al_event_get_mouse_dy"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->dy))"]
 opaque eventGetMouseDy : Event → IO UInt32
 
 /-- Get the mouse Z axis (scroll wheel) delta from a mouse event. -/
@@ -270,7 +276,7 @@ opaque eventGetMouseDw : Event → IO UInt32
 opaque eventGetMousePressure : Event → IO Float
 
 /-- Get the mouse button number from a mouse event (1-based). -/
-@[extern "allegro_al_event_get_mouse_button"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 ? 0u : (uint32_t)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->button))"]
 private opaque eventGetMouseButtonRaw : Event → IO UInt32
 
 /-- Get the mouse button number (1-based) from a mouse button event. -/
@@ -282,11 +288,11 @@ private opaque eventGetMouseButtonRaw : Event → IO UInt32
 -- They also preserve sign information for negative coordinates (multi-monitor).
 
 /-- Get the mouse X position as Float (useful for drawing coordinates). -/
-@[extern "allegro_al_event_get_mouse_x_f"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_float(#1 == 0 ? 0.0 : (double)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->x))"]
 opaque eventGetMouseXf : Event → IO Float
 
 /-- Get the mouse Y position as Float (useful for drawing coordinates). -/
-@[extern "allegro_al_event_get_mouse_y_f"]
+@[extern c inline "lean_io_result_mk_ok(lean_box_float(#1 == 0 ? 0.0 : (double)((const struct { unsigned int type; void *source; double timestamp; void *display; int x, y, z, w, dx, dy, dz, dw; unsigned int button; } *)(uintptr_t)#1)->y))"]
 opaque eventGetMouseYf : Event → IO Float
 
 /-- Get the mouse Z axis (vertical scroll wheel) as Float. -/
@@ -529,10 +535,73 @@ opaque waitForEventTimedData : EventQueue → Float → IO (UInt32 × EventData)
 @[extern "allegro_al_get_next_event_data"]
 opaque getNextEventData : EventQueue → IO (UInt32 × EventData)
 
-/-- Peek at the next event without removing it. Returns `(gotEvent, data)`. -/
+/-- Peek at the next event without removing it. Returns `(gotEvent, data)`.
+    Queue filters apply as for `getNextEventData`: the peeked event is the
+    one the next fetch returns, already merged with any coalescible
+    successors. -/
 @[extern "allegro_al_peek_next_event_data"]
 opaque peekNextEventData : EventQueue → IO (UInt32 × EventData)
 
+/-- Block until an event arrives, then drain every event already queued
+    (up to `max` in total) in a single FFI call. Events are returned in
+    queue order; the array is never empty for a live queue and `max > 0`.
+    Use this instead of repeated `getNextEventData` calls to handle input
+    bursts (mouse-axes floods, timer catch-up) in one pass. -/
+@[extern "allegro_al_drain_event_data"]
+opaque drainEventData : EventQueue → UInt32 → IO (Array EventData)
+
+-- ════════════════════════════════════════════════════════════════════
+-- Native event filtering — applied in C before events reach Lean
+-- ════════════════════════════════════════════════════════════════════
+
+/-- Coalescing rules for `setEventQueueCoalesce`. Combine with `|||`. -/
+structure EventCoalesce where
+  /-- Raw shim flag value. -/
+  val : UInt32
+  deriving BEq, Repr
+
+instance : OrOp EventCoalesce where or a b := ⟨a.val ||| b.val⟩
+instance : AndOp EventCoalesce where and a b := ⟨a.val &&& b.val⟩
+
+namespace EventCoalesce
+/-- No coalescing. -/
+def none : EventCoalesce := ⟨0⟩
+/-- Merge consecutive mouse-axes events from the same display: keep the
+    last position, sum `dx`/`dy`/`dz`/`dw`. -/
+def mouseAxes : EventCoalesce := ⟨1⟩
+/-- Merge consecutive touch-move events for the same touch id: keep the
+    last position, sum `dx`/`dy`. -/
+def touchMove : EventCoalesce := ⟨2⟩
+end EventCoalesce
+
+@[extern "allegro_al_set_event_queue_drop_type"]
+private opaque setEventQueueDropTypeRaw : EventQueue → UInt32 → UInt32 → IO Unit
+
+/-- Drop (1) or stop dropping (0) events of a built-in type on this queue.
+    Only applies to types below 64; user event types are ignored.
+    Filters affect the `EventData` family (`waitForEventData`,
+    `getNextEventData`, `drainEventData`, …), not raw `Event` buffers.
+    The filter registry is guarded by a mutex, so filters may be changed
+    from any thread, even while another thread waits on the queue. -/
+@[inline] def setEventQueueDropType (q : EventQueue) (ty : EventType) (drop : UInt32) : IO Unit :=
+  setEventQueueDropTypeRaw q ty.val drop
+
+@[extern "allegro_al_set_event_queue_coalesce"]
+private opaque setEventQueueCoalesceRaw : EventQueue → UInt32 → IO Unit
+
+/-- Set the coalescing rules for this queue (replaces any previous rules). -/
+@[inline] def setEventQueueCoalesce (q : EventQueue) (rules : EventCoalesce) : IO Unit :=
+  setEventQueueCoalesceRaw q rules.val
+
+/-- Remove all drop masks and coalescing rules from the queue and reset
+    its statistics. Destroying the queue does this automatically. -/
+@[extern "allegro_al_clear_event_queue_filter"]
+opaque clearEventQueueFilter : EventQueue → IO Unit
+
+/-- Filter statistics for the queue: `(dropped, merged)` event counts. -/
+@[extern "allegro_al_get_event_queue_filter_stats"]
+opaque getEventQueueFilterStats : EventQueue → IO (UInt64 × UInt64)
+
 -- ════════════════════════════════════════════════════════════════════
 -- Timeout
 -- ════════════════════════════════════════════════════════════════════
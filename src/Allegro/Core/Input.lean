@@ -248,8 +248,10 @@ opaque destroyKeyboardState : KeyboardState → IO Unit
 @[extern "allegro_al_get_keyboard_state"]
 opaque getKeyboardState : KeyboardState → IO Unit
 
-/-- Check whether `keycode` is held down in the given state. Returns 1 if pressed. -/
-@[extern "allegro_al_key_down"]
+/-- Check whether `keycode` is held down in the given state. Returns 1 if pressed.
+    Inlined into the caller: reads the key bitset through a mirror of
+    ALLEGRO_KEYBOARD_STATE (checked by `_Static_assert` in `ffi/allegro_input.c`). -/
+@[extern c inline "lean_io_result_mk_ok(lean_box_uint32(#1 == 0 || #2 >= 256u ? 0u : ((((const struct { void *display; unsigned int keys[8]; } *)(uintptr_t)#1)->keys[#2 / 32u] >> (#2 % 32u)) & 1u)))"]
 private opaque keyDownRaw : KeyboardState → UInt32 → IO UInt32
 
 @[inline] def keyDown (ks : KeyboardState) (key : KeyCode) : IO UInt32 :=
@@ -216,6 +216,11 @@ namespace Color
 /-- Construct an RGBA colour. `Color.rgba 255 100 50 128` -/
 @[inline] def rgba (r g b a : UInt32) : Color := { r, g, b, a }
 
+/-- Pack into one `UInt32` as `r | g<<8 | b<<16 | a<<24` (each channel
+    masked to 8 bits) — the colour encoding used by packed command buffers. -/
+@[inline] def pack (c : Color) : UInt32 :=
+  (c.r &&& 0xFF) ||| ((c.g &&& 0xFF) <<< 8) ||| ((c.b &&& 0xFF) <<< 16) ||| ((c.a &&& 0xFF) <<< 24)
+
 /-- White (255, 255, 255). -/
 def white : Color := rgb 255 255 255
 /-- Black (0, 0, 0). -/
@@ -235,5 +240,57 @@ def magenta : Color := rgb 255 0 255
 /-- Transparent (0, 0, 0, 0). -/
 def transparent : Color := rgba 0 0 0 0
 
+/-- Components as an `(r, g, b, a)` tuple. -/
+@[inline] def toTuple (c : Color) : UInt32 × UInt32 × UInt32 × UInt32 := (c.r, c.g, c.b, c.a)
+
 end Color
+
+-- ════════════════════════════════════════
+-- Scalar-packed query results
+-- ════════════════════════════════════════
+
+/-
+`Color`, `ColorF` and `Rect` have only scalar fields, so Lean represents
+each as one constructor object with no pointer fields. Shims that return
+them (`io_ok_color`, `io_ok_color_f`, `io_ok_rect` in `allegro_ffi.h`)
+fill that object directly — one allocation instead of a chain of `Prod`
+cells. Scalar layouts:
+
+* `Color`  — `r`@0 `g`@4 `b`@8 `a`@12 (16 bytes)
+* `ColorF` — `r`@0 `g`@8 `b`@16 `a`@24 (32 bytes)
+* `Rect`   — `x`@0 `y`@4 `w`@8 `h`@12 (16 bytes)
+-/
+
+/-- An RGBA colour with floating-point components, nominally 0.0–1.0. -/
+structure ColorF where
+  /-- Red component. -/
+  r : Float := 0.0
+  /-- Green component. -/
+  g : Float := 0.0
+  /-- Blue component. -/
+  b : Float := 0.0
+  /-- Alpha component. -/
+  a : Float := 1.0
+  deriving Repr, Inhabited
+
+/-- Components as an `(r, g, b, a)` tuple. -/
+@[inline] def ColorF.toTuple (c : ColorF) : Float × Float × Float × Float := (c.r, c.g, c.b, c.a)
+
+/-- An integer rectangle given by its top-left corner and size.
+    `x` / `y` may be negative (e.g. a text bounding box with a left bearing). -/
+structure Rect where
+  /-- Left edge. -/
+  x : Int32 := 0
+  /-- Top edge. -/
+  y : Int32 := 0
+  /-- Width in pixels. -/
+  w : UInt32 := 0
+  /-- Height in pixels. -/
+  h : UInt32 := 0
+  deriving BEq, Repr, Inhabited
+
+/-- Components as an `(x, y, w, h)` tuple, with `x` / `y` reinterpreted as
+    `UInt32` like the older tuple APIs. -/
+@[inline] def Rect.toTuple (r : Rect) : UInt32 × UInt32 × UInt32 × UInt32 :=
+  (r.x.toUInt32, r.y.toUInt32, r.w, r.h)
 end Allegro
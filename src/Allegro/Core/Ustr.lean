@@ -306,13 +306,19 @@ opaque ustrHasSuffix : Ustr → Ustr → IO UInt32
 
 -- ── Low-level UTF-8 helpers ──
 
-/-- Return the number of bytes that the given Unicode codepoint requires in UTF-8 encoding (1–4). -/
+/-- Number of bytes the codepoint requires in UTF-8 (1–4; 0 if invalid). Pure. -/
 @[extern "allegro_al_utf8_width"]
-opaque utf8Width : UInt32 → IO UInt32
+opaque Utf8.width : UInt32 → UInt32
 
-/-- Encode a single Unicode codepoint to a UTF-8 string (1–4 bytes). -/
+/-- Encode a single Unicode codepoint to a UTF-8 string (1–4 bytes). Pure. -/
 @[extern "allegro_al_utf8_encode"]
-opaque utf8Encode : UInt32 → IO String
+opaque Utf8.encode : UInt32 → String
+
+/-- Return the number of bytes that the given Unicode codepoint requires in UTF-8 encoding (1–4). -/
+@[inline] def utf8Width (c : UInt32) : IO UInt32 := pure (Utf8.width c)
+
+/-- Encode a single Unicode codepoint to a UTF-8 string (1–4 bytes). -/
+@[inline] def utf8Encode (c : UInt32) : IO String := pure (Utf8.encode c)
 
 -- ── UTF-16 helpers ──
 
@@ -320,9 +326,12 @@ opaque utf8Encode : UInt32 → IO String
 @[extern "allegro_al_ustr_size_utf16"]
 opaque ustrSizeUtf16 : Ustr → IO UInt64
 
-/-- Return the number of 16-bit units needed to encode a codepoint in UTF-16 (1 or 2). -/
+/-- Number of 16-bit units needed to encode the codepoint in UTF-16 (1 or 2). Pure. -/
 @[extern "allegro_al_utf16_width"]
-opaque utf16Width : UInt32 → IO UInt32
+opaque Utf16.width : UInt32 → UInt32
+
+/-- Return the number of 16-bit units needed to encode a codepoint in UTF-16 (1 or 2). -/
+@[inline] def utf16Width (c : UInt32) : IO UInt32 := pure (Utf16.width c)
 
 -- ── USTR to Lean String conversion ──
 
@@ -337,10 +346,14 @@ opaque ustrToBuffer : Ustr → IO String
 
 -- ── UTF-16 encode/decode ──
 
+/-- Encode a single codepoint to UTF-16 as `(unit0, unit1, count)`, where
+    `count` is 1 or 2 (number of 16-bit units produced). Pure. -/
+@[extern "allegro_al_utf16_encode"]
+opaque Utf16.encode : UInt32 → UInt32 × UInt32 × UInt32
+
 /-- Encode a single codepoint to UTF-16. Returns `(unit0, unit1, count)` where
     `count` is 1 or 2 (number of 16-bit units produced). -/
-@[extern "allegro_al_utf16_encode"]
-opaque utf16Encode : UInt32 → IO (UInt32 × UInt32 × UInt32)
+@[inline] def utf16Encode (c : UInt32) : IO (UInt32 × UInt32 × UInt32) := pure (Utf16.encode c)
 
 /-- Create a USTR from a UTF-16 encoded ByteArray (zero-terminated `uint16_t` sequence). -/
 @[extern "allegro_al_ustr_new_from_utf16"]
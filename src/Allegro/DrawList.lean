@@ -0,0 +1,166 @@
+import Allegro.Core
+import Allegro.Addons
+import Allegro.Pack
+
+/-!
+# Recorded draw lists
+
+A `DrawList` records drawing commands into a compact `ByteArray` and replays
+the whole frame with one FFI call. Each `drawBitmapRegion` /
+`drawFilledRectangleRgb` / `drawTextRgb` call made directly costs a shim
+transition plus an `al_map_rgb`; a recorded command costs a few `ByteArray`
+pushes, and the shim walks the buffer in C.
+
+The executor wraps each run of consecutive bitmap and text commands in
+`al_hold_bitmap_drawing`, so sprites from the same atlas are batched into one
+GPU submission without the caller toggling hold mode. Primitive, clear and
+clip commands end the run (Allegro requires hold mode to be off for them).
+
+Recording touches no Allegro state, so a list can be built in a `Task` while
+the main thread executes the previous frame's list — only `execute` must run
+on the display thread.
+
+## Example
+```
+let dl := DrawList.empty
+  |>.clear (Color.rgb 0 0 0)
+  |>.bitmapRegion atlas 0 0 32 32 100 100
+  |>.filledRectangle 10 10 60 30 (Color.rgb 255 0 0)
+  |>.text font (Color.rgb 255 255 255) 10 10 TextAlign.left "Score: 42"
+let _ ← dl.execute
+```
+
+## Encoding
+Each command is a one-byte opcode followed by its fields, little-endian and
+unpadded (see `Allegro.Pack`): handles are `u64`, coordinates `f32`,
+colours one `u32` packed as `r | g<<8 | b<<16 | a<<24`, and text a `u32`
+length followed by UTF-8 bytes. The opcode numbers match the `DL_*`
+constants in `ffi/allegro_drawlist.c`.
+-/
+namespace Allegro
+
+/-- A recorded sequence of drawing commands. -/
+structure DrawList where
+  /-- Encoded commands. -/
+  bytes : ByteArray := .empty
+  /-- Number of commands recorded. -/
+  count : UInt32 := 0
+  deriving Inhabited
+
+namespace DrawList
+
+/-- An empty draw list. -/
+def empty : DrawList := {}
+
+/-- An empty draw list whose buffer is pre-sized to `bytes` bytes.
+    Reusing last frame's `bytes.size` avoids regrowing the buffer. -/
+def withCapacity (bytes : Nat) : DrawList := { bytes := ByteArray.emptyWithCapacity bytes }
+
+/-- Opcodes (must match `DL_*` in `ffi/allegro_drawlist.c`). -/
+private def opClear : UInt8 := 1
+private def opBitmap : UInt8 := 2
+private def opBitmapRegion : UInt8 := 3
+private def opScaledBitmap : UInt8 := 4
+private def opTintedScaledRotatedRegion : UInt8 := 5
+private def opFilledRect : UInt8 := 6
+private def opRect : UInt8 := 7
+private def opLine : UInt8 := 8
+private def opFilledCircle : UInt8 := 9
+private def opCircle : UInt8 := 10
+private def opText : UInt8 := 11
+private def opClip : UInt8 := 12
+private def opResetClip : UInt8 := 13
+
+/-- Append one encoded command. -/
+@[inline] private def push (dl : DrawList) (op : UInt8) (f : ByteArray → ByteArray) : DrawList :=
+  { bytes := f (Pack.u8 dl.bytes op), count := dl.count + 1 }
+
+/-- Append a colour as one `u32` (see `Color.pack`). -/
+@[inline] private def packColor (b : ByteArray) (c : Color) : ByteArray :=
+  Pack.u32 b c.pack
+
+/-- Append four `f32` values. -/
+@[inline] private def f32x4 (b : ByteArray) (p q r s : Float) : ByteArray :=
+  Pack.f32 (Pack.f32 (Pack.f32 (Pack.f32 b p) q) r) s
+
+/-- Record `al_clear_to_color`. -/
+def clear (dl : DrawList) (c : Color) : DrawList :=
+  dl.push opClear (packColor · c)
+
+/-- Record `al_draw_bitmap`. -/
+def bitmap (dl : DrawList) (bmp : Bitmap) (dx dy : Float) (flags : FlipFlags := FlipFlags.none) : DrawList :=
+  dl.push opBitmap fun b => Pack.u32 (Pack.f32 (Pack.f32 (Pack.u64 b bmp) dx) dy) flags.val
+
+/-- Record `al_draw_bitmap_region`. -/
+def bitmapRegion (dl : DrawList) (bmp : Bitmap) (sx sy sw sh dx dy : Float)
+    (flags : FlipFlags := FlipFlags.none) : DrawList :=
+  dl.push opBitmapRegion fun b =>
+    Pack.u32 (Pack.f32 (Pack.f32 (f32x4 (Pack.u64 b bmp) sx sy sw sh) dx) dy) flags.val
+
+/-- Record `al_draw_scaled_bitmap`. -/
+def scaledBitmap (dl : DrawList) (bmp : Bitmap) (sx sy sw sh dx dy dw dh : Float)
+    (flags : FlipFlags := FlipFlags.none) : DrawList :=
+  dl.push opScaledBitmap fun b =>
+    Pack.u32 (f32x4 (f32x4 (Pack.u64 b bmp) sx sy sw sh) dx dy dw dh) flags.val
+
+/-- Record `al_draw_tinted_scaled_rotated_bitmap_region`. -/
+def tintedScaledRotatedBitmapRegion (dl : DrawList) (bmp : Bitmap) (sx sy sw sh : Float)
+    (tint : Color) (cx cy dx dy xscale yscale angle : Float)
+    (flags : FlipFlags := FlipFlags.none) : DrawList :=
+  dl.push opTintedScaledRotatedRegion fun b =>
+    let b := packColor (f32x4 (Pack.u64 b bmp) sx sy sw sh) tint
+    let b := Pack.f32 (Pack.f32 (Pack.f32 (f32x4 b cx cy dx dy) xscale) yscale) angle
+    Pack.u32 b flags.val
+
+/-- Record `al_draw_filled_rectangle`. -/
+def filledRectangle (dl : DrawList) (x1 y1 x2 y2 : Float) (c : Color) : DrawList :=
+  dl.push opFilledRect fun b => packColor (f32x4 b x1 y1 x2 y2) c
+
+/-- Record `al_draw_rectangle`. -/
+def rectangle (dl : DrawList) (x1 y1 x2 y2 : Float) (c : Color) (thickness : Float := 1.0) : DrawList :=
+  dl.push opRect fun b => packColor (Pack.f32 (f32x4 b x1 y1 x2 y2) thickness) c
+
+/-- Record `al_draw_line`. -/
+def line (dl : DrawList) (x1 y1 x2 y2 : Float) (c : Color) (thickness : Float := 1.0) : DrawList :=
+  dl.push opLine fun b => packColor (Pack.f32 (f32x4 b x1 y1 x2 y2) thickness) c
+
+/-- Record `al_draw_filled_circle`. -/
+def filledCircle (dl : DrawList) (cx cy radius : Float) (c : Color) : DrawList :=
+  dl.push opFilledCircle fun b => packColor (Pack.f32 (Pack.f32 (Pack.f32 b cx) cy) radius) c
+
+/-- Record `al_draw_circle`. -/
+def circle (dl : DrawList) (cx cy radius : Float) (c : Color) (thickness : Float := 1.0) : DrawList :=
+  dl.push opCircle fun b => packColor (f32x4 b cx cy radius thickness) c
+
+/-- Record `al_draw_text`. The string is copied into the list. -/
+def text (dl : DrawList) (font : Font) (c : Color) (x y : Float) (align : TextAlign) (s : String) : DrawList :=
+  dl.push opText fun b =>
+    Pack.str (Pack.u32 (Pack.f32 (Pack.f32 (packColor (Pack.u64 b font) c) x) y) align.val) s
+
+/-- Record `al_set_clipping_rectangle`. -/
+def clip (dl : DrawList) (x y : Int32) (w h : UInt32) : DrawList :=
+  dl.push opClip fun b => Pack.u32 (Pack.u32 (Pack.i32 (Pack.i32 b x) y) w) h
+
+/-- Record `al_reset_clipping_rectangle`. -/
+def resetClip (dl : DrawList) : DrawList :=
+  dl.push opResetClip id
+
+/-- Append all commands of `other` after those of `dl`. -/
+def append (dl other : DrawList) : DrawList :=
+  { bytes := dl.bytes ++ other.bytes, count := dl.count + other.count }
+
+instance : Append DrawList := ⟨append⟩
+
+@[extern "allegro_execute_draw_list"]
+private opaque executeRaw : @& ByteArray → IO UInt32
+
+/-- Replay the list on the current target bitmap and return the number of
+    commands executed. Execution stops early (returning a smaller count) at
+    an unknown opcode or a truncated record. Bitmap and text runs are drawn
+    under `al_hold_bitmap_drawing`; the caller's hold state is restored
+    afterwards. Must be called on the display thread. -/
+@[inline] def execute (dl : DrawList) : IO UInt32 := executeRaw dl.bytes
+
+end DrawList
+
+end Allegro
@@ -0,0 +1,217 @@
+import Allegro.Core
+import Allegro.Pack
+
+/-!
+# Image filters and resampling for memory bitmaps
+
+`applyFilter` runs a `Filter` over a whole memory bitmap in C: the bitmap is
+locked once, each pass is split into horizontal row bands, and the bands are
+run as Lean tasks (`IO.asTask`), one per CPU by default. Inner loops work on
+one pixel per SSE register; per-pixel filters are a single pass, blurs and
+convolutions two (the second waits for every band of the first).
+
+Only `ALLEGRO_MEMORY_BITMAP`s are accepted — video bitmaps would need their
+pixels downloaded and re-uploaded, and their locks are tied to the display
+thread. ARGB_8888, RGBA_8888 and ABGR_8888 bitmaps are filtered in place;
+other formats are locked as ABGR_8888 and converted by Allegro.
+
+`resizeBitmap` uses the same banded passes to scale any bitmap into a new
+memory bitmap with a box, bilinear or Lanczos-3 kernel, filtering in linear
+light with premultiplied alpha by default — suitable for thumbnails and
+mip chains, where `drawScaledBitmap` would only sample.
+
+## Example
+```
+setNewBitmapFlags BitmapFlags.memory
+let shot ← loadBitmap "screenshot.png"
+let _ ← shot.applyFilter (.gaussianBlur 2.5)
+let _ ← shot.applyFilter .grayscale
+let thumb ← shot.resize 256 144
+```
+
+The band workers call no Allegro functions, so running them on Lean's task
+pool is safe; `applyFilter` itself should be called from one thread at a
+time per bitmap. Parameters are sent as a packed buffer (see
+`Allegro.Pack`) whose opcodes match `FX_*` in `ffi/allegro_filter.c`.
+-/
+namespace Allegro
+
+/-- An image filter for `applyFilter`. Channel values are in 0–255 unless
+    noted. -/
+inductive Filter where
+  /-- Mean over a `(2r+1) × (2r+1)` square (edges clamped). Cost is
+      independent of the radius; `r` is capped at 256. -/
+  | boxBlur (radius : UInt32)
+  /-- Separable Gaussian blur with standard deviation `sigma` pixels
+      (kernel radius `⌈3σ⌉`, capped at 256). -/
+  | gaussianBlur (sigma : Float)
+  /-- 3×3 convolution of the colour channels: `kernel` is row-major (missing
+      entries are 0), `bias` is added in 0–1 units. Alpha is preserved. -/
+  | convolve3x3 (kernel : Array Float) (bias : Float)
+  /-- Colour matrix: row-major 4×5 over `(r, g, b, a, 1)`, channels in 0–1
+      (so the last column is an offset in 0–1 units). Missing entries are 0. -/
+  | colorMatrix (matrix : Array Float)
+  /-- Multiply colour channels by alpha. -/
+  | premultiplyAlpha
+  /-- Divide colour channels by alpha (pixels with alpha 0 are left as is). -/
+  | unpremultiplyAlpha
+  deriving Inhabited
+
+namespace Filter
+
+/-- Opcodes (must match `FX_*` in `ffi/allegro_filter.c`). -/
+private def opBoxBlur : UInt32 := 1
+private def opGaussianBlur : UInt32 := 2
+private def opConvolve3x3 : UInt32 := 3
+private def opColorMatrix : UInt32 := 4
+private def opPremultiply : UInt32 := 5
+private def opUnpremultiply : UInt32 := 6
+
+/-- Append the first `n` entries of `xs` as `f32`, padding with zeros. -/
+private def packFloats (b : ByteArray) (xs : Array Float) (n : Nat) : ByteArray := Id.run do
+  let mut b := b
+  for i in [0:n] do
+    b := Pack.f32 b (xs.getD i 0.0)
+  return b
+
+/-- Packed parameter buffer for the shim. -/
+def encode : Filter → ByteArray
+  | boxBlur r => Pack.u32 (Pack.u32 .empty opBoxBlur) r
+  | gaussianBlur s => Pack.f32 (Pack.u32 .empty opGaussianBlur) s
+  | convolve3x3 k bias => Pack.f32 (packFloats (Pack.u32 .empty opConvolve3x3) k 9) bias
+  | colorMatrix m => packFloats (Pack.u32 .empty opColorMatrix) m 20
+  | premultiplyAlpha => Pack.u32 .empty opPremultiply
+  | unpremultiplyAlpha => Pack.u32 .empty opUnpremultiply
+
+/-- Rec. 709 luma greyscale (alpha unchanged). -/
+def grayscale : Filter := colorMatrix #[
+  0.2126, 0.7152, 0.0722, 0, 0,
+  0.2126, 0.7152, 0.0722, 0, 0,
+  0.2126, 0.7152, 0.0722, 0, 0,
+  0,      0,      0,      1, 0]
+
+/-- Classic sharpen kernel. -/
+def sharpen : Filter := convolve3x3 #[0, -1, 0, -1, 5, -1, 0, -1, 0] 0
+
+/-- Laplacian edge detect. -/
+def edgeDetect : Filter := convolve3x3 #[-1, -1, -1, -1, 8, -1, -1, -1, -1] 0
+
+end Filter
+
+-- ── Shim entry points ──
+
+@[extern "allegro_filter_begin"]
+private opaque filterBegin : UInt64 → @&ByteArray → IO UInt64
+
+@[extern "allegro_filter_passes"]
+private opaque filterPasses : UInt64 → IO UInt32
+
+@[extern "allegro_filter_rows"]
+private opaque filterRows : UInt64 → UInt32 → IO UInt32
+
+@[extern "allegro_filter_run"]
+private opaque filterRun : UInt64 → UInt32 → UInt32 → UInt32 → IO Unit
+
+@[extern "allegro_filter_end"]
+private opaque filterEnd : UInt64 → IO UInt32
+
+@[extern "allegro_resample_begin"]
+private opaque resampleBegin : UInt64 → UInt64 → UInt32 → UInt32 → IO UInt64
+
+/-- Run every pass of `job`, each split into `bands` row bands run as
+    parallel tasks (`0` = one per CPU), then end the job. Returns `false` if
+    a band could not allocate its scratch memory. -/
+private def runJob (job : UInt64) (bands : Nat) : IO Bool := do
+  let want := if bands == 0 then (← getCpuCount).toNat else bands
+  try
+    for pass in [0:(← filterPasses job).toNat] do
+      let rows ← filterRows job pass.toUInt32
+      let n := max 1 (min want rows.toNat)
+      if n == 1 then
+        filterRun job pass.toUInt32 0 rows
+      else
+        let mut tasks := Array.mkEmpty n
+        for i in [0:n] do
+          let y0 := (rows.toNat * i / n).toUInt32
+          let y1 := (rows.toNat * (i + 1) / n).toUInt32
+          tasks := tasks.push (← IO.asTask (filterRun job pass.toUInt32 y0 y1))
+        for t in tasks do
+          let _ ← IO.wait t
+  catch e =>
+    let _ ← filterEnd job
+    throw e
+  return (← filterEnd job) != 0
+
+/-- Apply `f` to the whole memory bitmap `bmp`, split into `bands` row bands
+    per pass run as parallel tasks (`0` = one per CPU, see `getCpuCount`).
+    Returns 1 on success, 0 if `bmp` is null, not a memory bitmap, already
+    locked, or the parameters are invalid, or if a band ran out of scratch
+    memory (the bitmap is then only partly filtered). -/
+def applyFilter (bmp : UInt64) (f : Filter) (bands : Nat := 0) : IO UInt32 := do
+  let job ← filterBegin bmp f.encode
+  if job == 0 then return 0
+  return if (← runJob job bands) then 1 else 0
+
+/-- Dot-notation form of `applyFilter`. -/
+@[inline] def Bitmap.applyFilter (b : Bitmap) (f : Filter) (bands : Nat := 0) : IO UInt32 :=
+  Allegro.applyFilter b f bands
+
+-- ── Resampling ──
+
+/-- Reconstruction kernel for `resizeBitmap`. When shrinking, the kernel is
+    widened by the scale factor so every source pixel contributes. -/
+inductive ResampleFilter where
+  /-- Area average when shrinking, nearest neighbour when enlarging. -/
+  | box
+  /-- Triangle (tent) filter. -/
+  | bilinear
+  /-- Windowed sinc with three lobes: sharpest, may ring slightly at hard
+      edges. -/
+  | lanczos3
+  deriving BEq, Repr, Inhabited
+
+/-- Kernel id (must match `FX_KERNEL_*` in `ffi/allegro_filter.c`). -/
+private def ResampleFilter.kernelId : ResampleFilter → UInt32
+  | .box => 0
+  | .bilinear => 1
+  | .lanczos3 => 2
+
+/-- Scale `src` to `w × h` into a new memory bitmap, which the caller must
+    destroy. `src` may be any bitmap that is not locked (video bitmaps are
+    read back by Allegro). The result keeps `src`'s format if it is
+    ARGB_8888, RGBA_8888 or ABGR_8888, else it is ABGR_8888.
+
+    With `gammaCorrect` (default) colour channels are converted from sRGB to
+    linear light before filtering and back afterwards, so shrinking
+    high-contrast detail keeps its brightness. Colour is always filtered
+    premultiplied by alpha, so transparent pixels do not bleed. The two
+    passes are split into `bands` parallel row bands as in `applyFilter`.
+    Returns 0 on failure. -/
+def resizeBitmap (src : UInt64) (w h : UInt32) (filter : ResampleFilter := .lanczos3)
+    (gammaCorrect : Bool := true) (bands : Nat := 0) : IO UInt64 := do
+  if src == 0 || w == 0 || h == 0 then return 0
+  let srcFmt ← getBitmapFormat src
+  let fmt := if srcFmt == .argb8888 || srcFmt == .rgba8888 then srcFmt else PixelFormat.abgr8888
+  let oldFlags ← getNewBitmapFlags
+  let oldFormat ← getNewBitmapFormat
+  setNewBitmapFlags BitmapFlags.memory
+  setNewBitmapFormat fmt
+  let dst ← createBitmap w h
+  setNewBitmapFormat oldFormat
+  setNewBitmapFlags oldFlags
+  if dst == 0 then return 0
+  let job ← resampleBegin src dst filter.kernelId (if gammaCorrect then 1 else 0)
+  if job == 0 then
+    destroyBitmap dst
+    return 0
+  unless (← runJob job bands) do
+    destroyBitmap dst
+    return 0
+  return dst
+
+/-- Dot-notation form of `resizeBitmap`. -/
+@[inline] def Bitmap.resize (b : Bitmap) (w h : UInt32) (filter : ResampleFilter := .lanczos3)
+    (gammaCorrect : Bool := true) (bands : Nat := 0) : IO Bitmap :=
+  Allegro.resizeBitmap b w h filter gammaCorrect bands
+
+end Allegro
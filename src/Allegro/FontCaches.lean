@@ -0,0 +1,63 @@
+import Allegro.Core
+import Allegro.Addons
+
+/-!
+# Releasing fonts held by caches
+
+Several helpers remember results per font handle: `textLayoutCache`, every
+`TextSpriteCache` and the glyph pages recorded by `warmFontGlyphs`. Allegro
+may hand a destroyed font's handle to the next font it loads, so those
+entries must be dropped before the font is destroyed.
+
+Each such cache registers a per-font invalidator here.
+`invalidateFontCaches` runs all of them, and `releaseFont` / `Font.release`
+does that and then calls `destroyFont`, so one call replaces the
+per-cache `invalidateFont` calls. Caches of your own can join with
+`registerFontInvalidator`. The registry is not synchronised; register and
+release fonts from one thread.
+
+## Example
+```
+let font ← loadTtfFont "data/DejaVuSans.ttf" 16 0
+let _ ← cachedTextWidth font "Score"
+…
+font.release          -- instead of invalidateFont font; font.destroy
+```
+-/
+namespace Allegro
+
+/-- Registered invalidators with their ids. -/
+private initialize fontInvalidators : IO.Ref (Array (Nat × (Font → IO Unit))) ← IO.mkRef #[]
+
+/-- Next id handed out by `registerFontInvalidator`. -/
+private initialize nextFontInvalidator : IO.Ref Nat ← IO.mkRef 0
+
+/-- Run `f font` for every font passed to `invalidateFontCaches` or
+    `releaseFont`, until `unregisterFontInvalidator` is called with the
+    returned id. -/
+def registerFontInvalidator (f : Font → IO Unit) : IO Nat := do
+  let id ← nextFontInvalidator.modifyGet fun n => (n, n + 1)
+  fontInvalidators.modify (·.push (id, f))
+  return id
+
+/-- Remove an invalidator added by `registerFontInvalidator`. Unknown ids
+    are ignored. -/
+def unregisterFontInvalidator (id : Nat) : IO Unit :=
+  fontInvalidators.modify (·.filter (·.1 != id))
+
+/-- Drop `font` from every registered cache, in registration order. -/
+def invalidateFontCaches (font : Font) : IO Unit := do
+  for (_, f) in ← fontInvalidators.get do
+    f font
+
+/-- `invalidateFontCaches font`, then `destroyFont font`. Does nothing for
+    a null font. -/
+def releaseFont (font : Font) : IO Unit := do
+  if font == 0 then return
+  invalidateFontCaches font
+  destroyFont font
+
+/-- Dot-notation form of `releaseFont`. -/
+@[inline] def Font.release (f : Font) : IO Unit := releaseFont f
+
+end Allegro
@@ -0,0 +1,173 @@
+import Allegro.Core
+import Allegro.Addons
+import Allegro.Pack
+import Allegro.FontCaches
+import Std.Data.HashMap
+import Std.Data.HashSet
+
+/-!
+# TTF glyph pre-rasterisation
+
+TTF fonts render each glyph into their page bitmaps the first time it is
+drawn, so the first frame showing a new dialogue line or script can stall.
+`warmFontGlyphs` forces that work up front: it calls `al_get_glyph` for
+every codepoint of the given `GlyphSet`s in one shim call and reports the
+time taken and the glyph pages involved.
+
+For a loading screen, a `GlyphWarmer` does the same work in slices:
+call `step` once per frame with a time budget until it returns `true`, and
+show `progress`.
+
+```
+let report ← warmFontGlyphs font #[GlyphSet.ascii, GlyphSet.latin1, .text dialogue]
+IO.println s!"{report.glyphs} glyphs in {report.elapsedMs} ms, {report.newPages} new pages"
+```
+
+Glyph pages are bitmaps, so warming must run on the thread that draws with
+the font (the display thread) with the same new-bitmap flags. Allegro does
+not expose a font's page count; `newPages` counts pages that no earlier
+`warmFontGlyphs` / `GlyphWarmer` for the same font handle had seen, which is
+exact when the font is warmed before any text is drawn with it. Those pages
+are remembered per handle until `forgetFontGlyphs`, which must run before
+the font is destroyed since a later font may reuse the handle;
+`releaseFont` calls it.
+-/
+namespace Allegro
+
+/-- Codepoints to pre-rasterise. -/
+inductive GlyphSet where
+  /-- Every codepoint in `first … last` (inclusive). -/
+  | range (first last : UInt32)
+  /-- The distinct codepoints of a corpus string (e.g. a dialogue script). -/
+  | text (s : String)
+  deriving Inhabited
+
+namespace GlyphSet
+
+/-- Printable ASCII, U+0020 … U+007E. -/
+def ascii : GlyphSet := range 0x20 0x7E
+
+/-- Latin-1 Supplement letters and symbols, U+00A0 … U+00FF. -/
+def latin1 : GlyphSet := range 0xA0 0xFF
+
+end GlyphSet
+
+/-- Distinct codepoints of `sets` in first-seen order, packed as `u32`s. -/
+def glyphCodepoints (sets : Array GlyphSet) : ByteArray := Id.run do
+  let mut seen : Std.HashSet UInt32 := {}
+  let mut out := ByteArray.empty
+  for set in sets do
+    let cps : Array UInt32 := match set with
+      | .range a b => if b < a then #[] else (Array.range (b - a + 1).toNat).map (a + ·.toUInt32)
+      | .text s => s.toList.toArray.map (·.val)
+    for cp in cps do
+      if !seen.contains cp then
+        seen := seen.insert cp
+        out := Pack.u32 out cp
+  return out
+
+/-- Result of warming a font. -/
+structure GlyphWarmReport where
+  /-- Codepoints requested (after removing duplicates). -/
+  requested : Nat := 0
+  /-- Codepoints the font has a glyph for. -/
+  glyphs    : Nat := 0
+  /-- Distinct glyph pages holding those glyphs. -/
+  pages     : Nat := 0
+  /-- Pages first seen by this warm-up (see the module docs). -/
+  newPages  : Nat := 0
+  /-- Wall-clock time spent in the shim. -/
+  elapsedMs : Float := 0
+  deriving Repr, Inhabited
+
+@[extern "allegro_warm_font_glyphs"]
+private opaque warmGlyphsRaw : Font → @& ByteArray → UInt32 → Float → IO (UInt32 × UInt32 × ByteArray)
+
+/-- Page handle `i` of the shim's packed `u64` list. -/
+private def pageAt (b : ByteArray) (i : Nat) : UInt64 :=
+  (Pack.readU32 b (8 * i)).toUInt64 ||| ((Pack.readU32 b (8 * i + 4)).toUInt64 <<< 32)
+
+/-- Pages seen per font handle by earlier warm-ups. -/
+initialize knownGlyphPages : IO.Ref (Std.HashMap UInt64 (Std.HashSet UInt64)) ← IO.mkRef {}
+
+/-- Forget the glyph pages recorded for `font`. Call before destroying it
+    (`releaseFont` does). -/
+def forgetFontGlyphs (font : Font) : IO Unit :=
+  knownGlyphPages.modify (·.erase font)
+
+initialize
+  discard <| registerFontInvalidator forgetFontGlyphs
+
+/-- Incremental warm-up of one font, for loading screens. -/
+structure GlyphWarmer where
+  /-- Font being warmed. -/
+  font       : Font
+  /-- Packed little-endian `u32` codepoints (`glyphCodepoints`). -/
+  codepoints : ByteArray
+  /-- Index of the next codepoint `step` processes. -/
+  next       : IO.Ref Nat
+  /-- Distinct glyph pages touched so far. -/
+  pages      : IO.Ref (Std.HashSet UInt64)
+  /-- Report accumulated over the steps so far (see `report`). -/
+  totals     : IO.Ref GlyphWarmReport
+
+namespace GlyphWarmer
+
+/-- Prepare to warm `sets` in `font`. Nothing is rasterised yet. -/
+def create (font : Font) (sets : Array GlyphSet) : IO GlyphWarmer := do
+  let codepoints := glyphCodepoints sets
+  return { font, codepoints, next := ← IO.mkRef 0, pages := ← IO.mkRef {},
+           totals := ← IO.mkRef { requested := codepoints.size / 4 } }
+
+/-- Whether every codepoint has been processed. -/
+def done (w : GlyphWarmer) : IO Bool :=
+  return (← w.next.get) * 4 ≥ w.codepoints.size
+
+/-- Fraction of codepoints processed, in `[0, 1]`. -/
+def progress (w : GlyphWarmer) : IO Float := do
+  let n := w.codepoints.size / 4
+  if n == 0 then return 1.0
+  return (← w.next.get).toFloat / n.toFloat
+
+/-- Rasterise codepoints for about `budgetMs` milliseconds (`0` = until
+    done). Returns `true` once every codepoint has been processed. -/
+def step (w : GlyphWarmer) (budgetMs : Float := 4.0) : IO Bool := do
+  if (← w.done) then return true
+  let t0 ← IO.monoNanosNow
+  let (next, found, pageBytes) ← warmGlyphsRaw w.font w.codepoints (← w.next.get).toUInt32 budgetMs
+  let t1 ← IO.monoNanosNow
+  w.next.set next.toNat
+  let fresh ← knownGlyphPages.modifyGet fun m => Id.run do
+    let mut known := m.getD w.font {}
+    let mut fresh := 0
+    for i in [0:pageBytes.size / 8] do
+      let h := pageAt pageBytes i
+      if !known.contains h then
+        known := known.insert h
+        fresh := fresh + 1
+    return (fresh, m.insert w.font known)
+  let mut pages ← w.pages.get
+  for i in [0:pageBytes.size / 8] do
+    pages := pages.insert (pageAt pageBytes i)
+  w.pages.set pages
+  w.totals.modify fun r =>
+    { r with glyphs := r.glyphs + found.toNat, pages := pages.size, newPages := r.newPages + fresh,
+             elapsedMs := r.elapsedMs + (t1 - t0).toFloat / 1.0e6 }
+  w.done
+
+/-- Totals so far. -/
+def report (w : GlyphWarmer) : IO GlyphWarmReport := w.totals.get
+
+end GlyphWarmer
+
+/-- Rasterise every glyph of `sets` in `font` now, in one shim call. -/
+def warmFontGlyphs (font : Font) (sets : Array GlyphSet) : IO GlyphWarmReport := do
+  let w ← GlyphWarmer.create font sets
+  let _ ← w.step 0
+  w.report
+
+/-- Dot-notation form of `warmFontGlyphs`. -/
+@[inline] def Font.warmGlyphs (f : Font) (sets : Array GlyphSet) : IO GlyphWarmReport :=
+  warmFontGlyphs f sets
+
+end Allegro
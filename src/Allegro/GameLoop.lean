@@ -82,6 +82,14 @@ inductive GameEvent where
   | other (evType : EventType)
   deriving Repr
 
+/-- Like `drainEventData`, but the shim builds `GameEvent` values directly
+    from the native event: no intermediate `EventData`, and mouse
+    coordinates arrive as `Float` without a `Nat` round-trip. Queue
+    filters (`setEventQueueDropType`, `setEventQueueCoalesce`) apply.
+    Resize events are *not* acknowledged; call `acknowledgeResize`. -/
+@[extern "allegro_al_drain_game_events"]
+opaque drainGameEvents : EventQueue → UInt32 → IO (Array GameEvent)
+
 private def initAddon (flag : AddonFlag) : IO Unit := do
   match flag with
   | .primitives    => let _ ← initPrimitivesAddon; pure ()
@@ -95,6 +103,9 @@ private def initAddon (flag : AddonFlag) : IO Unit := do
   | .joystick      => let _ ← installJoystick; pure ()
   | .nativeDialogs => let _ ← initNativeDialogAddon; pure ()
 
+/-- Upper bound on events handled per `drainGameEvents` call in `runGameLoop`. -/
+private def eventBatchSize : UInt32 := 256
+
 /-- Run a game loop with automatic setup and teardown.
 
     - `cfg`: game configuration (display size, fps, addons)
@@ -102,6 +113,9 @@ private def initAddon (flag : AddonFlag) : IO Unit := do
     - `onEvent`: called for each event; return `some newState` to continue or `none` to quit
     - `draw`: called once per frame after all events are processed
 
+    Events are pulled with `drainGameEvents`, so a burst of queued input is
+    decoded in C and handled in a single pass before the next redraw check.
+
     All Allegro resources (display, timer, event queue) are managed automatically. -/
 def runGameLoop (cfg : GameConfig)
     (initState : Display → IO σ)
@@ -136,43 +150,19 @@ def runGameLoop (cfg : GameConfig)
         let mut running := true
         let mut redraw := false
         while running do
-          let evData ← waitForEventData queue
-          let gameEvent ←
-            if evData.type == EventType.displayClose then
-              pure GameEvent.quit
-            else if evData.type == EventType.timer then
-              pure GameEvent.tick
-            else if evData.type == EventType.keyDown then
-              pure (GameEvent.keyDown ⟨evData.a⟩)
-            else if evData.type == EventType.keyUp then
-              pure (GameEvent.keyUp ⟨evData.a⟩)
-            else if evData.type == EventType.keyChar then
-              pure (GameEvent.keyChar ⟨evData.a⟩ evData.b)
-            else if evData.type == EventType.mouseAxes then
-              let xf := Float.ofScientific evData.a.toNat false 0
-              let yf := Float.ofScientific evData.b.toNat false 0
-              pure (GameEvent.mouseMove xf yf)
-            else if evData.type == EventType.mouseButtonDown then
-              let xf := Float.ofScientific evData.a.toNat false 0
-              let yf := Float.ofScientific evData.b.toNat false 0
-              pure (GameEvent.mouseDown evData.i xf yf)
-            else if evData.type == EventType.mouseButtonUp then
-              let xf := Float.ofScientific evData.a.toNat false 0
-              let yf := Float.ofScientific evData.b.toNat false 0
-              pure (GameEvent.mouseUp evData.i xf yf)
-            else if evData.type == EventType.displayResize then
+          let batch ← drainGameEvents queue eventBatchSize
+          for gameEvent in batch do
+            if let GameEvent.resize _ _ := gameEvent then
               let _ ← acknowledgeResize display
-              pure (GameEvent.resize evData.c evData.d)
-            else
-              pure (GameEvent.other evData.type)
-          match gameEvent with
-          | GameEvent.tick => redraw := true; state ← match ← onEvent state gameEvent with
-              | some s => pure s
-              | none => do running := false; pure state
-          | GameEvent.quit => running := false
-          | _ => state ← match ← onEvent state gameEvent with
-              | some s => pure s
-              | none => do running := false; pure state
+            match gameEvent with
+            | GameEvent.tick => redraw := true; state ← match ← onEvent state gameEvent with
+                | some s => pure s
+                | none => do running := false; pure state
+            | GameEvent.quit => running := false
+            | _ => state ← match ← onEvent state gameEvent with
+                | some s => pure s
+                | none => do running := false; pure state
+            if !running then break
           -- Draw when queue is empty and we have a pending tick
           if redraw then
             let empty ← isEventQueueEmpty queue
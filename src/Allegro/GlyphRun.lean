@@ -0,0 +1,123 @@
+import Allegro.Core
+import Allegro.Addons
+import Allegro.Pack
+
+/-!
+# Pre-shaped glyph runs
+
+`drawTextRgb` looks up every glyph, applies kerning and issues one bitmap
+draw per glyph each time it is called. For HUD text that changes rarely,
+`shapeGlyphRun` does that work once — one FFI call walks the string with
+`al_get_glyph` and `al_get_glyph_advance` (which includes kerning) — and
+keeps the result as positioned quads: glyph page, source rectangle and
+offset from the draw origin. `drawGlyphRun` then draws the run at any
+position and tint with one `al_draw_prim` per glyph page.
+
+A run refers to its font's glyph pages, so it must not be drawn after the
+font is destroyed. TTF fonts add pages as new glyphs are rasterised but
+never move existing glyphs, so older runs stay valid. Fallback fonts are
+not consulted; codepoints the font lacks only advance the pen. Newlines are
+not interpreted.
+
+## Example
+```
+let score ← shapeGlyphRun font s!"SCORE {n}"   -- when the score changes
+…
+let _ ← drawGlyphRun score 16 16 (Color.rgb 255 220 0)   -- every frame
+```
+-/
+namespace Allegro
+
+/-- One glyph of a `GlyphRun`. -/
+structure GlyphQuad where
+  /-- Glyph page bitmap. -/
+  page : UInt64
+  /-- Left edge of the source rectangle within `page`. -/
+  sx : Float
+  /-- Top edge of the source rectangle within `page`. -/
+  sy : Float
+  /-- Source rectangle width (also the drawn width). -/
+  sw : Float
+  /-- Source rectangle height (also the drawn height). -/
+  sh : Float
+  /-- Left edge relative to the draw origin. -/
+  dx : Float
+  /-- Top edge relative to the draw origin (the top of the line). -/
+  dy : Float
+  deriving BEq, Repr, Inhabited
+
+/-- A shaped string. `bytes` holds 32-byte records, grouped by page:
+    the page handle as `u64`, then `sx sy sw sh dx dy` as `f32`
+    (little-endian; see `allegro_shape_glyph_run` in `ffi/allegro_font.c` and
+    `GLYPH_RUN_RECORD` in `ffi/allegro_ffi.h`). -/
+structure GlyphRun where
+  /-- Encoded glyph records. -/
+  bytes   : ByteArray := .empty
+  /-- Pen advance over the whole string, in pixels (used for alignment). -/
+  advance : Float := 0
+  deriving Inhabited
+
+namespace GlyphRun
+
+/-- Bytes per glyph record. -/
+def recordSize : Nat := 32
+
+/-- Number of glyph quads (glyphs without an image, like spaces, have
+    none). -/
+@[inline] def size (r : GlyphRun) : Nat := r.bytes.size / recordSize
+
+/-- Quad `i`, in draw order. -/
+def quad? (r : GlyphRun) (i : Nat) : Option GlyphQuad :=
+  if i < r.size then
+    let o := i * recordSize
+    let page := (Pack.readU32 r.bytes o).toUInt64 ||| ((Pack.readU32 r.bytes (o + 4)).toUInt64 <<< 32)
+    let f (k : Nat) := Pack.readF32 r.bytes (o + 8 + 4 * k)
+    some { page, sx := f 0, sy := f 1, sw := f 2, sh := f 3, dx := f 4, dy := f 5 }
+  else none
+
+/-- All quads, in draw order. -/
+def quads (r : GlyphRun) : Array GlyphQuad :=
+  (Array.range r.size).filterMap r.quad?
+
+/-- Number of distinct glyph pages, i.e. `al_draw_prim` calls per draw. -/
+def pageCount (r : GlyphRun) : Nat := Id.run do
+  let mut n := 0
+  let mut last : UInt64 := 0
+  for q in r.quads do
+    if q.page != last then
+      n := n + 1
+      last := q.page
+  return n
+
+end GlyphRun
+
+@[extern "allegro_shape_glyph_run"]
+private opaque shapeGlyphRunRaw : Font → @& String → IO (ByteArray × Float)
+
+@[extern "allegro_draw_glyph_run"]
+private opaque drawGlyphRunRaw : @& ByteArray → Float → Float → UInt32 → IO UInt32
+
+/-- Shape `text` in `font` once. Returns an empty run if `font` is null. -/
+def shapeGlyphRun (font : Font) (text : String) : IO GlyphRun := do
+  let (bytes, advance) ← shapeGlyphRunRaw font text
+  return { bytes, advance }
+
+/-- Draw `run` with its line top at `y`, tinted by `tint` like
+    `drawTextRgba`. `align` positions the pen advance around `x` as for
+    `drawTextRgb`. Returns the number of `al_draw_prim` calls (one per
+    glyph page). -/
+def drawGlyphRun (run : GlyphRun) (x y : Float) (tint : Color := Color.rgb 255 255 255)
+    (align : TextAlign := TextAlign.left) : IO UInt32 :=
+  let (x, y) := align.penOrigin run.advance x y
+  drawGlyphRunRaw run.bytes x y tint.pack
+
+/-- Dot-notation form of `drawGlyphRun`. -/
+@[inline] def GlyphRun.draw (run : GlyphRun) (x y : Float) (tint : Color := Color.rgb 255 255 255)
+    (align : TextAlign := TextAlign.left) : IO UInt32 :=
+  drawGlyphRun run x y tint align
+
+/-- Dot-notation form of `shapeGlyphRun`. -/
+@[inline] def Font.shape (f : Font) (text : String) : IO GlyphRun :=
+  shapeGlyphRun f text
+
+end Allegro
@@ -0,0 +1,57 @@
+/-!
+# Little-endian byte packing
+
+Helpers for building the packed `ByteArray` buffers that batched shim
+functions read in a single call (`DrawList`, sprite and primitive batches).
+Values are appended little-endian with no padding; the C side reads each
+field with `memcpy`, so records need not be aligned.
+
+Floats are stored as IEEE-754 single precision, which is what Allegro's
+drawing functions take anyway.
+-/
+namespace Allegro.Pack
+
+/-- Append one byte. -/
+@[inline] def u8 (b : ByteArray) (v : UInt8) : ByteArray := b.push v
+
+/-- Append a `UInt32` (4 bytes, little-endian). -/
+@[inline] def u32 (b : ByteArray) (v : UInt32) : ByteArray :=
+  b.push v.toUInt8 |>.push (v >>> 8).toUInt8 |>.push (v >>> 16).toUInt8 |>.push (v >>> 24).toUInt8
+
+/-- Append an `Int32` (4 bytes, two's complement, little-endian). -/
+@[inline] def i32 (b : ByteArray) (v : Int32) : ByteArray := u32 b v.toUInt32
+
+/-- Append a `UInt64` (8 bytes, little-endian). -/
+@[inline] def u64 (b : ByteArray) (v : UInt64) : ByteArray :=
+  u32 (u32 b v.toUInt32) (v >>> 32).toUInt32
+
+/-- Append a `Float` narrowed to 32-bit IEEE-754 (4 bytes, little-endian). -/
+@[inline] def f32 (b : ByteArray) (v : Float) : ByteArray := u32 b v.toFloat32.toBits
+
+/-- Append a string's UTF-8 bytes prefixed with their length as `UInt32`. -/
+@[inline] def str (b : ByteArray) (s : String) : ByteArray :=
+  let bytes := s.toUTF8
+  u32 b bytes.size.toUInt32 ++ bytes
+
+/-- Overwrite 4 bytes at offset `i` with `v` (little-endian). In place when
+    `b` is uniquely referenced; out-of-range writes are dropped. -/
+@[inline] def setU32 (b : ByteArray) (i : Nat) (v : UInt32) : ByteArray :=
+  if i + 4 ≤ b.size then
+    b.set! i v.toUInt8 |>.set! (i+1) (v >>> 8).toUInt8 |>.set! (i+2) (v >>> 16).toUInt8 |>.set! (i+3) (v >>> 24).toUInt8
+  else b
+
+/-- Overwrite 4 bytes at offset `i` with `v` as a 32-bit float. -/
+@[inline] def setF32 (b : ByteArray) (i : Nat) (v : Float) : ByteArray := setU32 b i v.toFloat32.toBits
+
+/-- Byte at offset `i`, or `0` past the end. -/
+@[inline] private def byteAt (b : ByteArray) (i : Nat) : UInt32 :=
+  if h : i < b.size then b[i].toUInt32 else 0
+
+/-- Read a `UInt32` at byte offset `i` (little-endian); missing bytes read as `0`. -/
+def readU32 (b : ByteArray) (i : Nat) : UInt32 :=
+  byteAt b i ||| (byteAt b (i+1) <<< 8) ||| (byteAt b (i+2) <<< 16) ||| (byteAt b (i+3) <<< 24)
+
+/-- Read a 32-bit float at byte offset `i` (little-endian), widened to `Float`. -/
+def readF32 (b : ByteArray) (i : Nat) : Float := (Float32.ofBits (readU32 b i)).toFloat
+
+end Allegro.Pack
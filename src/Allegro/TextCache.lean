@@ -0,0 +1,229 @@
+import Allegro.Core
+import Allegro.Addons
+import Allegro.FontCaches
+import Std.Data.HashMap
+
+/-!
+# Text measurement and word-wrap cache
+
+UI code tends to measure and wrap the same labels every frame. Each
+`getTextWidth` walks the glyphs in Allegro, and `doMultilineText` also
+builds a C line array and a fresh `Array String` per call. A
+`TextLayoutCache` remembers the results per (font, text, max width):
+
+* `width`, `bounds` and `wrap` look the key up in a Lean hash map and only
+  call into Allegro on a miss — a hit never crosses the FFI boundary and
+  returns the stored value (the cached line array is shared, not copied).
+* Memory is bounded by a byte budget (text and line bytes plus a fixed
+  per-entry overhead). When it is exceeded, the least recently used
+  entries are dropped down to three quarters of the budget in one sweep,
+  so eviction is amortised over many inserts.
+* `stats` reports hits, misses, evictions, entry count and bytes.
+
+Results depend only on the font handle, and a later font may reuse it. The
+process-wide `textLayoutCache`, which backs `cachedTextWidth`,
+`cachedTextBounds` and `cachedMultilineText`, is registered with
+`releaseFont`, so releasing a font that way clears its entries; call
+`TextLayoutCache.invalidateFont` yourself for caches you create. The cache is not synchronised; use it from one
+thread.
+
+## Example
+```
+let w ← cachedTextWidth font label        -- first call measures
+let w ← cachedTextWidth font label        -- later calls: no FFI
+let lines ← cachedMultilineText font 240 tooltip
+…
+font.release                              -- drops the cached entries too
+```
+-/
+namespace Allegro
+
+/-- Counters and sizes reported by `TextLayoutCache.stats`. -/
+structure TextCacheStats where
+  /-- Queries answered from the cache. -/
+  hits      : Nat
+  /-- Queries that measured the text and stored the result. -/
+  misses    : Nat
+  /-- Entries dropped to stay within the budget. -/
+  evictions : Nat
+  /-- Entries currently held. -/
+  entries   : Nat
+  /-- Approximate bytes held (see `TextLayoutCache.create`). -/
+  bytes     : Nat
+  /-- Byte budget (`TextLayoutCache.create` / `setBudget`). -/
+  budget    : Nat
+  deriving Repr
+
+/-- What a cached entry holds. -/
+private inductive TextQuery where
+  | width
+  | bounds
+  | wrap
+  deriving BEq, Hashable
+
+/-- Cache key; `maxWidth` holds the bits of the wrap width (0 for
+    measurements). The text is kept so hash collisions compare unequal. -/
+private structure TextKey where
+  font     : UInt64
+  query    : TextQuery
+  maxWidth : UInt64
+  text     : String
+  deriving BEq, Hashable
+
+private inductive TextValue where
+  | width (w : UInt32)
+  | bounds (r : Rect)
+  | lines (ls : Array String)
+  deriving Inhabited
+
+private structure TextEntry where
+  value   : TextValue
+  bytes   : Nat
+  lastUse : Nat
+  deriving Inhabited
+
+private structure TextCacheState where
+  entries   : Std.HashMap TextKey TextEntry := {}
+  bytes     : Nat := 0
+  budget    : Nat
+  clock     : Nat := 0
+  hits      : Nat := 0
+  misses    : Nat := 0
+  evictions : Nat := 0
+
+/-- Memoised text measurements and line breaks; see the module docs. -/
+structure TextLayoutCache where
+  state : IO.Ref TextCacheState
+  deriving Nonempty
+
+namespace TextLayoutCache
+
+/-- Fixed bytes charged per entry on top of its strings. -/
+private def entryOverhead : Nat := 64
+
+/-- Create an empty cache holding about `budget` bytes. -/
+def create (budget : Nat := 4 * 1024 * 1024) : IO TextLayoutCache :=
+  return { state := ← IO.mkRef { budget } }
+
+/-- Drop least recently used entries until at most 3/4 of the budget is
+    used. -/
+private def shrink (s : TextCacheState) : TextCacheState := Id.run do
+  let target := s.budget * 3 / 4
+  let byAge := s.entries.toArray.qsort (fun a b => a.2.lastUse < b.2.lastUse)
+  let mut entries := s.entries
+  let mut bytes := s.bytes
+  let mut dropped := 0
+  for (k, e) in byAge do
+    if bytes ≤ target then break
+    entries := entries.erase k
+    bytes := bytes - e.bytes
+    dropped := dropped + 1
+  return { s with entries, bytes, evictions := s.evictions + dropped }
+
+/-- Cached value for `key`, computing and storing it with `compute` on a
+    miss. -/
+private def lookup (c : TextLayoutCache) (key : TextKey) (compute : IO TextValue) : IO TextValue := do
+  let hit ← c.state.modifyGet fun s =>
+    match s.entries[key]? with
+    | some e =>
+      let clock := s.clock + 1
+      (some e.value, { s with clock, hits := s.hits + 1,
+                              entries := s.entries.insert key { e with lastUse := clock } })
+    | none => (none, s)
+  if let some v := hit then return v
+  let v ← compute
+  let lineBytes := match v with
+    | .lines ls => ls.foldl (fun n l => n + l.utf8ByteSize + 16) 0
+    | _ => 0
+  let bytes := entryOverhead + key.text.utf8ByteSize + lineBytes
+  c.state.modify fun s =>
+    let clock := s.clock + 1
+    let s := { s with clock, misses := s.misses + 1, bytes := s.bytes + bytes,
+                      entries := s.entries.insert key { value := v, bytes, lastUse := clock } }
+    if s.bytes > s.budget then shrink s else s
+  return v
+
+/-- `getTextWidth font text`, memoised. -/
+def width (c : TextLayoutCache) (font : Font) (text : String) : IO UInt32 := do
+  match ← lookup c { font, query := .width, maxWidth := 0, text }
+      (do return .width (← getTextWidth font text)) with
+  | .width w => return w
+  | _ => return 0
+
+/-- `getTextBounds font text`, memoised. -/
+def bounds (c : TextLayoutCache) (font : Font) (text : String) : IO Rect := do
+  match ← lookup c { font, query := .bounds, maxWidth := 0, text }
+      (do return .bounds (← getTextBounds font text)) with
+  | .bounds r => return r
+  | _ => return {}
+
+/-- `doMultilineText font maxWidth text`, memoised. -/
+def wrap (c : TextLayoutCache) (font : Font) (maxWidth : Float) (text : String) : IO (Array String) := do
+  match ← lookup c { font, query := .wrap, maxWidth := maxWidth.toBits, text }
+      (do return .lines (← doMultilineText font maxWidth text)) with
+  | .lines ls => return ls
+  | _ => return #[]
+
+/-- Forget every entry for `font`. Call before destroying it. -/
+def invalidateFont (c : TextLayoutCache) (font : Font) : IO Unit :=
+  c.state.modify fun s =>
+    let (entries, bytes) := s.entries.fold (init := (({} : Std.HashMap TextKey TextEntry), 0))
+      fun (m, n) k e => if k.font == font then (m, n) else (m.insert k e, n + e.bytes)
+    { s with entries, bytes }
+
+/-- Forget every entry. -/
+def clear (c : TextLayoutCache) : IO Unit :=
+  c.state.modify fun s => { s with entries := {}, bytes := 0 }
+
+/-- Change the byte budget, evicting if it is now exceeded. -/
+def setBudget (c : TextLayoutCache) (budget : Nat) : IO Unit :=
+  c.state.modify fun s =>
+    let s := { s with budget }
+    if s.bytes > budget then shrink s else s
+
+/-- Current counters and sizes. -/
+def stats (c : TextLayoutCache) : IO TextCacheStats := do
+  let s ← c.state.get
+  return { hits := s.hits, misses := s.misses, evictions := s.evictions,
+           entries := s.entries.size, bytes := s.bytes, budget := s.budget }
+
+/-- Zero the hit / miss / eviction counters. -/
+def resetStats (c : TextLayoutCache) : IO Unit :=
+  c.state.modify fun s => { s with hits := 0, misses := 0, evictions := 0 }
+
+end TextLayoutCache
+
+/-- Process-wide text layout cache (4 MiB budget). -/
+initialize textLayoutCache : TextLayoutCache ← TextLayoutCache.create
+
+initialize
+  discard <| registerFontInvalidator textLayoutCache.invalidateFont
+
+/-- `getTextWidth` through `textLayoutCache`. -/
+@[inline] def cachedTextWidth (font : Font) (text : String) : IO UInt32 :=
+  textLayoutCache.width font text
+
+/-- `getTextBounds` through `textLayoutCache`. -/
+@[inline] def cachedTextBounds (font : Font) (text : String) : IO Rect :=
+  textLayoutCache.bounds font text
+
+/-- `doMultilineText` through `textLayoutCache`. -/
+@[inline] def cachedMultilineText (font : Font) (maxWidth : Float) (text : String) : IO (Array String) :=
+  textLayoutCache.wrap font maxWidth text
+
+/-- Drop `font`'s entries from `textLayoutCache`. `releaseFont` does this
+    along with every other registered per-font cache. -/
+@[inline] def invalidateFont (font : Font) : IO Unit :=
+  textLayoutCache.invalidateFont font
+
+/-- Dot-notation form of `cachedTextWidth`. -/
+@[inline] def Font.cachedWidth (f : Font) (text : String) : IO UInt32 := cachedTextWidth f text
+
+/-- Dot-notation form of `cachedTextBounds`. -/
+@[inline] def Font.cachedBounds (f : Font) (text : String) : IO Rect := cachedTextBounds f text
+
+/-- Dot-notation form of `cachedMultilineText`. -/
+@[inline] def Font.cachedMultiline (f : Font) (maxWidth : Float) (text : String) : IO (Array String) :=
+  cachedMultilineText f maxWidth text
+
+end Allegro
@@ -0,0 +1,323 @@
+import Allegro.Core
+import Allegro.Addons
+import Allegro.FontCaches
+import Std.Data.HashMap
+
+/-!
+# Cached text sprites
+
+Text that never changes (menu items, credits, tooltips) does not need to be
+re-drawn glyph by glyph every frame. `TextSprite.create` renders a string
+once into an off-screen bitmap; `TextSprite.draw` is then a single
+`drawBitmapRegion`.
+
+Text is rendered onto a transparent bitmap with the premultiplied-alpha
+blender (`add`, `one`, `inverseAlpha`) and the colour premultiplied by its
+alpha, so the sprite holds premultiplied pixels and composites correctly
+under Allegro's default blender; for an opaque colour it matches
+`drawTextRgb`. The sprite is padded by one
+transparent pixel and positioned from `getTextBounds`, so drawing it at
+`(x, y)` covers the same pixels as drawing the text there.
+
+A `TextSpriteCache` keeps sprites keyed by (font, text, colour):
+
+* Sprite bitmaps are allocated in size classes (each side rounded up to a
+  power of two, at least 16) and returned to a per-class pool when a sprite
+  is evicted or invalidated, so churning labels reuse bitmaps instead of
+  allocating new ones.
+* When more than `maxSprites` are cached, the least recently used quarter
+  is returned to the pool. At most `maxPooled` idle bitmaps are kept.
+* A sprite returned by `get` belongs to the cache. Its bitmap may be
+  pooled, and later redrawn with other text, by any later `get` that
+  evicts it, or by `invalidateFont` / `clear` / `destroy`, so draw it
+  before the next `get` (as `TextSpriteCache.draw` does). `get` never
+  evicts the sprite it is returning.
+* A sprite does not depend on its font after rendering, but a later font
+  may reuse the handle. Each cache registers with `releaseFont` from
+  `create` until `destroy`, so releasing a font that way drops its sprites;
+  otherwise call `invalidateFont` before destroying the font.
+
+Sprites are ordinary bitmaps created with the calling thread's new-bitmap
+flags; create and draw them on the display thread, and destroy the cache
+before the display.
+
+## Example
+```
+let menu ← TextSpriteCache.create
+-- every frame:
+for i in [0:labels.size] do
+  menu.draw font labels[i]! (Color.rgb 255 255 255) 320 (100 + 24 * i.toFloat) TextAlign.centre
+```
+-/
+namespace Allegro
+
+/-- A string pre-rendered into (a region of) a bitmap. -/
+structure TextSprite where
+  /-- Bitmap holding the text in its top-left `width × height` pixels
+      (0 for empty text or if the bitmap could not be created). -/
+  bitmap  : Bitmap := (0 : UInt64)
+  /-- Width of the used region: the text bounds plus a 1-pixel border. -/
+  width   : UInt32 := 0
+  /-- Height of the used region: the text bounds plus a 1-pixel border. -/
+  height  : UInt32 := 0
+  /-- Horizontal position of the region's top-left corner relative to the
+      text origin. -/
+  originX : Float := 0
+  /-- Vertical position of the region's top-left corner relative to the
+      text origin (the top of the line). -/
+  originY : Float := 0
+  /-- `getTextWidth` of the text, used for alignment. -/
+  advance : Float := 0
+  deriving Inhabited
+
+/-- Transparent border around the rendered text. -/
+private def spritePad : Int32 := 1
+
+@[inline] private def i32f (v : Int32) : Float := Float.ofInt v.toInt
+
+/-- Render `text` into the top-left of `bmp` (whose size must cover
+    `bounds` plus padding). Restores the target bitmap and blender. -/
+private def renderText (bmp : Bitmap) (font : Font) (text : String) (c : Color) (bounds : Rect) : IO Unit := do
+  let state ← createState
+  storeState state (StateFlags.targetBitmap ||| StateFlags.blender)
+  try
+    setTargetBitmap bmp
+    setBlender BlendOp.add BlendFactor.one BlendFactor.inverseAlpha
+    clearToColorRgba 0 0 0 0
+    let pm (v : UInt32) := v * c.a / 255
+    drawTextRgba font (pm c.r) (pm c.g) (pm c.b) c.a
+      (i32f (spritePad - bounds.x)) (i32f (spritePad - bounds.y)) TextAlign.left text
+  finally
+    restoreState state
+    destroyState state
+
+/-- Bitmap of at least `w × h` with an alpha channel. -/
+private def createSpriteBitmap (w h : UInt32) : IO Bitmap := do
+  let state ← createState
+  storeState state StateFlags.newBitmapParameters
+  setNewBitmapFormat .anyWithAlpha
+  let bmp ← createBitmap w h
+  restoreState state
+  destroyState state
+  return bmp
+
+/-- Render `text` with `bounds` into `bmp`, or into a new exact-size bitmap
+    if `bmp` is 0. -/
+private def makeSprite (font : Font) (text : String) (c : Color) (bounds : Rect) (bmp : Bitmap) : IO TextSprite := do
+  let w := bounds.w + 2 * spritePad.toUInt32
+  let h := bounds.h + 2 * spritePad.toUInt32
+  let bmp ← if bmp != 0 then pure bmp else createSpriteBitmap w h
+  if bmp == 0 then return {}
+  renderText bmp font text c bounds
+  return { bitmap := bmp, width := w, height := h,
+           originX := i32f (bounds.x - spritePad), originY := i32f (bounds.y - spritePad),
+           advance := (← getTextWidth font text).toFloat }
+
+namespace TextSprite
+
+/-- Render `text` in `font` and `colour` (alpha honoured) into a new bitmap
+    of exactly the text's size. Empty text gives a sprite with no bitmap.
+    The caller destroys it with `TextSprite.destroy`. -/
+def create (font : Font) (text : String) (colour : Color) : IO TextSprite := do
+  let bounds ← getTextBounds font text
+  if font == 0 || bounds.w == 0 || bounds.h == 0 then
+    return { advance := (← getTextWidth font text).toFloat }
+  makeSprite font text colour bounds 0
+
+/-- Draw the sprite where `drawTextRgb` would draw its text at `(x, y)`
+    with `align` — one `drawBitmapRegion`. -/
+def draw (s : TextSprite) (x y : Float) (align : TextAlign := TextAlign.left) : IO Unit := do
+  if s.bitmap == 0 then return
+  let (x, y) := align.penOrigin s.advance x y
+  drawBitmapRegion s.bitmap 0 0 s.width.toFloat s.height.toFloat
+    (x + s.originX) (y + s.originY) FlipFlags.none
+
+/-- Destroy a sprite made by `TextSprite.create` (not one owned by a
+    `TextSpriteCache`). -/
+def destroy (s : TextSprite) : IO Unit := do
+  if s.bitmap != 0 then destroyBitmap s.bitmap
+
+end TextSprite
+
+-- ── Cache ──
+
+/-- Counters reported by `TextSpriteCache.stats`. -/
+structure TextSpriteCacheStats where
+  /-- `get` calls answered from the cache. -/
+  hits      : Nat
+  /-- Sprites rendered (cache misses with visible text). -/
+  renders   : Nat
+  /-- Renders that reused a pooled bitmap instead of creating one. -/
+  reuses    : Nat
+  /-- Sprites returned to the pool by the `maxSprites` limit. -/
+  evictions : Nat
+  /-- Sprites currently cached. -/
+  sprites   : Nat
+  /-- Idle bitmaps in the pool. -/
+  pooled    : Nat
+  deriving Repr
+
+private structure SpriteKey where
+  font   : UInt64
+  colour : UInt32
+  text   : String
+  deriving BEq, Hashable
+
+private structure SpriteEntry where
+  sprite  : TextSprite
+  /-- Size class of `sprite.bitmap`. -/
+  cls     : UInt32 × UInt32
+  lastUse : Nat
+  deriving Inhabited
+
+private structure SpriteCacheState where
+  entries   : Std.HashMap SpriteKey SpriteEntry := {}
+  pool      : Std.HashMap (UInt32 × UInt32) (Array Bitmap) := {}
+  pooled    : Nat := 0
+  clock     : Nat := 0
+  hits      : Nat := 0
+  renders   : Nat := 0
+  reuses    : Nat := 0
+  evictions : Nat := 0
+
+/-- Text sprites keyed by (font, text, colour) over a size-class bitmap
+    pool; see the module docs. -/
+structure TextSpriteCache where
+  /-- Sprites kept before the least recently used are recycled. -/
+  maxSprites : Nat
+  /-- Idle bitmaps kept in the pool; extras are destroyed. -/
+  maxPooled  : Nat
+  state      : IO.Ref SpriteCacheState
+  /-- Id from `registerFontInvalidator`, released by `destroy`. -/
+  invalidator : Nat := 0
+
+namespace TextSpriteCache
+
+/-- Smallest power of two ≥ `n` (at least 16). -/
+private def sizeClass (n : UInt32) : UInt32 := Id.run do
+  let mut c : UInt32 := 16
+  while c < n && c < 0x80000000 do
+    c := c * 2
+  return c
+
+/-- Put bitmaps back into the pool, destroying those beyond `maxPooled`. -/
+private def recycle (c : TextSpriteCache) (bitmaps : Array ((UInt32 × UInt32) × Bitmap)) : IO Unit := do
+  let extra ← c.state.modifyGet fun s => Id.run do
+    let mut s := s
+    let mut extra : Array Bitmap := #[]
+    for (cls, b) in bitmaps do
+      if b == 0 then continue
+      if s.pooled < c.maxPooled then
+        s := { s with pool := s.pool.insert cls ((s.pool.getD cls #[]).push b), pooled := s.pooled + 1 }
+      else
+        extra := extra.push b
+    return (extra, s)
+  for b in extra do destroyBitmap b
+
+/-- Pooled bitmap of class `cls`, or a new one. Returns whether it was
+    reused. -/
+private def takeBitmap (c : TextSpriteCache) (cls : UInt32 × UInt32) : IO (Bitmap × Bool) := do
+  let pooled? ← c.state.modifyGet fun s =>
+    match (s.pool.getD cls #[]).back? with
+    | some b => (some b, { s with pool := s.pool.insert cls (s.pool.getD cls #[]).pop, pooled := s.pooled - 1 })
+    | none => (none, s)
+  match pooled? with
+  | some b => return (b, true)
+  | none => return (← createSpriteBitmap cls.1 cls.2, false)
+
+/-- Return the least recently used quarter of the sprites to the pool if
+    more than `maxSprites` are cached, sparing `keep` (the sprite `get` is
+    about to return). -/
+private def enforceLimit (c : TextSpriteCache) (keep : SpriteKey) : IO Unit := do
+  let victims ← c.state.modifyGet fun s =>
+    if s.entries.size ≤ c.maxSprites then (#[], s) else Id.run do
+      let byAge := (s.entries.toArray.filter (·.1 != keep)).qsort (fun a b => a.2.lastUse < b.2.lastUse)
+      let n := min byAge.size (s.entries.size - c.maxSprites * 3 / 4)
+      let drop := byAge.extract 0 n
+      let entries := drop.foldl (fun m (k, _) => m.erase k) s.entries
+      (drop.map fun (_, e) => (e.cls, e.sprite.bitmap),
+       { s with entries, evictions := s.evictions + drop.size })
+  recycle c victims
+
+/-- Sprite for `text` in `font` and `colour`, rendered on first use. The
+    cache owns the sprite: do not destroy it, and do not keep it past the
+    next `get` (which may evict it to stay within `maxSprites`) or
+    `invalidateFont` / `clear` / `destroy`; its bitmap then goes back to
+    the pool and may be redrawn with other text. -/
+def get (c : TextSpriteCache) (font : Font) (text : String) (colour : Color) : IO TextSprite := do
+  let key : SpriteKey := { font, colour := colour.pack, text }
+  let hit ← c.state.modifyGet fun s =>
+    match s.entries[key]? with
+    | some e =>
+      let clock := s.clock + 1
+      (some e.sprite, { s with clock, hits := s.hits + 1,
+                               entries := s.entries.insert key { e with lastUse := clock } })
+    | none => (none, s)
+  if let some sp := hit then return sp
+  let bounds ← getTextBounds font text
+  let cls := (sizeClass (bounds.w + 2 * spritePad.toUInt32), sizeClass (bounds.h + 2 * spritePad.toUInt32))
+  let mut sprite : TextSprite := {}
+  if font == 0 || bounds.w == 0 || bounds.h == 0 then
+    sprite := { advance := (← getTextWidth font text).toFloat }
+  else
+    let (bmp, reused) ← takeBitmap c cls
+    -- Not cached: a later call retries the allocation.
+    if bmp == 0 then return {}
+    sprite ← makeSprite font text colour bounds bmp
+    c.state.modify fun s => { s with renders := s.renders + 1, reuses := if reused then s.reuses + 1 else s.reuses }
+  c.state.modify fun s =>
+    let clock := s.clock + 1
+    { s with clock, entries := s.entries.insert key { sprite, cls, lastUse := clock } }
+  enforceLimit c key
+  return sprite
+
+/-- `get` and draw at `(x, y)` with `align`. -/
+def draw (c : TextSpriteCache) (font : Font) (text : String) (colour : Color) (x y : Float)
+    (align : TextAlign := TextAlign.left) : IO Unit := do
+  (← c.get font text colour).draw x y align
+
+/-- Return every sprite of `font` to the pool. Call before destroying the
+    font. -/
+def invalidateFont (c : TextSpriteCache) (font : Font) : IO Unit := do
+  let victims ← c.state.modifyGet fun s =>
+    let (drop, keep) := s.entries.fold (init := ((#[] : Array ((UInt32 × UInt32) × Bitmap)), ({} : Std.HashMap SpriteKey SpriteEntry)))
+      fun (d, m) k e => if k.font == font then (d.push (e.cls, e.sprite.bitmap), m) else (d, m.insert k e)
+    (drop, { s with entries := keep })
+  recycle c victims
+
+/-- Create an empty cache, registered with `releaseFont` until `destroy`. -/
+def create (maxSprites : Nat := 1024) (maxPooled : Nat := 64) : IO TextSpriteCache := do
+  let c : TextSpriteCache := { maxSprites, maxPooled, state := ← IO.mkRef {} }
+  return { c with invalidator := ← registerFontInvalidator c.invalidateFont }
+
+/-- Return every sprite to the pool. -/
+def clear (c : TextSpriteCache) : IO Unit := do
+  let victims ← c.state.modifyGet fun s =>
+    (s.entries.fold (init := (#[] : Array ((UInt32 × UInt32) × Bitmap))) fun d _ e => d.push (e.cls, e.sprite.bitmap), { s with entries := {} })
+  recycle c victims
+
+/-- Destroy every pooled bitmap. -/
+def trimPool (c : TextSpriteCache) : IO Unit := do
+  let pool ← c.state.modifyGet fun s => (s.pool, { s with pool := {}, pooled := 0 })
+  for (_, bs) in pool.toList do
+    for b in bs do destroyBitmap b
+
+/-- Destroy every sprite and pooled bitmap, and leave the `releaseFont`
+    registry. -/
+def destroy (c : TextSpriteCache) : IO Unit := do
+  unregisterFontInvalidator c.invalidator
+  let sprites ← c.state.modifyGet fun s =>
+    (s.entries.fold (init := (#[] : Array Bitmap)) fun d _ e => d.push e.sprite.bitmap, { s with entries := {} })
+  for b in sprites do
+    if b != 0 then destroyBitmap b
+  trimPool c
+
+/-- Current counters. -/
+def stats (c : TextSpriteCache) : IO TextSpriteCacheStats := do
+  let s ← c.state.get
+  return { hits := s.hits, renders := s.renders, reuses := s.reuses, evictions := s.evictions,
+           sprites := s.entries.size, pooled := s.pooled }
+
+end TextSpriteCache
+
+end Allegro
@@ -7,6 +7,9 @@ A simple `Vec2` type for ergonomic coordinate handling.
 Drawing functions still take separate `Float` parameters — use `v.x` / `v.y`
 to pass them — but game state can use `Vec2` instead of pairs of floats.
 
+For packed point lists in the layout the primitives addon reads, see
+`Vec2Array` (`Allegro.Addons.Primitives`).
+
 ## Example
 ```
 let pos := Vec2.mk 100.0 200.0
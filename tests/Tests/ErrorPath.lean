@@ -94,6 +94,19 @@ def testBitmapInvalidHandle : IO Bool := do
   -- drawBitmap null → no crash
   null.draw 0.0 0.0 FlipFlags.none
   check "drawBitmap 0 no crash" true
+  -- readRegion / writeRegion null → empty / 0
+  let rr ← null.readRegion 0 0 4 4 PixelFormat.abgr8888
+  check "readRegion 0 returns empty" (rr.size == 0)
+  let wr ← null.writeRegion 0 0 1 1 PixelFormat.abgr8888 (ByteArray.mk #[1, 2, 3, 4])
+  check "writeRegion 0 returns 0" (wr == 0)
+  let fr ← null.fillRegion 0 0 1 1 Color.white
+  check "fillRegion 0 returns 0" (fr == 0)
+  let br ← null.blitFrom 0 0 (ByteArray.mk #[1, 2, 3, 4]) PixelFormat.abgr8888 1 0 0 1 1
+  check "blitFrom 0 returns 0" (br == 0)
+  let af ← null.applyFilter (.boxBlur 1)
+  check "applyFilter 0 returns 0" (af == 0)
+  let rs ← null.resize 4 4
+  check "resize 0 returns 0" (rs == 0)
   pure true
 
 -- ── 3) Invalid-handle tests: Timer ──
@@ -136,6 +149,17 @@ def testEventsInvalidHandle : IO Bool := do
   -- isEventQueueEmpty on null → 0  (no crash)
   let emp ← nullQ.isEmpty
   check "isEventQueueEmpty 0 no crash" true
+  -- drainEventData on null queue → empty array (must not block)
+  let drained ← nullQ.drainData 16
+  check "drainEventData 0 returns empty" (drained.size == 0)
+  let drainedGame ← drainGameEvents nullQ 16
+  check "drainGameEvents 0 returns empty" (drainedGame.size == 0)
+  -- Filter configuration on null queue → no crash, zero stats
+  nullQ.setDropType EventType.timer 1
+  nullQ.setCoalesce EventCoalesce.mouseAxes
+  nullQ.clearFilter
+  let (fd, fm) ← nullQ.filterStats
+  check "getEventQueueFilterStats 0 returns (0, 0)" (fd == 0 && fm == 0)
   -- User event fields on null → 0
   let ud1 ← nullE.userData1
   check "eventGetUserData1 0 returns 0" (ud1 == 0)
@@ -163,6 +187,10 @@ def testFontInvalidHandle : IO Bool := do
   check "getFontAscent 0 returns 0" (asc == 0)
   let desc ← null.descent
   check "getFontDescent 0 returns 0" (desc == 0)
+  let tb ← null.textBounds "hello"
+  check "getTextBounds 0 returns empty Rect" (tb == {})
+  let gi ← null.glyphInfo 65
+  check "getGlyphInfo 0 returns zeros" (gi == default)
   -- drawTextRgb with null font → no crash
   let left := Allegro.TextAlign.left
   null.drawTextRgb 255 255 255 10.0 10.0 left "test"
@@ -554,6 +582,21 @@ def testEdgeCases : IO Bool := do
   check "path empty string no crash" true
   let _ := ps
   p.destroy
+  -- DrawList: malformed buffers stop early instead of reading past the end
+  let tgt : Bitmap ← Allegro.createBitmap 8 8
+  if tgt != 0 then
+    tgt.setAsTarget
+    let clear := DrawList.empty.clear (Color.rgb 1 2 3)
+    let truncated : DrawList := { bytes := clear.bytes.extract 0 3, count := 1 }
+    check "DrawList truncated record → 0 executed" ((← truncated.execute) == 0)
+    let unknown : DrawList := { bytes := clear.bytes ++ ByteArray.mk #[0xFF, 1, 2, 3], count := 2 }
+    check "DrawList unknown opcode stops after valid prefix" ((← unknown.execute) == 1)
+    let shortText := DrawList.empty.text Font.null (Color.rgb 0 0 0) 0 0 TextAlign.left "abcdef"
+    let cut : DrawList := { shortText with bytes := shortText.bytes.extract 0 (shortText.bytes.size - 2) }
+    check "DrawList text longer than buffer → 0 executed" ((← cut.execute) == 0)
+    let nulls := DrawList.empty.bitmap Bitmap.null 0 0 |>.text Font.null (Color.rgb 0 0 0) 0 0 TextAlign.left "x"
+    check "DrawList null handles skipped, still counted" ((← nulls.execute) == 2)
+    tgt.destroy
   pure true
 
 -- ── 13) Double-destroy safety ──
@@ -0,0 +1,136 @@
+import Allegro
+
+/-!
+# FFI overhead microbenchmark
+
+Measures ns/call through the `allegroshim` static library for the common
+shim shapes: scalar getter, `String` argument, `ByteArray` argument, tuple
+return, scalar-packed record return and `EventData` return. A Lean-only
+`@[noinline]` call is timed first as the floor; subtract it to get the cost
+of crossing into the shim (plus whatever the Allegro call itself does).
+
+Each row takes `samples` batches of `callsPerSample` calls and reports the
+median and 99th-percentile batch mean. A single call is too short for
+`IO.monoNanosNow` to resolve, so the percentiles describe batch-to-batch
+jitter, not individual calls.
+
+Runs headless: no display is created. The event comes from a user event
+source, the clipping rectangle from a memory bitmap target, and `fwrite`
+goes to the null device.
+
+Run: `lake build allegroFfiBench && .lake/build/bin/allegroFfiBench`
+-/
+
+open Allegro
+
+namespace FfiBench
+
+/-- Batches per row. -/
+def samples : Nat := 200
+
+/-- Calls per batch. -/
+def callsPerSample : Nat := 20_000
+
+/-- Per-row result in ns/call. -/
+structure Stats where
+  median : Float
+  p99    : Float
+
+/-- Value at fraction `p` (0–1) of an ascending array (nearest rank). -/
+def percentile (sorted : Array Float) (p : Float) : Float :=
+  if sorted.isEmpty then 0.0
+  else
+    let idx := ((sorted.size - 1).toFloat * p + 0.5).toUInt64.toNat
+    sorted[min idx (sorted.size - 1)]!
+
+/-- Time `samples` batches of `callsPerSample` calls of `act`.
+    `@[specialize]` copies `act` into the loop so only the call under test is
+    measured, not a closure dispatch. -/
+@[specialize] def measure (act : IO UInt32) : IO Stats := do
+  let mut perCall : Array Float := Array.mkEmpty samples
+  let mut acc : UInt32 := 0
+  for _ in [0:samples] do
+    let t0 ← IO.monoNanosNow
+    for _ in [0:callsPerSample] do
+      acc := acc + (← act)
+    let t1 ← IO.monoNanosNow
+    perCall := perCall.push ((t1 - t0).toFloat / callsPerSample.toFloat)
+  -- Keep the accumulated value observable so the loop cannot be dropped.
+  if acc == 0xDEADBEEF then IO.println ""
+  let sorted := perCall.qsort (· < ·)
+  return { median := percentile sorted 0.5, p99 := percentile sorted 0.99 }
+
+/-- Print one row; `floor` is the Lean-only median to subtract. -/
+def report (label : String) (s : Stats) (floor : Float) : IO Unit :=
+  IO.println s!"  {label}: median {s.median} ns, p99 {s.p99} ns, over floor {s.median - floor} ns"
+
+/-- Lean-to-Lean call with no FFI crossing. -/
+@[noinline] def leanNoop : IO UInt32 := pure 1
+
+end FfiBench
+
+open FfiBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+
+  IO.println "=== FFI overhead microbenchmark ==="
+  IO.println s!"  {samples} batches × {callsPerSample} calls per row"
+
+  let floorStats ← measure leanNoop
+  let floor := floorStats.median
+  report "Lean-only call (floor)" floorStats floor
+
+  -- Scalar getter: one TLS read in Allegro, UInt32 result.
+  report "scalar getter (getNewBitmapFlags)"
+    (← measure (do let f ← getNewBitmapFlags; pure f.val)) floor
+
+  -- String argument: lean_string_cstr + short copy in Allegro.
+  report "String arg (setAppName)"
+    (← measure (do setAppName "allegroFfiBench"; pure 1)) floor
+
+  -- ByteArray argument: 64 bytes through a buffered null-device write.
+  let payload := ByteArray.mk (Array.replicate 64 (0x5A : UInt8))
+  let nullDev := if System.Platform.isWindows then "NUL" else "/dev/null"
+  let sink ← fopen nullDev "wb"
+  if sink != 0 then
+    report "ByteArray arg (fwrite 64 B)" (← measure (fwrite sink payload)) floor
+    let _ ← fclose sink
+  else
+    IO.println s!"  ByteArray arg: skipped (cannot open {nullDev})"
+
+  -- Tuple return: (Float × Float) built from two boxed floats and a pair.
+  let tr ← createTransform
+  identityTransform tr
+  report "tuple return (transformCoordinates)"
+    (← measure (do let (x, _) ← transformCoordinates tr 1.0 2.0; pure x.toUInt32)) floor
+  destroyTransform tr
+
+  -- Record vs tuple return for the same query (clipping rectangle).
+  setNewBitmapFlags BitmapFlags.memory
+  let bmp ← createBitmap 64 64
+  if bmp != 0 then
+    setTargetBitmap bmp
+    setClippingRectangle 1 2 30 40
+    report "record return (getClippingRect)"
+      (← measure (do let r ← getClippingRect; pure r.w)) floor
+    report "tuple return (getClippingRectangle)"
+      (← measure (do let (_, _, w, _) ← getClippingRectangle; pure w)) floor
+    destroyBitmap bmp
+
+  -- EventData return: peek keeps the single queued event in place.
+  let q ← createEventQueue
+  let src ← initUserEventSource
+  registerEventSource q src
+  let _ ← emitUserEvent src 1 2 3 4
+  report "EventData return (peekNextEventData)"
+    (← measure (do let (ok, ed) ← peekNextEventData q; pure (ok + ed.type.val))) floor
+  unregisterEventSource q src
+  destroyUserEventSource src
+  destroyEventQueue q
+
+  uninstallSystem
+  return 0
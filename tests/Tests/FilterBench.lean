@@ -0,0 +1,127 @@
+import Allegro
+
+/-!
+# Image filter and resampling benchmark
+
+Runs each `Filter` over a 3840×2160 ABGR8888 memory bitmap with one row band
+(single-threaded) and with one band per CPU, and reports ms per frame,
+megapixels per second and the speed-up. For scale, a naive Lean loop that
+reads every pixel with `getPixelColor` and writes it back with `putPixel`
+is timed on a 256×256 crop and extrapolated to the full frame.
+
+`resizeBitmap` is timed for each kernel on a half-size and a thumbnail
+target, again single-band vs. one band per CPU, next to Allegro's
+`drawScaledBitmap` into a memory bitmap (point sampling, one thread).
+
+Runs headless on memory bitmaps. Each row is the median of `reps` runs.
+
+Run: `lake build allegroFilterBench && .lake/build/bin/allegroFilterBench`
+-/
+
+open Allegro
+
+namespace FilterBench
+
+def width : UInt32 := 3840
+def height : UInt32 := 2160
+
+/-- Runs per row. -/
+def reps : Nat := 7
+
+def pixels : Float := (width * height).toNat.toFloat
+
+/-- Median ms over `reps` runs of `act`; the source image is restored
+    before each run, outside the timed section. -/
+def medianMs (restore : IO Unit) (act : IO UInt32) : IO Float := do
+  let mut times : Array Float := Array.mkEmpty reps
+  for _ in [0:reps] do
+    restore
+    let t0 ← IO.monoNanosNow
+    let ok ← act
+    let t1 ← IO.monoNanosNow
+    if ok == 0 then IO.println "  (filter failed)"
+    times := times.push ((t1 - t0).toFloat / 1.0e6)
+  let sorted := times.qsort (· < ·)
+  return sorted[sorted.size / 2]!
+
+def mps (ms : Float) : Float :=
+  if ms > 0.0 then pixels / (ms / 1000.0) / 1.0e6 else 0.0
+
+end FilterBench
+
+open FilterBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+
+  let cpus ← getCpuCount
+  IO.println "=== Image filter benchmark ==="
+  IO.println s!"  {width}×{height} ABGR8888, median of {reps} runs, {cpus} CPUs"
+
+  setNewBitmapFlags BitmapFlags.memory
+  setNewBitmapFormat .abgr8888
+  let bmp ← createBitmap width height
+  if bmp == 0 then
+    IO.eprintln "FATAL: cannot create memory bitmap"
+    return 1
+
+  -- Procedural opaque source frame.
+  let mut src := ByteArray.emptyWithCapacity (width * height * 4).toNat
+  for i in [0:(width * height).toNat] do
+    src := Pack.u32 src (i.toUInt32 * 2654435761 ||| 0xFF000000)
+  let restore : IO Unit := do let _ ← writeRegion bmp 0 0 width height .abgr8888 src
+
+  let filters : Array (String × Filter) := #[
+    ("boxBlur 4", .boxBlur 4),
+    ("boxBlur 32", .boxBlur 32),
+    ("gaussianBlur 2.0", .gaussianBlur 2.0),
+    ("gaussianBlur 8.0", .gaussianBlur 8.0),
+    ("sharpen", Filter.sharpen),
+    ("grayscale", Filter.grayscale),
+    ("premultiplyAlpha", .premultiplyAlpha)]
+  for (name, f) in filters do
+    let one ← medianMs restore (applyFilter bmp f 1)
+    let all ← medianMs restore (applyFilter bmp f)
+    let speedup := if all > 0.0 then one / all else 0.0
+    IO.println s!"  {name}: 1 band {one} ms ({mps one} Mpx/s), {cpus} bands {all} ms ({mps all} Mpx/s), ×{speedup}"
+
+  -- Baseline: per-pixel Lean loop on a crop, scaled to the full frame.
+  let crop : Nat := 256
+  setTargetBitmap bmp
+  let naive ← medianMs restore do
+    for y in [0:crop] do
+      for x in [0:crop] do
+        let c ← getPixelColor bmp (Int32.ofNat x) (Int32.ofNat y)
+        putPixel (Int32.ofNat x) (Int32.ofNat y) (255 - c.r) (255 - c.g) (255 - c.b)
+    pure 1
+  let scaled := naive * pixels / (crop * crop).toFloat
+  IO.println s!"  getPixelColor/putPixel loop: {scaled} ms per frame (extrapolated from {crop}×{crop}, {mps scaled} Mpx/s)"
+
+  IO.println "-- resizeBitmap (Mpx/s counts source pixels)"
+  let targets : Array (UInt32 × UInt32) := #[(width / 2, height / 2), (256, 144)]
+  for (tw, th) in targets do
+    for (name, k) in #[("box", ResampleFilter.box), ("bilinear", .bilinear), ("lanczos3", .lanczos3)] do
+      let timeResize (bands : Nat) : IO Float := medianMs (pure ()) do
+        let d ← resizeBitmap bmp tw th k (bands := bands)
+        if d != 0 then destroyBitmap d
+        pure (if d != 0 then 1 else 0)
+      let one ← timeResize 1
+      let all ← timeResize 0
+      let speedup := if all > 0.0 then one / all else 0.0
+      IO.println s!"  {name} → {tw}×{th}: 1 band {one} ms ({mps one} Mpx/s), {cpus} bands {all} ms ({mps all} Mpx/s), ×{speedup}"
+    let dst ← createBitmap tw th
+    if dst != 0 then
+      setTargetBitmap dst
+      let ms ← medianMs (pure ()) do
+        drawScaledBitmap bmp 0 0 width.toFloat height.toFloat 0 0 tw.toFloat th.toFloat FlipFlags.none
+        pure 1
+      IO.println s!"  drawScaledBitmap → {tw}×{th}: {ms} ms ({mps ms} Mpx/s)"
+      setTargetBitmap bmp
+      destroyBitmap dst
+
+  destroyBitmap bmp
+  uninstallSystem
+  return 0
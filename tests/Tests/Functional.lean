@@ -398,6 +398,14 @@ def testColor : IO Bool := do
   let (hr, hg, hb) ← Allegro.colorHtmlToRgb "#00ff00"
   check "colorHtmlToRgb '#00ff00' → green" (hr == 0 && hg == 255 && hb == 0)
 
+  -- ── Pure conversions ──
+  check "Color.hsvToRgb pure → red" (Color.hsvToRgb 0 1.0 1.0 == (255, 0, 0))
+  let (ph, _, pl) := Color.rgbToHsl 0 0 255
+  check "Color.rgbToHsl pure (blue) → h≈240" (ph > 239.0 && ph < 241.0 && pl > 0.49 && pl < 0.51)
+  check "Color.ofName pure 'red'" (Color.ofName "red" == Color.rgb 255 0 0)
+  check "Color.rgbToHtml pure" (Color.rgbToHtml 255 0 0 == "#ff0000")
+  check "Color.distanceCiede2000 same colour = 0" (Color.distanceCiede2000 10 20 30 10 20 30 < 0.0001)
+
   -- OkLab tuple round-trip
   let (ol, oa, ob) ← Allegro.colorRgbToOklab 255 0 0
   check "colorRgbToOklab(red) → L>0" (ol > 0.5)
@@ -436,6 +444,8 @@ def testFont : IO Bool := do
   let ar := Allegro.TextAlign.right
   let ai := Allegro.TextAlign.integer
   check "align constants" (al.val == 0 && ac.val == 1 && ar.val == 2 && ai.val == 4)
+  check "penOrigin centre halves in whole pixels" (ac.penOrigin 41 10.5 3.5 == (-9.5, 3.5))
+  check "penOrigin right + integer floors" ((ar ||| ai).penOrigin 40 10.5 3.5 == (-30.0, 3.0))
 
   builtin.destroy
 
@@ -731,6 +741,64 @@ def testEventData : IO Bool := do
     check "user EventData type ≥ 512" (ued.type.val ≥ 512)
     check "user EventData.u64v = data1 = 99" (ued.u64v == 99)
 
+  -- drainEventData: one call returns every queued event in order
+  let _ ← src.emit 1 0 0 0
+  let _ ← src.emit 2 0 0 0
+  let _ ← src.emit 3 0 0 0
+  let batch ← q2.drainData 8
+  check "drainEventData returns 3 events" (batch.size == 3)
+  check "drainEventData preserves queue order"
+    (batch.map (·.u64v) == #[1, 2, 3])
+  let emptyAfter ← q2.isEmpty
+  check "queue empty after drain" (emptyAfter == 1)
+  -- max caps the batch; the remainder stays queued
+  let _ ← src.emit 4 0 0 0
+  let _ ← src.emit 5 0 0 0
+  let capped ← q2.drainData 1
+  check "drainEventData respects max" (capped.size == 1 && capped[0]!.u64v == 4)
+  let (gotRest, rest) ← q2.getNextData
+  check "event beyond max still queued" (gotRest == 1 && rest.u64v == 5)
+
+  -- Native filtering: timer events dropped in C, user events pass through
+  let ft : Allegro.Timer ← Allegro.createTimer (1.0 / 200.0)
+  if ft != 0 then
+    let ftsrc ← ft.eventSource
+    q2.registerSource ftsrc
+    q2.setDropType Allegro.EventType.timer 1
+    q2.setCoalesce (Allegro.EventCoalesce.mouseAxes ||| Allegro.EventCoalesce.touchMove)
+    ft.start
+    Allegro.rest 0.05
+    ft.stop
+    let _ ← src.emit 7 0 0 0
+    let filtered ← q2.drainData 64
+    check "filtered drain contains only the user event"
+      (filtered.size == 1 && filtered[0]!.u64v == 7)
+    let (dropped, merged) ← q2.filterStats
+    check "filter stats count dropped timer events" (dropped > 0)
+    check "no merges without mouse/touch input" (merged == 0)
+    q2.clearFilter
+    let (droppedAfter, _) ← q2.filterStats
+    check "clearEventQueueFilter resets stats" (droppedAfter == 0)
+    q2.unregisterSource ftsrc
+    ft.destroy
+
+  -- drainGameEvents: GameEvent constructors built directly in C
+  let gt : Allegro.Timer ← Allegro.createTimer (1.0 / 200.0)
+  if gt != 0 then
+    let gtsrc ← gt.eventSource
+    q2.registerSource gtsrc
+    gt.start
+    Allegro.rest 0.02
+    gt.stop
+    let _ ← src.emit 11 0 0 0
+    let games ← Allegro.drainGameEvents q2 64
+    let ticks := games.filter fun | .tick => true | _ => false
+    check "drainGameEvents decodes timer → tick" (ticks.size > 0)
+    let others := games.filter fun | .other ty => ty.val ≥ 512 | _ => false
+    check "drainGameEvents decodes user event → other" (others.size == 1)
+    q2.unregisterSource gtsrc
+    gt.destroy
+
   q2.unregisterSource src
   src.destroy
   q2.destroy
@@ -987,11 +1055,661 @@ def testBitmapExtras : IO Bool := do
     if lr2 != 0 then
       bmp.unlock
 
+    -- ── Bulk region transfer: writeRegion / readRegion ──
+    -- 4×2 RGBA pixels, ABGR_8888 = bytes R, G, B, A in memory.
+    let mut px := ByteArray.emptyWithCapacity 32
+    for i in [0:8] do
+      px := px.push (i * 30).toUInt8 |>.push 200 |>.push (255 - i * 20).toUInt8 |>.push 255
+    let wrote ← bmp.writeRegion 3 5 4 2 Allegro.PixelFormat.abgr8888 px
+    check "writeRegion succeeds" (wrote == 1)
+    let back ← bmp.readRegion 3 5 4 2 Allegro.PixelFormat.abgr8888
+    check "readRegion size = w*h*4" (back.size == 32)
+    check "readRegion round-trips writeRegion" (back.data == px.data)
+    let (r6, g6, b6, _) ← bmp.getPixelRgba 5 6  -- pixel 6 = row 1, col 2
+    check "writeRegion pixel matches getPixel" (r6 == 180 && g6 == 200 && b6 == 135)
+    let oob ← bmp.readRegion 30 30 4 4 Allegro.PixelFormat.abgr8888
+    check "readRegion out of bounds → empty" (oob.size == 0)
+    let short ← bmp.writeRegion 0 0 4 4 Allegro.PixelFormat.abgr8888 px
+    check "writeRegion short buffer → 0" (short == 0)
+
     bmp.destroy
 
   Allegro.setNewBitmapFlags Allegro.BitmapFlags.none
   pure true
 
+-- ── Pixel conversion kernels ──
+
+/-- Colour `c` after a round trip through format `fmt` (565 drops low bits
+    and widens as `v * 255 / 31`; other kernel formats are lossless). -/
+def throughFormat (fmt : Allegro.PixelFormat) (c : Allegro.Color) : Allegro.Color :=
+  if fmt == Allegro.PixelFormat.rgb565 then
+    { r := (c.r >>> 3) * 255 / 31, g := (c.g >>> 2) * 255 / 63, b := (c.b >>> 3) * 255 / 31, a := 255 }
+  else c
+
+/-- Channels within `tol` of each other (float formats unmap by truncation). -/
+def nearColor (x y : Allegro.Color) (tol : UInt32) : Bool :=
+  let near (a b : UInt32) := (if a ≥ b then a - b else b - a) ≤ tol
+  near x.r y.r && near x.g y.g && near x.b y.b && near x.a y.a
+
+def testPixelKernels : IO Bool := do
+  printSection "Pixel conversion kernels"
+  let w : UInt32 := 13  -- odd width exercises the SIMD tails
+  let h : UInt32 := 3
+  let colorAt (i : Nat) : Allegro.Color :=
+    { r := (i * 37 % 256).toUInt32, g := (i * 91 % 256).toUInt32, b := (255 - i * 19 % 256).toUInt32, a := (i * 53 % 256).toUInt32 }
+  let mut src := ByteArray.emptyWithCapacity (w * h * 4).toNat
+  for i in [0:(w * h).toNat] do
+    src := Allegro.Pack.u32 src (colorAt i).pack
+
+  -- Pure conversions: 8888 swizzles round-trip exactly.
+  let argb := Allegro.convertPixels src .abgr8888 .argb8888 w h
+  let rgba := Allegro.convertPixels argb .argb8888 .rgba8888 w h
+  let back := Allegro.convertPixels rgba .rgba8888 .abgr8888 w h
+  check "convertPixels argb/rgba round trip" (back.data == src.data)
+  let f32 := Allegro.convertPixels src .abgr8888 .abgrF32 w h
+  check "convertPixels → abgrF32 size" (f32.size == (w * h * 16).toNat)
+  check "convertPixels abgrF32 round trip" ((Allegro.convertPixels f32 .abgrF32 .abgr8888 w h).data == src.data)
+  check "convertPixels 8-bit → float is v / 255"
+    (Allegro.Pack.readF32 f32 0 == (Float32.ofNat (colorAt 0).r.toNat / 255.0).toFloat)
+  check "convertPixels short source → empty" ((Allegro.convertPixels src .abgr8888 .rgb565 w (h + 1)).size == 0)
+  check "convertPixels unsupported format → empty" ((Allegro.convertPixels src .abgr8888 .rgb888 w h).size == 0)
+  check "hasKernel" (Allegro.PixelFormat.rgb565.hasKernel && !Allegro.PixelFormat.rgb888.hasKernel)
+
+  -- fillPixels / blitPixels on ByteArrays
+  let red : Allegro.Color := { r := 255, g := 0, b := 0, a := 255 }
+  let canvas := Allegro.fillPixels (ByteArray.mk (Array.replicate (8 * 8 * 2) 0)) .rgb565 8 2 3 4 2 red
+  check "fillPixels inside rectangle" (Allegro.Pack.readU32 canvas ((3 * 8 + 2) * 2) == 0xF800F800)
+  check "fillPixels leaves outside untouched" (Allegro.Pack.readU32 canvas 0 == 0)
+  let blitted := Allegro.blitPixels (ByteArray.mk (Array.replicate (16 * 4 * 4) 0)) .argb8888 16 3 1 src .abgr8888 w 0 0 w h
+  check "blitPixels converts into place"
+    (Allegro.Pack.readU32 blitted ((1 * 16 + 3) * 4) == Allegro.Pack.readU32 argb 0)
+  let clipped := Allegro.blitPixels blitted .argb8888 16 10 0 src .abgr8888 w 0 0 w h
+  check "blitPixels out of range → unchanged" (clipped.data == blitted.data)
+
+  -- Against al_get_pixel: write canonical pixels into a bitmap of each
+  -- kernel format, read them with getPixelColor and readRegion.
+  let formats := #[Allegro.PixelFormat.argb8888, .rgba8888, .abgr8888, .rgb565, .abgrF32]
+  let oldFlags ← Allegro.getNewBitmapFlags
+  let oldFormat ← Allegro.getNewBitmapFormat
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  for fmt in formats do
+    Allegro.setNewBitmapFormat fmt
+    let bmp : Bitmap ← Allegro.createBitmap w h
+    if bmp == 0 then
+      check s!"memory bitmap in format {fmt.val} unavailable (OK)" true
+      continue
+    let tol : UInt32 := if fmt == Allegro.PixelFormat.abgrF32 then 1 else 0
+    check s!"[{fmt.val}] writeRegion" ((← bmp.writeRegion 0 0 w h .abgr8888 src) == 1)
+    let mut okGet := true
+    for i in [0:(w * h).toNat] do
+      let got ← bmp.getPixelColor (Int32.ofNat (i % w.toNat)) (Int32.ofNat (i / w.toNat))
+      okGet := okGet && nearColor got (throughFormat fmt (colorAt i)) tol
+    check s!"[{fmt.val}] kernel output matches al_get_pixel" okGet
+    let rb ← bmp.readRegion 0 0 w h .abgr8888
+    let mut okRead := rb.size == (w * h * 4).toNat
+    for i in [0:(w * h).toNat] do
+      let px := Allegro.Pack.readU32 rb (i * 4)
+      let c : Allegro.Color := { r := px &&& 0xFF, g := (px >>> 8) &&& 0xFF, b := (px >>> 16) &&& 0xFF, a := px >>> 24 }
+      okRead := okRead && nearColor c (throughFormat fmt (colorAt i)) tol
+    check s!"[{fmt.val}] readRegion matches al_get_pixel" okRead
+    check s!"[{fmt.val}] fillRegion" ((← bmp.fillRegion 1 1 4 2 red) == 1)
+    check s!"[{fmt.val}] fillRegion pixel" ((← bmp.getPixelColor 4 2) == red)
+    check s!"[{fmt.val}] blitFrom" ((← bmp.blitFrom 0 0 src .abgr8888 w 2 0 3 1) == 1)
+    check s!"[{fmt.val}] blitFrom pixel" (nearColor (← bmp.getPixelColor 0 0) (throughFormat fmt (colorAt 2)) tol)
+    check s!"[{fmt.val}] blitFrom out of range → 0" ((← bmp.blitFrom 0 0 src .abgr8888 w 0 0 w (h + 1)) == 0)
+    bmp.destroy
+  Allegro.setNewBitmapFormat oldFormat
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testFilters : IO Bool := do
+  printSection "Image filters"
+  let w : UInt32 := 16
+  let h : UInt32 := 16
+  let oldFlags ← Allegro.getNewBitmapFlags
+  let oldFormat ← Allegro.getNewBitmapFormat
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  Allegro.setNewBitmapFormat .abgr8888
+  let bmp : Bitmap ← Allegro.createBitmap w h
+  if bmp == 0 then
+    check "memory bitmap unavailable (OK)" true
+    Allegro.setNewBitmapFormat oldFormat
+    Allegro.setNewBitmapFlags oldFlags
+    return true
+  let teal : Allegro.Color := { r := 20, g := 140, b := 160, a := 255 }
+
+  -- Constant image: blurs leave it unchanged.
+  let _ ← bmp.fillRegion 0 0 w h teal
+  check "boxBlur returns 1" ((← bmp.applyFilter (.boxBlur 3)) == 1)
+  check "boxBlur constant image" ((← bmp.readRegion 0 0 w h .abgr8888).data == (Allegro.fillPixels (ByteArray.mk (Array.replicate (w * h * 4).toNat 0)) .abgr8888 w 0 0 w h teal).data)
+  let _ ← bmp.applyFilter (.gaussianBlur 2.0)
+  check "gaussianBlur constant image" ((← bmp.getPixelColor 0 0) == teal && (← bmp.getPixelColor 15 15) == teal)
+
+  -- Per-pixel filters
+  let _ ← bmp.fillRegion 0 0 w h { r := 200, g := 100, b := 50, a := 128 }
+  let _ ← bmp.applyFilter .premultiplyAlpha
+  check "premultiplyAlpha" ((← bmp.getPixelColor 3 3) == { r := 100, g := 50, b := 25, a := 128 })
+  let _ ← bmp.applyFilter .unpremultiplyAlpha
+  check "unpremultiplyAlpha" (nearColor (← bmp.getPixelColor 3 3) { r := 200, g := 100, b := 50, a := 128 } 1)
+  let _ ← bmp.fillRegion 0 0 w h { r := 255, g := 0, b := 0, a := 200 }
+  let _ ← bmp.applyFilter .grayscale
+  check "grayscale (Rec. 709 luma)" (nearColor (← bmp.getPixelColor 5 5) { r := 54, g := 54, b := 54, a := 200 } 1)
+
+  -- Noise image: identity convolution, and band count does not change results.
+  let mut noise := ByteArray.emptyWithCapacity (w * h * 4).toNat
+  for i in [0:(w * h).toNat] do
+    noise := Allegro.Pack.u32 noise (i.toUInt32 * 2654435761 ||| 0xFF000000)
+  let _ ← bmp.writeRegion 0 0 w h .abgr8888 noise
+  let _ ← bmp.applyFilter (.convolve3x3 #[0, 0, 0, 0, 1, 0, 0, 0, 0] 0)
+  check "convolve3x3 identity" ((← bmp.readRegion 0 0 w h .abgr8888).data == noise.data)
+  for f in #[Allegro.Filter.boxBlur 2, .gaussianBlur 1.5, .sharpen] do
+    let _ ← bmp.writeRegion 0 0 w h .abgr8888 noise
+    let _ ← bmp.applyFilter f 1
+    let one ← bmp.readRegion 0 0 w h .abgr8888
+    let _ ← bmp.writeRegion 0 0 w h .abgr8888 noise
+    let _ ← bmp.applyFilter f 5
+    check "1 band and 5 bands agree" ((← bmp.readRegion 0 0 w h .abgr8888).data == one.data)
+
+  -- Single white pixel: gaussian spreads symmetrically.
+  let _ ← bmp.fillRegion 0 0 w h { r := 0, g := 0, b := 0, a := 255 }
+  let _ ← bmp.fillRegion 8 8 1 1 Color.white
+  let _ ← bmp.applyFilter (.gaussianBlur 1.0)
+  let c ← bmp.getPixelColor 8 8
+  let l ← bmp.getPixelColor 7 8
+  let r ← bmp.getPixelColor 9 8
+  let u ← bmp.getPixelColor 8 7
+  check "gaussianBlur spreads" (c.r > l.r && l.r > 0 && l == r && l == u)
+
+  -- Rejected bitmaps
+  let lr ← Allegro.lockBitmap bmp .abgr8888 Allegro.LockMode.readwrite
+  if lr != 0 then
+    check "applyFilter on locked bitmap → 0" ((← bmp.applyFilter .grayscale) == 0)
+    Allegro.unlockBitmap bmp
+  bmp.destroy
+  Allegro.setNewBitmapFormat oldFormat
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testResize : IO Bool := do
+  printSection "Image resampling"
+  let oldFlags ← Allegro.getNewBitmapFlags
+  let oldFormat ← Allegro.getNewBitmapFormat
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  Allegro.setNewBitmapFormat .argb8888
+  let src : Bitmap ← Allegro.createBitmap 16 16
+  if src == 0 then
+    check "memory bitmap unavailable (OK)" true
+    Allegro.setNewBitmapFormat oldFormat
+    Allegro.setNewBitmapFlags oldFlags
+    return true
+  -- Constant image stays constant at any size, with every kernel.
+  let teal : Allegro.Color := { r := 20, g := 140, b := 160, a := 255 }
+  let _ ← src.fillRegion 0 0 16 16 teal
+  for k in #[Allegro.ResampleFilter.box, .bilinear, .lanczos3] do
+    for (w, h) in #[((4 : UInt32), (4 : UInt32)), (7, 5), (40, 24)] do
+      let dst ← src.resize w h k
+      check s!"{repr k} {w}×{h} created" (dst != 0)
+      if dst != 0 then
+        check s!"{repr k} {w}×{h} size" ((← dst.width) == w && (← dst.height) == h)
+        check s!"{repr k} {w}×{h} constant" ((← dst.getPixelColor 0 0) == teal && (← dst.getPixelColor (Int32.ofNat (w.toNat - 1)) (Int32.ofNat (h.toNat - 1))) == teal)
+        dst.destroy
+  let dst ← src.resize 8 8
+  check "resize keeps 8888 source format" ((← Allegro.getBitmapFormat dst) == Allegro.PixelFormat.argb8888)
+  check "resize result is a memory bitmap" (((← dst.flags) &&& Allegro.BitmapFlags.memory) == Allegro.BitmapFlags.memory)
+  dst.destroy
+
+  -- Alternating black / white columns halved: 50% grey in linear light.
+  let mut stripes := ByteArray.emptyWithCapacity (16 * 16 * 4)
+  for i in [0:16 * 16] do
+    stripes := Allegro.Pack.u32 stripes (if i % 2 == 1 then 0xFFFFFFFF else 0xFF000000)
+  let _ ← src.writeRegion 0 0 16 16 .abgr8888 stripes
+  let lin ← src.resize 8 8 .box
+  check "gamma-correct box average (sRGB 188)" ((← lin.getPixelColor 3 3).r == 188)
+  lin.destroy
+  let raw ← src.resize 8 8 .box (gammaCorrect := false)
+  check "plain box average (128)" ((← raw.getPixelColor 3 3).r == 128)
+  raw.destroy
+
+  -- Transparent red next to opaque blue: no red fringe (premultiplied).
+  let mut fringe := ByteArray.emptyWithCapacity (16 * 16 * 4)
+  for i in [0:16 * 16] do
+    fringe := Allegro.Pack.u32 fringe (if i % 2 == 1 then 0xFFFF0000 else 0x000000FF)
+  let _ ← src.writeRegion 0 0 16 16 .abgr8888 fringe
+  let half ← src.resize 8 8 .box
+  check "premultiplied filtering" ((← half.getPixelColor 2 2) == { r := 0, g := 0, b := 255, a := 128 })
+  half.destroy
+
+  -- Band count does not change results.
+  let mut noise := ByteArray.emptyWithCapacity (16 * 16 * 4)
+  for i in [0:16 * 16] do
+    noise := Allegro.Pack.u32 noise (i.toUInt32 * 2654435761)
+  let _ ← src.writeRegion 0 0 16 16 .abgr8888 noise
+  for (w, h) in #[((5 : UInt32), (3 : UInt32)), (37, 29)] do
+    let one ← src.resize w h .lanczos3 (bands := 1)
+    let many ← src.resize w h .lanczos3 (bands := 6)
+    check s!"lanczos3 {w}×{h}: 1 band and 6 bands agree"
+      ((← one.readRegion 0 0 w h .abgr8888).data == (← many.readRegion 0 0 w h .abgr8888).data)
+    one.destroy
+    many.destroy
+
+  let lr ← Allegro.lockBitmap src .argb8888 Allegro.LockMode.readonly
+  if lr != 0 then
+    check "resize of locked bitmap → 0" ((← src.resize 4 4) == 0)
+    Allegro.unlockBitmap src
+  check "resize to 0×0 → 0" ((← src.resize 0 0) == 0)
+  src.destroy
+  Allegro.setNewBitmapFormat oldFormat
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testAtlas : IO Bool := do
+  printSection "Texture atlas"
+  -- Pure packer: rectangles stay on the page and never overlap (with
+  -- their extrusion and padding).
+  let cfg : Allegro.AtlasConfig := { pageWidth := 128, pageHeight := 128, padding := 2, extrude := 1 }
+  let sizes := (Array.range 60).map fun i => ((i * 7 % 23 + 3).toUInt32, (i * 11 % 19 + 2).toUInt32)
+  let layout := Allegro.packAtlas cfg (sizes.push (200, 4))
+  check "oversized sprite unpacked" (layout.slots.back!.isNone)
+  let placed := layout.slots.filterMap id
+  check "all others packed" (placed.size == sizes.size)
+  check "sizes preserved" ((Array.range sizes.size).all fun i =>
+    match layout.slots[i]! with
+    | some s => (s.w, s.h) == sizes[i]!
+    | none => false)
+  let mut inside := true
+  let mut disjoint := true
+  for a in placed do
+    inside := inside && a.x ≥ 1 && a.y ≥ 1 && a.x + a.w + 1 ≤ 128 && a.y + a.h + 1 ≤ 128 && a.page < layout.pageCount
+    for b in placed do
+      if a != b && a.page == b.page then
+        -- Extruded boxes plus padding must not touch.
+        let sep := a.x + a.w + 1 + 2 ≤ b.x - 1 || b.x + b.w + 1 + 2 ≤ a.x - 1 ||
+                   a.y + a.h + 1 + 2 ≤ b.y - 1 || b.y + b.h + 1 + 2 ≤ a.y - 1
+        disjoint := disjoint && sep
+  check "slots inside pages" inside
+  check "slots disjoint with padding" disjoint
+  check "several pages used" (layout.pageCount > 1)
+  let r := layout.report cfg
+  check "report counts" (r.pageCount == layout.pageCount && r.unpacked == 1 && r.occupancy.size == r.pageCount)
+  check "occupancy in (0, 1]" (r.occupancy.all fun o => o > 0.0 && o ≤ 1.0)
+  check "fewer texture switches" (r.switchesBefore == sizes.size + 1 && r.switchesAfter < r.switchesBefore)
+  check "textureSwitches on repeated input" (layout.textureSwitches #[0, 0, 1] == (2, if (layout.slots[0]!.map (·.page)) == (layout.slots[1]!.map (·.page)) then 1 else 2))
+
+  -- Building pages from memory bitmaps (software drawing, no display).
+  let oldFlags ← Allegro.getNewBitmapFlags
+  let oldFormat ← Allegro.getNewBitmapFormat
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  Allegro.setNewBitmapFormat .abgr8888
+  let red : Allegro.Color := { r := 255, g := 0, b := 0, a := 255 }
+  let blue : Allegro.Color := { r := 0, g := 0, b := 255, a := 255 }
+  let plain : Bitmap ← Allegro.createBitmap 6 4
+  let sheet : Bitmap ← Allegro.createBitmap 16 16
+  if plain == 0 || sheet == 0 then
+    check "memory bitmaps unavailable (OK)" true
+  else
+    let _ ← plain.fillRegion 0 0 6 4 red
+    let _ ← plain.fillRegion 5 0 1 4 blue      -- right edge column
+    let _ ← sheet.fillRegion 0 0 16 16 blue
+    let cut : Bitmap ← Allegro.createSubBitmap sheet 4 4 5 5
+    let atlas ← Allegro.buildAtlas #[plain, cut] { pageWidth := 64, pageHeight := 64 }
+    check "one page" (atlas.pages.size == 1 && atlas.pages[0]! != 0)
+    let page := atlas.pages[0]!
+    let s0 := atlas.sprites[0]!
+    check "plain bitmap gets a new sub-bitmap" (s0 != 0 && s0 != plain && atlas.owned[0]!)
+    check "sub-bitmap size" ((← s0.width) == 6 && (← s0.height) == 4)
+    check "sub-bitmap pixels copied" ((← s0.getPixelColor 0 0) == red && (← s0.getPixelColor 5 3) == blue)
+    check "sub-bitmap input reparented" (atlas.sprites[1]! == cut && !atlas.owned[1]! && (← Allegro.getParentBitmap cut) == page)
+    check "reparented pixels" ((← cut.getPixelColor 2 2) == blue)
+    match atlas.layout.slots[0]! with
+    | some s =>
+      let x := Int32.ofNat s.x.toNat
+      let y := Int32.ofNat s.y.toNat
+      check "extruded left edge" ((← page.getPixelColor (x - 1) y) == red)
+      check "extruded right edge" ((← page.getPixelColor (x + 6) (y + 3)) == blue)
+      check "extruded corner" ((← page.getPixelColor (x + 6) (y + 4)) == blue)
+    | none => check "plain bitmap packed" false
+    check "target restored" ((← Allegro.getTargetBitmap) != page)
+    cut.destroy
+    atlas.destroy
+  if plain != 0 then plain.destroy
+  if sheet != 0 then sheet.destroy
+  Allegro.setNewBitmapFormat oldFormat
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testAssetLoader (hasAudio : Bool) : IO Bool := do
+  printSection "Asset loader"
+  let loader ← Allegro.AssetLoader.create (maxWorkers := 2)
+  check "user event source created" (loader.source != 0)
+  let q : EventQueue ← Allegro.createEventQueue
+  Allegro.registerEventSource q loader.source
+
+  let png ← loader.load "data/sample.png"
+  let ttf ← loader.load "data/DejaVuSans.ttf" (.ttfFont 16) (priority := 5)
+  let missing ← loader.load "data/does_not_exist.png"
+  let wav ← if hasAudio then loader.load "data/beep.wav" .sample else pure 0
+  check "ids are distinct and non-zero" (png != 0 && ttf != png && missing != ttf && missing != png)
+
+  -- One completion event per request, carrying its id.
+  let expected := if hasAudio then 4 else 3
+  let mut seen : Array UInt64 := #[]
+  let mut missingStatus : Option Allegro.AssetStatus := none
+  for _ in [0:expected] do
+    let (got, ev) ← Allegro.waitForEventTimedData q 10.0
+    if got != 0 then
+      if let some id := loader.completedId? ev then
+        seen := seen.push id
+        if id == missing then missingStatus ← loader.completedStatus? ev
+  check "completion events received" (seen.size == expected && seen.contains png && seen.contains ttf && seen.contains missing)
+  check "completedStatus? reports the failure" (missingStatus == some .failed)
+  check "AssetStatus.ofCode? inverts code" (Allegro.AssetStatus.ofCode? Allegro.AssetStatus.failed.code == some .failed)
+  let p ← loader.progress
+  check "progress complete" (p.finished == expected && p.total == expected && p.queued == 0 && p.loading == 0 && p.fraction == 1.0)
+  check "status ready" ((← loader.status png) == some .ready)
+  check "status failed" ((← loader.status missing) == some .failed)
+
+  match ← loader.take png with
+  | some h =>
+    let bmp : Bitmap := h
+    check "bitmap loaded" (h != 0)
+    if h != 0 then
+      check "bitmap has pixels" ((← bmp.width) > 0 && (← bmp.height) > 0)
+      bmp.destroy
+  | none => check "bitmap take" false
+  check "take forgets the id" ((← loader.take png).isNone && (← loader.status png).isNone)
+  match ← loader.take ttf with
+  | some h =>
+    let font : Font := h
+    check "ttf font loaded" (h != 0)
+    if h != 0 then font.destroy
+  | none => check "ttf take" false
+  check "failed load takes as 0" ((← loader.take missing) == some 0)
+  if hasAudio then
+    match ← loader.take wav with
+    | some h =>
+      check "sample loaded" (h != 0)
+      if h != 0 then Allegro.destroySample h
+    | none => check "sample take" false
+
+  -- Cancellation and progress reset.
+  loader.resetProgress
+  check "progress reset" ((← loader.progress).total == 0)
+  let a ← loader.load "data/sample.png"
+  let b ← loader.load "data/sample.png"
+  check "cancel" ((← loader.cancel b) && (← loader.status b).isNone)
+  check "cancel unknown id" (!(← loader.cancel 999999))
+  loader.waitIdle
+  let p2 ← loader.progress
+  check "progress after cancel" (p2.finished == p2.total && p2.total ≥ 1)
+  let done ← loader.takeFinished
+  check "takeFinished" (done.map (·.1) == #[a])
+  for (_, h) in done do
+    if h != 0 then Allegro.destroyBitmap h
+  check "nothing left" ((← loader.status a).isNone)
+
+  loader.destroy
+  check "load after destroy → 0" ((← loader.load "data/sample.png") == 0)
+  q.destroy
+  pure true
+
+def testBitmapCache : IO Bool := do
+  printSection "Bitmap cache"
+  let oldFlags ← Allegro.getNewBitmapFlags
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let cache ← Allegro.BitmapCache.create
+
+  -- Different spellings of one file share a decode.
+  let a ← cache.acquire "data/sample.png"
+  let b ← cache.acquire "./data/../data/sample.png"
+  check "cached bitmap loaded" (a != 0)
+  check "same handle for same file" (a == b)
+  let st ← cache.stats
+  check "1 miss, 1 hit" (st.misses == 1 && st.hits == 1 && st.entries == 1)
+  let w ← Allegro.getBitmapWidth a
+  let h ← Allegro.getBitmapHeight a
+  let px ← Allegro.getBitmapFormat a
+  check "bytes = w × h × pixel size" (st.bytes == w.toNat * h.toNat * px.size.toNat)
+
+  -- Referenced bitmaps survive a zero budget; released ones are evicted.
+  cache.setBudget 0
+  check "referenced entry kept" ((← cache.stats).entries == 1)
+  cache.release a
+  check "still referenced once" ((← cache.stats).entries == 1)
+  cache.release b
+  let st2 ← cache.stats
+  check "released entry evicted" (st2.entries == 0 && st2.evictions == 1 && st2.bytes == 0)
+  cache.setBudget (64 * 1024 * 1024)
+
+  -- A changed file is decoded again; the old bitmap lives until released.
+  let tmp ← getTmpDir
+  let path := s!"{tmp}/allegro_lean_cache.png"
+  let small ← Allegro.createBitmap 8 8
+  let _ ← Allegro.saveBitmap path small
+  let old ← cache.acquire path
+  check "temp image cached" (old != 0 && (← Allegro.getBitmapWidth old) == 8)
+  let big ← Allegro.createBitmap 16 16
+  let _ ← Allegro.saveBitmap path big
+  let fresh ← cache.acquire path
+  check "changed file reloaded" (fresh != 0 && fresh != old && (← Allegro.getBitmapWidth fresh) == 16)
+  check "reload counted" ((← cache.stats).reloads == 1)
+  cache.release old
+  cache.release fresh
+  Allegro.destroyBitmap small
+  Allegro.destroyBitmap big
+
+  let missing ← cache.acquire "data/does_not_exist.png"
+  check "missing file → 0" (missing == 0)
+  cache.release 12345
+  cache.resetStats
+  check "resetStats" ((← cache.stats).misses == 0)
+  cache.trim
+  check "trim empties unreferenced" ((← cache.stats).entries == 0)
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testTextCache : IO Bool := do
+  printSection "Text layout cache"
+  let font : Font ← Allegro.createBuiltinFont
+  check "createBuiltinFont for text cache" (font != 0)
+  if font == 0 then return true
+  let cache ← Allegro.TextLayoutCache.create
+  let label := "Hello, cached world"
+  let w1 ← cache.width font label
+  let w2 ← cache.width font label
+  check "cached width matches getTextWidth" (w1 == (← Allegro.getTextWidth font label) && w2 == w1)
+  let r ← cache.bounds font label
+  check "cached bounds match getTextBounds" (r == (← Allegro.getTextBounds font label))
+  let text := "The quick brown fox jumps over the lazy dog"
+  let l1 ← cache.wrap font 80.0 text
+  let l2 ← cache.wrap font 80.0 text
+  check "cached wrap matches doMultilineText" (l1 == (← Allegro.doMultilineText font 80.0 text) && l2 == l1)
+  let l3 ← cache.wrap font 200.0 text
+  check "max width is part of the key" (l3.size ≤ l1.size)
+  let st ← cache.stats
+  check "hits and misses counted" (st.hits == 2 && st.misses == 4 && st.entries == 4)
+
+  cache.invalidateFont font
+  let st2 ← cache.stats
+  check "invalidateFont drops entries" (st2.entries == 0 && st2.bytes == 0)
+
+  -- Bounded memory: a small budget evicts the oldest labels.
+  cache.setBudget 4096
+  for i in [0:200] do
+    let _ ← cache.width font s!"label {i}"
+  let st3 ← cache.stats
+  check "bytes stay within budget" (st3.bytes ≤ 4096 && st3.evictions > 0)
+  let _ ← cache.width font "label 199"
+  check "recent entry survives" ((← cache.stats).hits == st3.hits + 1)
+  cache.clear
+  check "clear" ((← cache.stats).entries == 0)
+
+  check "process-wide cachedTextWidth" ((← font.cachedWidth label) == w1)
+  let before ← Allegro.textLayoutCache.stats
+  font.release
+  check "releaseFont clears textLayoutCache" ((← Allegro.textLayoutCache.stats).entries < before.entries)
+  pure true
+
+def testGlyphRun : IO Bool := do
+  printSection "Glyph runs"
+  let oldFlags ← Allegro.getNewBitmapFlags
+  let oldFormat ← Allegro.getNewBitmapFormat
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  Allegro.setNewBitmapFormat .abgr8888
+  let font : Font ← Allegro.loadTtfFont "data/DejaVuSans.ttf" 16 0
+  check "ttf font for glyph runs" (font != 0)
+  if font == 0 then
+    Allegro.setNewBitmapFormat oldFormat
+    Allegro.setNewBitmapFlags oldFlags
+    return true
+  let text := "Kerning AVAWAY 42"
+  let run ← Allegro.shapeGlyphRun font text
+  check "one quad per visible glyph" (run.size == (text.toList.filter (· != ' ')).length)
+  check "at least one page" (run.pageCount ≥ 1)
+  check "quads have source rects" (run.quads.all fun q => q.page != 0 && q.sw > 0 && q.sh > 0)
+  let w ← Allegro.getTextWidth font text
+  check "advance close to text width" ((run.advance - w.toFloat).abs ≤ 4.0)
+  check "empty string → empty run" ((← Allegro.shapeGlyphRun font "").size == 0)
+  check "null font → empty run" ((← Allegro.shapeGlyphRun 0 text).size == 0)
+
+  -- Same coverage as drawTextRgb.
+  let ref : Bitmap ← Allegro.createBitmap 192 32
+  let out : Bitmap ← Allegro.createBitmap 192 32
+  if ref != 0 && out != 0 then
+    let old ← Allegro.getTargetBitmap
+    Allegro.setTargetBitmap ref
+    Allegro.clearToColorRgb 0 0 0
+    Allegro.drawTextRgb font 255 255 255 4 4 Allegro.TextAlign.left text
+    Allegro.setTargetBitmap out
+    Allegro.clearToColorRgb 0 0 0
+    let calls ← run.draw 4 4
+    check "one draw call per page" (calls.toNat == run.pageCount)
+    Allegro.setTargetBitmap old
+    let sum (b : ByteArray) : Nat := b.foldl (fun n x => n + x.toNat) 0
+    let a := sum (← Allegro.readRegion ref 0 0 192 32 .abgr8888)
+    let b := sum (← Allegro.readRegion out 0 0 192 32 .abgr8888)
+    check "glyph run coverage matches drawTextRgb" (a > 0 && (if a > b then a - b else b - a) * 10 ≤ a)
+  if ref != 0 then ref.destroy
+  if out != 0 then out.destroy
+  font.destroy
+  Allegro.setNewBitmapFormat oldFormat
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testTextSprite : IO Bool := do
+  printSection "Text sprites"
+  let oldFlags ← Allegro.getNewBitmapFlags
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let font : Font ← Allegro.loadTtfFont "data/DejaVuSans.ttf" 16 0
+  check "ttf font for text sprites" (font != 0)
+  if font == 0 then
+    Allegro.setNewBitmapFlags oldFlags
+    return true
+  let text := "Credits: Lean + Allegro"
+  let white : Allegro.Color := Allegro.Color.rgb 255 255 255
+  let sprite ← Allegro.TextSprite.create font text white
+  let bounds ← Allegro.getTextBounds font text
+  check "sprite bitmap created" (sprite.bitmap != 0)
+  check "sprite covers text bounds" (sprite.width == bounds.w + 2 && sprite.height == bounds.h + 2)
+  check "empty text → no bitmap" ((← Allegro.TextSprite.create font "" white).bitmap == 0)
+
+  -- Same pixels as drawTextRgb on an opaque background.
+  Allegro.setNewBitmapFormat .abgr8888
+  let ref : Bitmap ← Allegro.createBitmap 256 32
+  let out : Bitmap ← Allegro.createBitmap 256 32
+  Allegro.setNewBitmapFormat .any
+  if ref != 0 && out != 0 then
+    let old ← Allegro.getTargetBitmap
+    Allegro.setTargetBitmap ref
+    Allegro.clearToColorRgb 0 0 64
+    Allegro.drawTextRgb font 255 255 255 8 6 Allegro.TextAlign.left text
+    Allegro.setTargetBitmap out
+    Allegro.clearToColorRgb 0 0 64
+    sprite.draw 8 6
+    Allegro.setTargetBitmap old
+    let a ← Allegro.readRegion ref 0 0 256 32 .abgr8888
+    let b ← Allegro.readRegion out 0 0 256 32 .abgr8888
+    let mut maxDiff := 0
+    for i in [0:a.size] do
+      let d := (Int.ofNat a[i]!.toNat - Int.ofNat b[i]!.toNat).natAbs
+      maxDiff := max maxDiff d
+    check s!"sprite matches drawTextRgb (max channel diff {maxDiff})" (maxDiff ≤ 2)
+  if ref != 0 then ref.destroy
+  if out != 0 then out.destroy
+  sprite.destroy
+
+  -- Cache: hits, pooling by size class, invalidation.
+  let cache ← Allegro.TextSpriteCache.create (maxSprites := 4) (maxPooled := 8)
+  let s1 ← cache.get font "Start" white
+  let s2 ← cache.get font "Start" white
+  check "cache hit returns the same sprite" (s1.bitmap == s2.bitmap && s1.bitmap != 0)
+  let red ← cache.get font "Start" (Allegro.Color.rgb 255 0 0)
+  check "colour is part of the key" (red.bitmap != s1.bitmap)
+  let st ← cache.stats
+  check "1 hit, 2 renders" (st.hits == 1 && st.renders == 2 && st.sprites == 2)
+  cache.invalidateFont font
+  let st2 ← cache.stats
+  check "invalidateFont pools bitmaps" (st2.sprites == 0 && st2.pooled == 2)
+  let _ ← cache.get font "Stats" white
+  check "same size class reuses a pooled bitmap" ((← cache.stats).reuses == 1)
+  for i in [0:6] do
+    let _ ← cache.get font s!"Item {i}" white
+  let st3 ← cache.stats
+  check "maxSprites bounds the cache" (st3.sprites ≤ 4 && st3.evictions > 0)
+  Allegro.invalidateFontCaches font
+  check "invalidateFontCaches reaches registered caches" ((← cache.stats).sprites == 0)
+  cache.destroy
+  check "destroy empties cache and pool" ((← cache.stats).sprites == 0 && (← cache.stats).pooled == 0)
+
+  -- Eviction spares the sprite being returned.
+  let tiny ← Allegro.TextSpriteCache.create (maxSprites := 1)
+  let a ← tiny.get font "Alpha" white
+  let b ← tiny.get font "Beta" white
+  check "get never evicts the sprite it returns" ((← tiny.stats).sprites == 1 && b.bitmap != 0 && b.bitmap != a.bitmap)
+  font.release
+  check "releaseFont drops cached sprites" ((← tiny.stats).sprites == 0)
+  tiny.destroy
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
+def testFontWarm : IO Bool := do
+  printSection "Glyph pre-rasterisation"
+  let cps := Allegro.glyphCodepoints #[.text "abba", .range 97 99, .range 5 1]
+  check "codepoints deduplicated in order" (cps.size == 12 && Allegro.Pack.readU32 cps 8 == 99)
+  let oldFlags ← Allegro.getNewBitmapFlags
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let font : Font ← Allegro.loadTtfFont "data/DejaVuSans.ttf" 18 0
+  check "ttf font for warm-up" (font != 0)
+  if font == 0 then
+    Allegro.setNewBitmapFlags oldFlags
+    return true
+  let r ← Allegro.warmFontGlyphs font #[Allegro.GlyphSet.ascii]
+  check "all printable ASCII found" (r.requested == 95 && r.glyphs == 95)
+  check "pages reported" (r.pages ≥ 1 && r.newPages ≥ 1 && r.newPages ≤ r.pages)
+  check "elapsed time reported" (r.elapsedMs ≥ 0.0)
+  let again ← font.warmGlyphs #[Allegro.GlyphSet.ascii]
+  check "re-warming creates no pages" (again.glyphs == 95 && again.newPages == 0)
+  Allegro.forgetFontGlyphs font
+  let fresh ← font.warmGlyphs #[Allegro.GlyphSet.ascii]
+  check "forgetFontGlyphs: pages count as new again" (fresh.newPages == fresh.pages)
+
+  -- Incremental warm-up, as on a loading screen.
+  let w ← Allegro.GlyphWarmer.create font #[Allegro.GlyphSet.latin1, .text "Ünïcödé — ok"]
+  check "warmer starts at 0" ((← w.progress) == 0.0)
+  let mut steps := 0
+  while !(← w.step 0.5) && steps < 10000 do
+    steps := steps + 1
+  check "warmer finishes" ((← w.done) && (← w.progress) == 1.0)
+  let wr ← w.report
+  check "latin-1 glyphs found" (wr.glyphs > 0 && wr.glyphs ≤ wr.requested)
+  check "null font → nothing found" ((← Allegro.warmFontGlyphs 0 #[Allegro.GlyphSet.ascii]).glyphs == 0)
+  let _ ← font.warmGlyphs #[Allegro.GlyphSet.ascii]
+  Allegro.invalidateFontCaches font
+  let again2 ← font.warmGlyphs #[Allegro.GlyphSet.ascii]
+  check "invalidateFontCaches forgets warmed pages" (again2.newPages == again2.pages)
+  font.release
+  Allegro.setNewBitmapFlags oldFlags
+  pure true
+
 -- ── Tuple API tests ──
 
 def testTupleApis (display : Allegro.Display) : IO Bool := do
@@ -1005,6 +1723,8 @@ def testTupleApis (display : Allegro.Display) : IO Bool := do
   Allegro.setClippingRectangle 10 20 100 50
   let (cx, cy, cw, ch) ← Allegro.getClippingRectangle
   check "getClippingRectangle tuple" (cx == 10 && cy == 20 && cw == 100 && ch == 50)
+  let clip ← Allegro.getClippingRect
+  check "getClippingRect record" (clip == { x := 10, y := 20, w := 100, h := 50 })
   Allegro.resetClippingRectangle
 
   -- Monitor info tuple
@@ -1012,6 +1732,10 @@ def testTupleApis (display : Allegro.Display) : IO Bool := do
   if numAdapters > 0 then
     let (mx1, my1, mx2, my2) ← Allegro.getMonitorInfo 0
     check "getMonitorInfo tuple" (mx2 > mx1 && my2 > my1)
+    let mon ← Allegro.getMonitor 0
+    check "getMonitor record matches tuple" (mon.x1 == mx1 && mon.y1 == my1 && mon.x2 == mx2 && mon.y2 == my2)
+  let badMon ← Allegro.getMonitor 9999
+  check "getMonitor invalid adapter → zeros" (badMon.width == 0 && badMon.height == 0)
 
   -- Display mode tuple
   let numModes ← Allegro.getNumDisplayModes
@@ -1028,6 +1752,8 @@ def testTupleApis (display : Allegro.Display) : IO Bool := do
   Allegro.setSeparateBlender Allegro.BlendOp.add Allegro.BlendFactor.one Allegro.BlendFactor.inverseAlpha Allegro.BlendOp.add Allegro.BlendFactor.alpha Allegro.BlendFactor.inverseAlpha
   let (sop, ssrc, sdst, saop, sasrc, sadst) ← Allegro.getSeparateBlender
   check "getSeparateBlender tuple" (sop == Allegro.BlendOp.add && ssrc == Allegro.BlendFactor.one && sdst == Allegro.BlendFactor.inverseAlpha && saop == Allegro.BlendOp.add && sasrc == Allegro.BlendFactor.alpha && sadst == Allegro.BlendFactor.inverseAlpha)
+  let bs ← Allegro.getBlenderState
+  check "getBlenderState record" (bs.op == Allegro.BlendOp.add && bs.src == Allegro.BlendFactor.one && bs.dst == Allegro.BlendFactor.inverseAlpha && bs.alphaOp == Allegro.BlendOp.add && bs.alphaSrc == Allegro.BlendFactor.alpha && bs.alphaDst == Allegro.BlendFactor.inverseAlpha)
 
   -- Transform coordinates tuple
   let tr : Transform ← Allegro.createTransform
@@ -1046,6 +1772,8 @@ def testTupleApis (display : Allegro.Display) : IO Bool := do
   Allegro.clearToColorRgb 128 64 255
   let (pr, pg, pb, pa) ← bmp.getPixelRgba 0 0
   check "getPixelRgba tuple" (pr == 128 && pg == 64 && pb == 255 && pa == 255)
+  let px ← bmp.getPixelColor 0 0
+  check "getPixelColor record" (px == Color.rgb 128 64 255)
   Allegro.setTargetBackbuffer display
   bmp.destroy
 
@@ -1054,6 +1782,8 @@ def testTupleApis (display : Allegro.Display) : IO Bool := do
   if font != 0 then
     let (tdx, _tdy, tdw, tdh) ← font.textDimensions "Hello"
     check "getTextDimensions tuple" (tdx == 0 && tdw > 0 && tdh > 0)
+    let tb ← font.textBounds "Hello"
+    check "getTextBounds record matches tuple" (tb.toTuple == (tdx, _tdy, tdw, tdh))
     font.destroy
 
   pure true
@@ -1354,6 +2084,8 @@ def testFontExtras : IO Bool := do
     let (bmpHandle, _, _, _, _, _, _, _, _) := glyph
     -- builtin font: glyph bitmap may or may not be non-zero, but the call shouldn't crash
     check "getGlyph no crash" (bmpHandle ≥ 0)
+    let gi ← font.glyphInfo 65
+    check "getGlyphInfo bitmap matches tuple" (gi.bitmap == bmpHandle)
 
     font.destroy
   pure true
@@ -1601,6 +2333,8 @@ def testBlendingExtras : IO Bool := do
   check "setBlendColor g ≈ 0.25" (bg > 0.15 && bg < 0.35)
   check "setBlendColor b ≈ 0.75" (bb > 0.65 && bb < 0.85)
   check "setBlendColor a ≈ 1.0" (ba > 0.9 && ba < 1.1)
+  let bcf ← Allegro.getBlendColorF
+  check "getBlendColorF record" (bcf.r > 0.4 && bcf.r < 0.6 && bcf.b > 0.65 && bcf.b < 0.85)
 
   -- clearDepthBuffer (just no-crash test)
   Allegro.clearDepthBuffer 1.0
@@ -1679,6 +2413,8 @@ def testAudioExtras : IO Bool := do
   -- getAudioDepthSize: ALLEGRO_AUDIO_DEPTH_INT16 = 0x01 → 2 bytes
   let ds ← Allegro.getAudioDepthSize Allegro.AudioDepth.int16
   check "getAudioDepthSize(INT16) = 2" (ds == 2)
+  check "ChannelConf.count pure (CONF_5_1) = 6" (Allegro.ChannelConf.conf51.count == 6)
+  check "AudioDepth.size pure (FLOAT32) = 4" (Allegro.AudioDepth.float32.size == 4)
 
   -- Default mixer inspection
   let mixer : Mixer ← Allegro.getDefaultMixer
@@ -1822,6 +2558,14 @@ def testUstrRemaining : IO Bool := do
   check "utf16Encode('A') w1 = 65" (w1 == 65)
   check "utf16Encode('A') w2 = 0 (BMP)" (w2 == 0)
 
+  -- Pure codepoint / pixel-format helpers
+  check "Utf8.width pure (U+20AC) = 3" (Utf8.width 0x20AC == 3)
+  check "Utf16.width pure (U+1F600) = 2" (Utf16.width 0x1F600 == 2)
+  check "Utf8.encode pure 'A'" (Utf8.encode 65 == "A")
+  check "PixelFormat.size pure (ARGB8888) = 4" (PixelFormat.argb8888.size == 4)
+  check "PixelFormat.bits pure (RGB565) = 16" (PixelFormat.rgb565.bits == 16)
+  check "PixelFormat.blockWidth pure (ARGB8888) = 1" (PixelFormat.argb8888.blockWidth == 1)
+
   pure true
 
 -- ── Gap-fill: Color constructors ──
@@ -1838,6 +2582,8 @@ def testColorConstructors : IO Bool := do
   check "colorHsv red r ≈ 255" (hr > 240)
   check "colorHsv red g ≈ 0" (hg < 15)
   check "colorHsv red a = 255" (ha == 255)
+  let hsvRec ← Allegro.colorHsvRgba 0.0 1.0 1.0
+  check "colorHsvRgba record matches tuple" (hsvRec.toTuple == (hr, hg, _hb, ha))
 
   -- colorHsl: pure green = (120, 1, 0.5)
   let (lr, lg, lb, la) ← Allegro.colorHsl 120.0 1.0 0.5
@@ -2318,6 +3064,8 @@ def testPrimitivesDrawing : IO Bool := do
   let polyVerts := Allegro.packPoints [(0.0, 0.0), (0.0, 100.0), (100.0, 100.0), (100.0, 0.0)]
   let tris ← Allegro.triangulatePolygon polyVerts #[(4 : UInt32)]
   check "triangulatePolygon returns ≥ 2 triangles" (tris.size >= 2)
+  check "triangulatePolygon: counts beyond the vertices → empty"
+    ((← Allegro.triangulatePolygon polyVerts #[(400 : UInt32)]).size == 0)
 
   -- drawFilledPolygonWithHolesRgb — draw a simple square, white
   Allegro.drawFilledPolygonWithHolesRgb polyVerts #[(4 : UInt32)] 255 255 255
@@ -2351,6 +3099,193 @@ def testPrimitivesDrawing : IO Bool := do
   let drawnIdxEmpty ← Allegro.drawIndexedPrimBA ByteArray.empty 0 0 #[] 0 Allegro.PrimType.triangleList
   check "drawIndexedPrimBA: empty returns 0" (drawnIdxEmpty == 0)
 
+  -- ── Packed int32 indices / contour counts ──
+  let idxPacked := Allegro.packIndices #[0, 1, 2]
+  check "packIndices size = 12" (idxPacked.size == 12)
+  let drawnPacked ← Allegro.drawIndexedPrimPacked triVtx 0 0 idxPacked Allegro.PrimType.triangleList
+  check "drawIndexedPrimPacked: triangle drawn" (drawnPacked > 0)
+  let drawnPackedEmpty ← Allegro.drawIndexedPrimPacked triVtx 0 0 ByteArray.empty Allegro.PrimType.triangleList
+  check "drawIndexedPrimPacked: no indices returns 0" (drawnPackedEmpty == 0)
+
+  let counts := Allegro.packIndices #[4]
+  let trisPacked ← Allegro.triangulatePolygonPacked polyVerts counts
+  check "triangulatePolygonPacked matches triangulatePolygon" (trisPacked.size == tris.size * 12)
+  let countsTerminated := Allegro.packIndices #[4, 0]
+  let trisTerm ← Allegro.triangulatePolygonPacked polyVerts countsTerminated
+  check "triangulatePolygonPacked accepts 0-terminated counts" (trisTerm.size == trisPacked.size)
+  let trisBad ← Allegro.triangulatePolygonPacked polyVerts (Allegro.packIndices #[40])
+  check "triangulatePolygonPacked: counts beyond vertices → empty" (trisBad.size == 0)
+  Allegro.drawFilledPolygonWithHolesPacked polyVerts counts Color.white
+  Allegro.drawFilledPolygonWithHolesPacked polyVerts (Allegro.packIndices #[40]) Color.white
+  check "drawFilledPolygonWithHolesPacked no crash" true
+
+  pure true
+
+-- ── Sprite batches ──
+
+def testSpriteBatch (display : Allegro.Display) : IO Bool := do
+  printSection "Sprite batch"
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+
+  -- 8×4 atlas: left half red, right half green
+  let atlas : Bitmap ← Allegro.createBitmap 8 4
+  atlas.setAsTarget
+  Allegro.clearToColorRgb 255 0 0
+  Allegro.drawFilledRectangleRgb 4 0 8 4 0 255 0
+
+  let target : Bitmap ← Allegro.createBitmap 32 32
+  target.setAsTarget
+  Allegro.clearToColorRgb 0 0 0
+  let batch := SpriteBatch.empty
+    |>.add 0 0 4 4 4 4                                          -- red, 2..6
+    |>.add 4 0 4 4 12 4 (flip := FlipFlags.horizontal)           -- green, 10..14
+    |>.add 0 0 4 4 4 12 (scale := 2.0) (rotation := Allegro.pi / 2.0)  -- red, 0..8 × 8..16
+    |>.add 4 0 4 4 20 20 (tint := Color.rgb 0 0 0)               -- tinted black
+  check "SpriteBatch size = 4" (batch.size == 4)
+  check "SpriteBatch record size" (batch.bytes.size == 4 * SpriteBatch.recordSize)
+
+  let n ← batch.draw atlas
+  check "drawSpriteBatch returns sprite count" (n == 4)
+  check "sprite 1 pixel" ((← target.getPixelColor 4 4) == Color.rgb 255 0 0)
+  check "sprite 2 (flipped) pixel" ((← target.getPixelColor 12 4) == Color.rgb 0 255 0)
+  check "sprite 3 (scaled, rotated) pixel" ((← target.getPixelColor 1 9) == Color.rgb 255 0 0)
+  check "sprite 4 (tinted) pixel" ((← target.getPixelColor 20 20) == Color.rgb 0 0 0)
+  check "outside sprites untouched" ((← target.getPixelColor 28 4) == Color.rgb 0 0 0)
+
+  -- Trailing partial record ignored; empty / null atlas draw nothing
+  let partialRec := batch.bytes.extract 0 (SpriteBatch.recordSize + 7)
+  check "drawSpriteBatch ignores partial record" ((← Allegro.drawSpriteBatch atlas partialRec) == 1)
+  check "drawSpriteBatch empty → 0" ((← SpriteBatch.empty.draw atlas) == 0)
+  check "drawSpriteBatch null atlas → 0" ((← batch.draw 0) == 0)
+
+  Allegro.setTargetBackbuffer display
+  target.destroy
+  atlas.destroy
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.none
+  pure true
+
+-- ── Shape batches ──
+
+def testShapeBatch (display : Allegro.Display) : IO Bool := do
+  printSection "Shape batch"
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let target : Bitmap ← Allegro.createBitmap 64 64
+  target.setAsTarget
+  Allegro.clearToColorRgb 0 0 0
+
+  let sb := ShapeBatch.empty
+    |>.filledRectangle 0 0 10 10 Color.red
+    |>.rectangle 20.5 0.5 30.5 10.5 Color.green
+    |>.filledCircle 40 40 8 Color.blue
+    |>.circle 10 40 8 Color.yellow 2.0
+    |>.line 0 60.5 63 60.5 Color.white
+    |>.point 50 5 Color.cyan
+  check "ShapeBatch count = 6" (sb.count == 6)
+  let n ← sb.draw
+  check "drawShapeBatch returns shape count" (n == 6)
+  check "filledRectangle pixel" ((← target.getPixelColor 5 5) == Color.red)
+  check "rectangle outline pixel" ((← target.getPixelColor 25 0) == Color.green)
+  check "rectangle interior untouched" ((← target.getPixelColor 25 5) == Color.black)
+  check "filledCircle pixel" ((← target.getPixelColor 40 40) == Color.blue)
+  check "circle outline pixel" ((← target.getPixelColor 18 40) == Color.yellow)
+  check "circle interior untouched" ((← target.getPixelColor 10 40) == Color.black)
+  check "line pixel" ((← target.getPixelColor 30 60) == Color.white)
+  check "point pixel" ((← target.getPixelColor 50 5) == Color.cyan)
+
+  -- Same radius twice (segment-count cache hit) and malformed tail
+  let again := ShapeBatch.empty.filledCircle 40 40 8 Color.red
+  let bad := again.bytes ++ ByteArray.mk #[0x7F, 0, 0, 0]
+  check "drawShapeBatch stops at unknown opcode" ((← Allegro.drawShapeBatch bad) == 1)
+  check "cached-radius circle pixel" ((← target.getPixelColor 40 40) == Color.red)
+  check "drawShapeBatch empty → 0" ((← ShapeBatch.empty.draw) == 0)
+
+  Allegro.setTargetBackbuffer display
+  target.destroy
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.none
+  pure true
+
+-- ── Packed point arrays ──
+
+def testVec2Array (display : Allegro.Display) : IO Bool := do
+  printSection "Vec2Array"
+
+  let pts := Vec2Array.empty |>.push ⟨10, 10⟩ |>.pushXY 50 10 |>.pushXY 50 50 |>.pushXY 10 50
+  check "Vec2Array size = 4" (pts.size == 4)
+  check "Vec2Array packed as f32 pairs" (pts.data.size == 32)
+  check "Vec2Array get" (pts.get 2 == ⟨50, 50⟩)
+  check "Vec2Array get out of range → zero" (pts.get 9 == Vec2.zero)
+  let moved := pts.set 0 ⟨12, 12⟩
+  check "Vec2Array set" (moved.get 0 == ⟨12, 12⟩ && moved.size == 4)
+  check "Vec2Array set out of range is a no-op" ((pts.set 9 ⟨1, 1⟩).data == pts.data)
+  check "Vec2Array matches packPoints"
+    ((Vec2Array.ofList [(10, 10), (50, 10), (50, 50), (10, 50)]).data == Allegro.packPoints [(10, 10), (50, 10), (50, 50), (10, 50)])
+  let fa : FloatArray := ⟨#[10, 10, 50, 10, 50, 50, 10, 50, 99]⟩
+  check "Vec2Array.ofFloatArray drops odd coordinate" ((Vec2Array.ofFloatArray fa).data == pts.data)
+  check "Vec2Array toArray round-trip" ((Vec2Array.ofArray pts.toArray).data == pts.data)
+
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let target : Bitmap ← Allegro.createBitmap 64 64
+  target.setAsTarget
+  Allegro.clearToColorRgb 0 0 0
+  Allegro.drawFilledPolygon pts Color.red
+  check "drawFilledPolygon (Vec2Array) pixel" ((← target.getPixelColor 30 30) == Color.red)
+  let line := Vec2Array.ofList [(0, 60.5), (63, 60.5)]
+  Allegro.drawPolyline line Color.green LineJoin.none LineCap.none 1.0 0.0
+  check "drawPolyline (Vec2Array) pixel" ((← target.getPixelColor 30 60) == Color.green)
+  Allegro.drawPolygon pts Color.blue LineJoin.none 2.0 0.0
+  check "drawPolygon (Vec2Array) pixel" ((← target.getPixelColor 30 10) == Color.blue)
+  let tris ← pts.triangulate
+  check "Vec2Array.triangulate → 2 triangles" (tris.size == 2 * 12)
+  let ribbon ← line.calculateRibbon 2.0 1
+  check "Vec2Array.calculateRibbon → 4 points" (ribbon.size == 4)
+  let clamped ← line.calculateRibbon 2.0 50
+  check "calculateRibbon clamps segments to input" (clamped.size == 4)
+
+  Allegro.setTargetBackbuffer display
+  target.destroy
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.none
+  pure true
+
+-- ── Typed vertex layouts ──
+
+/-- Test vertex: position + 0–255 colour. -/
+structure ColVertex where
+  pos : Vec2
+  col : Color
+
+instance : VertexLayout ColVertex :=
+  VertexLayout.empty
+    |>.field PrimAttr.position (·.pos)
+    |>.field PrimAttr.color (·.col)
+
+def testVertexLayout (display : Allegro.Display) : IO Bool := do
+  printSection "Vertex layouts"
+  check "VertexLayout stride = 24" (VertexLayout.stride (α := ColVertex) == 24)
+  let elems := VertexLayout.elements (α := ColVertex)
+  check "VertexLayout offsets"
+    (elems.map (·.2.2) == #[0, 8]
+      && elems.map (·.1.val) == #[PrimAttr.position.val, PrimAttr.color.val]
+      && elems.map (·.2.1.val) == #[PrimStorage.float2.val, PrimStorage.float4.val])
+
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.memory
+  let target : Bitmap ← Allegro.createBitmap 32 32
+  target.setAsTarget
+  Allegro.clearToColorRgb 0 0 0
+  let w ← VertexWriter.create ColVertex (capacity := 3)
+  check "VertexWriter decl non-zero" (w.decl != 0)
+  let w := w.push ⟨⟨0, 0⟩, Color.green⟩ |>.push ⟨⟨32, 0⟩, Color.green⟩ |>.push ⟨⟨0, 32⟩, Color.green⟩
+  check "VertexWriter bytes = 3 × stride" (w.bytes.size == 72 && w.count == 3)
+  let drawn ← w.draw 0 PrimType.triangleList
+  check "VertexWriter.draw returns 1 triangle" (drawn == 1)
+  check "VertexWriter triangle pixel" ((← target.getPixelColor 4 4) == Color.green)
+  check "VertexWriter outside triangle untouched" ((← target.getPixelColor 30 30) == Color.black)
+  let w := w.clear
+  check "VertexWriter.clear empties" (w.count == 0 && w.bytes.size == 0)
+  w.destroy
+
+  Allegro.setTargetBackbuffer display
+  target.destroy
+  Allegro.setNewBitmapFlags Allegro.BitmapFlags.none
   pure true
 
 -- ── Gap-fill: Vertex & Index buffers ──
@@ -2389,6 +3324,37 @@ def testVertexIndexBuffers : IO Bool := do
 
   pure true
 
+-- ── Streaming vertex buffer ring ──
+
+def testStreamingVertexBuffer : IO Bool := do
+  printSection "Streaming vertex buffer"
+  -- Three ALLEGRO_VERTEX (36 bytes each): x y z u v r g b a
+  let tri := Allegro.packFloats #[
+    10.0, 10.0, 0.0,  0.0, 0.0,  1.0, 1.0, 1.0, 1.0,
+    50.0, 10.0, 0.0,  0.0, 0.0,  1.0, 1.0, 1.0, 1.0,
+    30.0, 50.0, 0.0,  0.0, 0.0,  1.0, 1.0, 1.0, 1.0]
+  check "createStreamingVertexBuffer: stride must match decl"
+    ((← Allegro.createStreamingVertexBuffer 0 32 6) == 0)
+  let svb ← Allegro.createStreamingVertexBuffer 0 36 6 (ring := 2)
+  if svb == 0 then
+    check "createStreamingVertexBuffer unavailable (OK without GPU buffers)" true
+    return true
+  let r1 ← svb.append tri
+  check "append: first range at 0" (r1.start == 0 && r1.count == 3 && r1.buffer != 0)
+  let r2 ← svb.append tri
+  check "append: second range follows" (r2.start == 3 && r2.count == 3 && r2.buffer == r1.buffer)
+  let r3 ← svb.append tri
+  check "append: wraps to next ring buffer" (r3.start == 0 && r3.count == 3 && r3.buffer != r1.buffer)
+  let drawn ← Allegro.drawVertexRange r3 0 Allegro.PrimType.triangleList
+  check "drawVertexRange draws the triangle" (drawn > 0)
+  let big ← svb.append (tri ++ tri ++ tri)
+  check "append larger than a buffer → count 0" (big.count == 0)
+  check "drawVertexRange empty → 0" ((← Allegro.drawVertexRange big 0 Allegro.PrimType.triangleList) == 0)
+  let emptyRange ← svb.append ByteArray.empty
+  check "append empty → count 0" (emptyRange.count == 0)
+  svb.destroy
+  pure true
+
 -- ── Gap-fill: Raw sample creation + setDefaultVoice + channel matrices ──
 
 def testAudioRawSample : IO Bool := do
@@ -2918,6 +3884,48 @@ def testHaptic : IO Bool := do
 
   pure true
 
+-- ── Recorded draw lists ──
+
+def testDrawList (display : Allegro.Display) : IO Bool := do
+  printSection "DrawList"
+
+  -- 4×4 green sprite to blit from
+  let sprite : Bitmap ← Allegro.createBitmap 4 4
+  sprite.setAsTarget
+  Allegro.clearToColorRgb 0 255 0
+
+  let target : Bitmap ← Allegro.createBitmap 32 32
+  target.setAsTarget
+  let font : Font ← Allegro.createBuiltinFont
+  let dl := DrawList.empty
+    |>.clear (Color.rgb 0 0 0)
+    |>.filledRectangle 0 0 8 8 (Color.rgb 255 0 0)
+    |>.bitmap sprite 16 0
+    |>.bitmapRegion sprite 0 0 2 2 16 16
+    |>.text font (Color.rgb 255 255 255) 0 24 TextAlign.left "hi"
+    |>.line 0 31.5 32 31.5 (Color.rgb 0 0 255)
+  check "DrawList count = 6" (dl.count == 6)
+
+  let n ← dl.execute
+  check "DrawList.execute runs all commands" (n == 6)
+  check "DrawList filledRectangle pixel" ((← target.getPixelColor 2 2) == Color.rgb 255 0 0)
+  check "DrawList bitmap pixel" ((← target.getPixelColor 17 1) == Color.rgb 0 255 0)
+  check "DrawList bitmapRegion pixel" ((← target.getPixelColor 17 17) == Color.rgb 0 255 0)
+  check "DrawList bitmapRegion clipped to source region" ((← target.getPixelColor 19 19) == Color.rgb 0 0 0)
+  check "DrawList line pixel" ((← target.getPixelColor 10 31) == Color.rgb 0 0 255)
+  check "DrawList restores hold state" ((← Allegro.isBitmapDrawingHeld) == 0)
+
+  -- Lists concatenate and an empty list is a no-op
+  let both := DrawList.empty.clear (Color.rgb 9 9 9) ++ DrawList.empty.resetClip
+  check "DrawList append count" (both.count == 2)
+  check "DrawList empty executes nothing" ((← DrawList.empty.execute) == 0)
+
+  Allegro.setTargetBackbuffer display
+  if font != 0 then font.destroy
+  target.destroy
+  sprite.destroy
+  pure true
+
 def main : IO UInt32 := do
   let okInit ← Allegro.init
   if okInit == 0 then
@@ -2974,6 +3982,16 @@ def main : IO UInt32 := do
   if hasDisplay then let _ ← testDisplayExtras display; pure ()
   if hasDisplay then let _ ← testMouseCursor display; pure ()
   if hasDisplay then let _ ← testBitmapExtras; pure ()
+  let _ ← testPixelKernels
+  let _ ← testFilters
+  let _ ← testResize
+  let _ ← testAtlas
+  let _ ← testAssetLoader hasAudio
+  let _ ← testBitmapCache
+  let _ ← testTextCache
+  let _ ← testGlyphRun
+  let _ ← testTextSprite
+  let _ ← testFontWarm
   if hasDisplay then let _ ← testTupleApis display; pure ()
   if hasDisplay then let _ ← testOptionApis display; pure ()
   let _ ← testEventExtras
@@ -3006,7 +4024,12 @@ def main : IO UInt32 := do
   let _ ← testUserEvent
   let _ ← testJoystickExtras
   if hasDisplay then let _ ← testPrimitivesDrawing; pure ()
+  if hasDisplay then let _ ← testSpriteBatch display; pure ()
+  if hasDisplay then let _ ← testShapeBatch display; pure ()
+  if hasDisplay then let _ ← testVec2Array display; pure ()
+  if hasDisplay then let _ ← testVertexLayout display; pure ()
   if hasDisplay then let _ ← testVertexIndexBuffers; pure ()
+  if hasDisplay then let _ ← testStreamingVertexBuffer; pure ()
   if hasAudio then let _ ← testAudioRawSample; pure ()
   if hasAudio then let _ ← testFileBasedAudio; pure ()
   if hasDisplay then let _ ← testFileBasedTtf; pure ()
@@ -3016,6 +4039,7 @@ def main : IO UInt32 := do
   let _ ← testFilesystem
   if hasDisplay then let _ ← testShader; pure ()
   let _ ← testHaptic
+  if hasDisplay then let _ ← testDrawList display; pure ()
   if hasDisplay then let _ ← testUninstallInput; pure ()  -- destructive: must be last
 
   -- Cleanup
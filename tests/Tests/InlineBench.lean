@@ -0,0 +1,120 @@
+import Allegro
+
+/-!
+# Inline accessor microbenchmark
+
+Compares the `extern c inline` field accessors (event fields, locked-region
+fields, `keyDown`) against the out-of-line `allegro_al_*` shim functions
+they replaced. The out-of-line versions are re-bound locally under their
+original C symbols so both paths read exactly the same memory.
+
+Runs headless: the event comes from a user event source and the locked
+region from a memory bitmap.
+
+Run: `lake build allegroInlineBench && .lake/build/bin/allegroInlineBench`
+-/
+
+open Allegro
+
+namespace InlineBench
+
+-- ── Out-of-line baselines (same C symbols as before the inline change) ──
+
+@[extern "allegro_al_event_get_type"]
+opaque eventGetTypeCall : Event → IO UInt32
+
+@[extern "allegro_al_event_get_mouse_x"]
+opaque eventGetMouseXCall : Event → IO UInt32
+
+@[extern "allegro_al_event_get_mouse_x_f"]
+opaque eventGetMouseXfCall : Event → IO Float
+
+@[extern "allegro_al_locked_region_get_pitch"]
+opaque lockedRegionGetPitchCall : LockedRegion → IO UInt32
+
+@[extern "allegro_al_key_down"]
+opaque keyDownCall : KeyboardState → UInt32 → IO UInt32
+
+/-- Iterations per measurement. -/
+def iterations : Nat := 20_000_000
+
+/-- Time `n` calls of `act` and return ns/call. `@[specialize]` makes the
+    compiler copy `act`'s body into the loop, so inline accessors really
+    are inlined rather than called through a closure. -/
+@[specialize] def nsPerCall (n : Nat) (act : IO UInt32) : IO Float := do
+  let t0 ← IO.monoNanosNow
+  let mut acc : UInt32 := 0
+  for _ in [0:n] do
+    acc := acc + (← act)
+  let t1 ← IO.monoNanosNow
+  -- Keep the accumulated value observable so the loop cannot be dropped.
+  if acc == 0xDEADBEEF then IO.println ""
+  return (t1 - t0).toFloat / n.toFloat
+
+/-- Print one comparison row and return the speed-up factor. -/
+def report (label : String) (callNs inlineNs : Float) : IO Float := do
+  let speedup := if inlineNs > 0.0 then callNs / inlineNs else 0.0
+  IO.println s!"  {label}: call {callNs} ns, inline {inlineNs} ns, speed-up ×{speedup}"
+  return speedup
+
+end InlineBench
+
+open InlineBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+
+  IO.println "=== Inline accessor microbenchmark ==="
+  IO.println s!"  iterations per row: {iterations}"
+
+  -- Event buffer filled from a user event source.
+  let q ← Allegro.createEventQueue
+  let src ← Allegro.initUserEventSource
+  q.registerSource src
+  let _ ← src.emit 1 2 3 4
+  let ev ← Allegro.createEvent
+  let _ ← q.getNext ev
+
+  let _ ← report "eventGetType"
+    (← nsPerCall iterations (eventGetTypeCall ev))
+    (← nsPerCall iterations (do let t ← eventGetType ev; pure t.val))
+  let _ ← report "eventGetMouseX"
+    (← nsPerCall iterations (eventGetMouseXCall ev))
+    (← nsPerCall iterations (eventGetMouseX ev))
+  let _ ← report "eventGetMouseXf"
+    (← nsPerCall iterations (do let x ← eventGetMouseXfCall ev; pure x.toUInt32))
+    (← nsPerCall iterations (do let x ← eventGetMouseXf ev; pure x.toUInt32))
+
+  -- Locked region of a memory bitmap.
+  Allegro.setNewBitmapFlags BitmapFlags.memory
+  let bmp ← Allegro.createBitmap 64 64
+  if bmp != 0 then
+    let lr ← Allegro.lockBitmap bmp PixelFormat.any LockMode.readonly
+    if lr != 0 then
+      let _ ← report "lockedRegionGetPitch"
+        (← nsPerCall iterations (lockedRegionGetPitchCall lr))
+        (← nsPerCall iterations (lockedRegionGetPitch lr))
+      Allegro.unlockBitmap bmp
+    Allegro.destroyBitmap bmp
+
+  -- Keyboard state (snapshotted only if a keyboard driver is available).
+  let ks ← Allegro.createKeyboardState
+  let kbOk ← Allegro.installKeyboard
+  if kbOk != 0 then Allegro.getKeyboardState ks
+  if kbOk != 0 then
+    let _ ← report "keyDown"
+      (← nsPerCall iterations (keyDownCall ks KeyCode.escape.val))
+      (← nsPerCall iterations (keyDown ks KeyCode.escape))
+  else
+    IO.println "  keyDown: skipped (no keyboard driver)"
+  Allegro.destroyKeyboardState ks
+
+  ev.destroy
+  q.unregisterSource src
+  src.destroy
+  q.destroy
+  Allegro.uninstallSystem
+  return 0
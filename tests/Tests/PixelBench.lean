@@ -0,0 +1,122 @@
+import Allegro
+
+/-!
+# Pixel conversion throughput benchmark
+
+Converts a 1920×1080 frame between the kernel formats and reports
+megapixels per second for:
+
+* the shim kernels on `ByteArray`s (`convertPixels`, `fillPixels`,
+  `blitPixels`),
+* `readRegion` / `writeRegion` on a memory bitmap, which lock in the
+  bitmap's own format and convert with the same kernels,
+* Allegro's generic converter, reached by locking the bitmap in a format
+  other than its own (`lockBitmap … readonly`, then `unlockBitmap`).
+
+Runs headless on memory bitmaps. Each row is the median of `reps` runs.
+
+Run: `lake build allegroPixelBench && .lake/build/bin/allegroPixelBench`
+-/
+
+open Allegro
+
+namespace PixelBench
+
+def width : UInt32 := 1920
+def height : UInt32 := 1080
+
+/-- Runs per row. -/
+def reps : Nat := 30
+
+def pixels : Float := (width * height).toNat.toFloat
+
+/-- Median ms over `reps` runs of `act`. The result size is summed so the
+    work cannot be discarded. -/
+@[specialize] def medianMs (act : IO Nat) : IO Float := do
+  let mut times : Array Float := Array.mkEmpty reps
+  let mut acc := 0
+  for _ in [0:reps] do
+    let t0 ← IO.monoNanosNow
+    acc := acc + (← act)
+    let t1 ← IO.monoNanosNow
+    times := times.push ((t1 - t0).toFloat / 1.0e6)
+  if acc == 0xDEADBEEF then IO.println ""
+  let sorted := times.qsort (· < ·)
+  return sorted[sorted.size / 2]!
+
+def report (label : String) (ms : Float) : IO Unit :=
+  let mps := if ms > 0.0 then pixels / (ms / 1000.0) / 1.0e6 else 0.0
+  IO.println s!"  {label}: {ms} ms, {mps} Mpx/s"
+
+def formatName (fmt : PixelFormat) : String :=
+  if fmt == PixelFormat.argb8888 then "ARGB8888"
+  else if fmt == PixelFormat.rgba8888 then "RGBA8888"
+  else if fmt == PixelFormat.abgr8888 then "ABGR8888"
+  else if fmt == PixelFormat.rgb565 then "RGB565"
+  else if fmt == PixelFormat.abgrF32 then "ABGR_F32"
+  else s!"format {fmt.val}"
+
+end PixelBench
+
+open PixelBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+
+  IO.println "=== Pixel conversion benchmark ==="
+  IO.println s!"  {width}×{height}, median of {reps} runs"
+
+  -- Procedural ABGR8888 source frame.
+  let mut src := ByteArray.emptyWithCapacity (width * height * 4).toNat
+  for i in [0:(width * height).toNat] do
+    src := Pack.u32 src (i.toUInt32 * 2654435761)
+
+  -- Buffers are read through refs inside each timed action so the pure
+  -- kernels run every time instead of being evaluated once up front.
+  let srcRef ← IO.mkRef src
+  let targets := #[PixelFormat.argb8888, .rgba8888, .rgb565, .abgrF32]
+  IO.println "-- convertPixels (ByteArray kernels)"
+  for fmt in targets do
+    report s!"ABGR8888 → {formatName fmt}"
+      (← medianMs (do pure (convertPixels (← srcRef.get) .abgr8888 fmt width height).size))
+    let convRef ← IO.mkRef (convertPixels src .abgr8888 fmt width height)
+    report s!"{formatName fmt} → ABGR8888"
+      (← medianMs (do pure (convertPixels (← convRef.get) fmt .abgr8888 width height).size))
+
+  IO.println "-- fill / copy-rect (ByteArray kernels)"
+  let canvas ← IO.mkRef (ByteArray.mk (Array.replicate (width * height * 4).toNat 0))
+  report "fillPixels ARGB8888" (← medianMs do
+    canvas.modify (fillPixels · .argb8888 width 0 0 width height { r := 10, g := 20, b := 30 })
+    pure (← canvas.get).size)
+  report "blitPixels ABGR8888 → ARGB8888" (← medianMs do
+    let s ← srcRef.get
+    canvas.modify (blitPixels · .argb8888 width 0 0 s .abgr8888 width 0 0 width height)
+    pure (← canvas.get).size)
+
+  IO.println "-- memory bitmap: shim kernels vs Allegro's converter"
+  setNewBitmapFlags BitmapFlags.memory
+  for fmt in targets do
+    setNewBitmapFormat fmt
+    let bmp ← createBitmap width height
+    if bmp == 0 then
+      IO.println s!"  {formatName fmt}: skipped (cannot create bitmap)"
+      continue
+    let _ ← writeRegion bmp 0 0 width height .abgr8888 src
+    report s!"{formatName fmt}: writeRegion from ABGR8888"
+      (← medianMs (do let ok ← writeRegion bmp 0 0 width height .abgr8888 src; pure ok.toNat))
+    report s!"{formatName fmt}: readRegion to ABGR8888"
+      (← medianMs (do let b ← readRegion bmp 0 0 width height .abgr8888; pure b.size))
+    report s!"{formatName fmt}: Allegro lock as ABGR8888"
+      (← medianMs (do
+        let lr ← lockBitmap bmp .abgr8888 LockMode.readonly
+        if lr != 0 then unlockBitmap bmp
+        pure (if lr != 0 then 1 else 0)))
+    report s!"{formatName fmt}: fillRegion"
+      (← medianMs (do let ok ← fillRegion bmp 0 0 width height { r := 10, g := 20, b := 30 }; pure ok.toNat))
+    destroyBitmap bmp
+
+  uninstallSystem
+  return 0
@@ -0,0 +1,110 @@
+import Allegro
+
+/-!
+# Sprite batch throughput benchmark
+
+Draws `spriteCount` scaled, rotated, tinted sprites from one atlas per frame
+and compares:
+
+* one `drawTintedScaledRotatedBitmapRegionRgb` call per sprite,
+* the same inside `holdBitmapDrawing` (Allegro's own deferred batching),
+* `SpriteBatch` — recording the instance buffer *and* drawing it with
+  `drawSpriteBatch`, i.e. one FFI call and one `al_draw_prim` per frame.
+
+Uses a window when a display can be created (GPU path); otherwise falls back
+to a memory-bitmap target, where both paths run in Allegro's software
+renderer and only relative numbers are meaningful.
+
+Run: `lake build allegroSpriteBench && .lake/build/bin/allegroSpriteBench`
+-/
+
+open Allegro
+
+namespace SpriteBench
+
+/-- Sprites per frame. -/
+def spriteCount : Nat := 10_000
+
+/-- Frames per row. -/
+def frames : Nat := 60
+
+/-- Deterministic per-sprite placement: `(dx, dy, rotation)`. -/
+@[inline] def place (i : Nat) : Float × Float × Float :=
+  let f := i.toFloat
+  ((f * 37.0) - Float.floor (f * 37.0 / 640.0) * 640.0,
+   (f * 11.0) - Float.floor (f * 11.0 / 480.0) * 480.0,
+   f * 0.01)
+
+/-- Time `frames` runs of `frame` (flushing after each) and return ms/frame. -/
+@[specialize] def msPerFrame (frame : IO Unit) (flush : IO Unit) : IO Float := do
+  let t0 ← IO.monoNanosNow
+  for _ in [0:frames] do
+    frame
+    flush
+  let t1 ← IO.monoNanosNow
+  return (t1 - t0).toFloat / frames.toFloat / 1.0e6
+
+/-- Print one row with its rate in sprites/second. -/
+def report (label : String) (ms : Float) : IO Unit :=
+  let rate := if ms > 0.0 then spriteCount.toFloat / (ms / 1000.0) else 0.0
+  IO.println s!"  {label}: {ms} ms/frame, {rate} sprites/s"
+
+/-- One sprite per call. -/
+def perCall (atlas : Bitmap) : IO Unit := do
+  for i in [0:spriteCount] do
+    let (dx, dy, rot) := place i
+    drawTintedScaledRotatedBitmapRegionRgb atlas 0 0 16 16 255 200 200 8 8 dx dy 1.5 1.5 rot FlipFlags.none
+
+/-- Record this frame's instances and submit them in one call. -/
+def batched (atlas : Bitmap) : IO Unit := do
+  let mut b := SpriteBatch.withCapacity spriteCount
+  for i in [0:spriteCount] do
+    let (dx, dy, rot) := place i
+    b := b.add 0 0 16 16 dx dy 1.5 rot (Color.rgb 255 200 200)
+  let _ ← b.draw atlas
+
+end SpriteBench
+
+open SpriteBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+  let _ ← Allegro.initPrimitivesAddon
+
+  let display : Display ← Allegro.createDisplay 640 480
+  let mut memTarget : Bitmap := Bitmap.null
+  if display == 0 then
+    Allegro.setNewBitmapFlags BitmapFlags.memory
+    memTarget ← Allegro.createBitmap 640 480
+    memTarget.setAsTarget
+  let atlas : Bitmap ← Allegro.createBitmap 16 16
+  if atlas == 0 then
+    IO.eprintln "FATAL: cannot create atlas"
+    return 1
+  atlas.setAsTarget
+  Allegro.clearToColorRgb 255 255 255
+  if display != 0 then Allegro.setTargetBackbuffer display else memTarget.setAsTarget
+
+  IO.println "=== Sprite batch throughput ==="
+  IO.println s!"  {spriteCount} sprites × {frames} frames, target: {if display != 0 then "display" else "memory bitmap"}"
+
+  let flush : IO Unit := if display != 0 then Allegro.flipDisplay else pure ()
+
+  let callMs ← msPerFrame (perCall atlas) flush
+  report "per-call" callMs
+  let heldMs ← msPerFrame (do holdBitmapDrawing 1; perCall atlas; holdBitmapDrawing 0) flush
+  report "per-call, held" heldMs
+  let batchMs ← msPerFrame (batched atlas) flush
+  report "SpriteBatch (record + draw)" batchMs
+  if batchMs > 0.0 then
+    IO.println s!"  speed-up vs per-call: ×{callMs / batchMs}, vs held: ×{heldMs / batchMs}"
+
+  atlas.destroy
+  if memTarget != 0 then memTarget.destroy
+  if display != 0 then display.destroy
+  Allegro.shutdownPrimitivesAddon
+  Allegro.uninstallSystem
+  return 0
@@ -0,0 +1,110 @@
+import Allegro
+
+/-!
+# Static label benchmark
+
+Draws `labelCount` static labels per frame in DejaVuSans 16 and compares:
+
+* `drawTextRgb` per label (glyph lookup, kerning and one bitmap draw per
+  glyph, every frame),
+* `TextSpriteCache.draw` per label (hash lookup + one `drawBitmapRegion`),
+* pre-fetched `TextSprite`s drawn under `holdBitmapDrawing`,
+* pre-shaped `GlyphRun`s for reference (one `al_draw_prim` per label).
+
+The first cached frame renders every sprite; it is timed separately.
+
+Uses a window when a display can be created (GPU path); otherwise falls back
+to a memory-bitmap target, where everything runs in Allegro's software
+renderer and only relative numbers are meaningful.
+
+Run: `lake build allegroTextSpriteBench && .lake/build/bin/allegroTextSpriteBench`
+-/
+
+open Allegro
+
+namespace TextSpriteBench
+
+/-- Labels per frame. -/
+def labelCount : Nat := 1000
+
+/-- Frames per row. -/
+def frames : Nat := 60
+
+/-- Label text and position. -/
+def label (i : Nat) : String × Float × Float :=
+  (s!"Menu item {i}: Options", (i % 5).toFloat * 128.0, (i / 5 % 40).toFloat * 12.0)
+
+/-- Time `frames` runs of `frame` (flushing after each) and return ms/frame. -/
+def msPerFrame (frame : IO Unit) (flush : IO Unit) : IO Float := do
+  let t0 ← IO.monoNanosNow
+  for _ in [0:frames] do
+    frame
+    flush
+  let t1 ← IO.monoNanosNow
+  return (t1 - t0).toFloat / frames.toFloat / 1.0e6
+
+def report (name : String) (ms base : Float) : IO Unit :=
+  IO.println s!"  {name}: {ms} ms/frame (×{if ms > 0.0 then base / ms else 0.0} vs drawTextRgb)"
+
+end TextSpriteBench
+
+open TextSpriteBench
+
+def main : IO UInt32 := do
+  let okInit ← Allegro.init
+  if okInit == 0 then
+    IO.eprintln "FATAL: al_init failed"
+    return 1
+  let _ ← Allegro.initPrimitivesAddon
+  Allegro.initFontAddon
+  let _ ← Allegro.initTtfAddon
+
+  let display : Display ← Allegro.createDisplay 640 480
+  let mut memTarget : Bitmap := Bitmap.null
+  if display == 0 then
+    Allegro.setNewBitmapFlags BitmapFlags.memory
+    memTarget ← Allegro.createBitmap 640 480
+    memTarget.setAsTarget
+  let font : Font ← Allegro.loadTtfFont "data/DejaVuSans.ttf" 16 0
+  if font == 0 then
+    IO.eprintln "FATAL: cannot load data/DejaVuSans.ttf"
+    return 1
+  let labels := (Array.range labelCount).map label
+  let white := Color.rgb 255 255 255
+
+  IO.println "=== Static label benchmark ==="
+  IO.println s!"  {labelCount} labels × {frames} frames, target: {if display != 0 then "display" else "memory bitmap"}"
+  let flush : IO Unit := if display != 0 then Allegro.flipDisplay else pure ()
+
+  let textMs ← msPerFrame (do for (t, x, y) in labels do drawTextRgb font 255 255 255 x y TextAlign.left t) flush
+  IO.println s!"  drawTextRgb: {textMs} ms/frame"
+
+  let cache ← TextSpriteCache.create (maxSprites := labelCount)
+  let t0 ← IO.monoNanosNow
+  for (t, x, y) in labels do cache.draw font t white x y
+  let t1 ← IO.monoNanosNow
+  IO.println s!"  first cached frame (renders {labelCount} sprites): {(t1 - t0).toFloat / 1.0e6} ms"
+  report "TextSpriteCache.draw" (← msPerFrame (do for (t, x, y) in labels do cache.draw font t white x y) flush) textMs
+
+  let mut sprites : Array (TextSprite × Float × Float) := Array.mkEmpty labelCount
+  for (t, x, y) in labels do
+    sprites := sprites.push (← cache.get font t white, x, y)
+  report "TextSprite.draw, held" (← msPerFrame (do
+    holdBitmapDrawing 1
+    for (s, x, y) in sprites do s.draw x y
+    holdBitmapDrawing 0) flush) textMs
+
+  let mut runs : Array (GlyphRun × Float × Float) := Array.mkEmpty labelCount
+  for (t, x, y) in labels do
+    runs := runs.push (← shapeGlyphRun font t, x, y)
+  report "GlyphRun.draw" (← msPerFrame (do for (r, x, y) in runs do discard <| r.draw x y) flush) textMs
+
+  let st ← cache.stats
+  IO.println s!"  cache: {st.sprites} sprites, {st.renders} renders, {st.hits} hits"
+
+  cache.destroy
+  font.destroy
+  if memTarget != 0 then memTarget.destroy
+  if display != 0 then display.destroy
+  Allegro.uninstallSystem
+  return 0